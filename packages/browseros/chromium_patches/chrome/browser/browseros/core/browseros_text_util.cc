@@ -0,0 +1,250 @@
+diff --git a/chrome/browser/browseros/core/browseros_text_util.cc b/chrome/browser/browseros/core/browseros_text_util.cc
+new file mode 100644
+index 0000000000000..fe4177735ce54
+--- /dev/null
++++ b/chrome/browser/browseros/core/browseros_text_util.cc
+@@ -0,0 +1,244 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/browseros/core/browseros_text_util.h"
++
++#include <algorithm>
++#include <array>
++#include <cstddef>
++#include <cstdint>
++#include <cstring>
++#include <type_traits>
++
++#include "base/strings/utf_string_conversion_utils.h"
++#include "base/third_party/icu/icu_utf.h"
++
++namespace browseros {
++
++namespace {
++
++enum CharClass : uint8_t {
++  kOther,
++  kSpace,
++  kLineBreak,
++};
++
++using ClassTable = std::array<CharClass, 128>;
++
++constexpr ClassTable MakeClassTable(bool keep_line_breaks, bool keep_tabs) {
++  ClassTable table{};
++  for (char c : {' ', '\t', '\n', '\v', '\f', '\r'}) {
++    table[static_cast<size_t>(c)] = kSpace;
++  }
++  if (keep_line_breaks) {
++    table['\n'] = kLineBreak;
++  }
++  if (keep_tabs) {
++    table['\t'] = kOther;
++  }
++  return table;
++}
++
++constexpr ClassTable kCollapseTable =
++    MakeClassTable(/*keep_line_breaks=*/false, /*keep_tabs=*/false);
++constexpr ClassTable kPageTextTable =
++    MakeClassTable(/*keep_line_breaks=*/true, /*keep_tabs=*/true);
++
++template <typename CharT>
++CharClass Classify(CharT c, const ClassTable& table) {
++  const auto code = static_cast<std::make_unsigned_t<CharT>>(c);
++  return code < table.size() ? table[code] : kOther;
++}
++
++// Compacts |text| in place. A whitespace run is replaced by up to
++// |max_line_breaks| line breaks if it contains any, else by one space, and
++// dropped at either end. The output never outgrows the input read so far,
++// so writing behind the read position is safe.
++template <typename StringT>
++void Normalize(StringT& text, const ClassTable& table, size_t max_line_breaks) {
++  using CharT = typename StringT::value_type;
++  CharT* data = text.data();
++  const size_t size = text.size();
++  size_t read = 0;
++  size_t write = 0;
++  bool pending_space = false;
++  size_t pending_line_breaks = 0;
++
++  while (read < size) {
++    // Ordinary characters make up most text; find the end of the run with
++    // a tight table scan and move it in one go
++    size_t run_end = read;
++    while (run_end < size && Classify(data[run_end], table) == kOther) {
++      ++run_end;
++    }
++    if (run_end == read) {
++      if (Classify(data[read], table) == kLineBreak) {
++        ++pending_line_breaks;
++      } else {
++        pending_space = true;
++      }
++      ++read;
++      continue;
++    }
++
++    if (write > 0) {
++      if (pending_line_breaks) {
++        const size_t count = std::min(pending_line_breaks, max_line_breaks);
++        std::fill_n(data + write, count, CharT('\n'));
++        write += count;
++      } else if (pending_space) {
++        data[write++] = CharT(' ');
++      }
++    }
++    pending_space = false;
++    pending_line_breaks = 0;
++
++    if (write != read) {
++      std::copy(data + read, data + run_end, data + write);
++    }
++    write += run_end - read;
++    read = run_end;
++  }
++  text.resize(write);
++}
++
++constexpr uint64_t kOnes = 0x0101010101010101ull;
++constexpr uint64_t kHighBits = 0x8080808080808080ull;
++
++// True if any byte of |word| is non-ASCII, a C0 control or DEL
++bool HasSpecialByte(uint64_t word) {
++  const uint64_t below_space = (word - 0x20 * kOnes) & ~word;
++  const uint64_t del = word ^ (0x7F * kOnes);
++  const uint64_t is_del = (del - kOnes) & ~del;
++  return ((word | below_space | is_del) & kHighBits) != 0;
++}
++
++// True if two adjacent bytes of |word| are spaces
++bool HasDoubleSpace(uint64_t word) {
++  const uint64_t x = word ^ (0x20 * kOnes);
++  // High bit set in exactly the bytes that are spaces
++  const uint64_t spaces =
++      ~(((x & ~kHighBits) + ~kHighBits) | x | ~kHighBits);
++  return (spaces & (spaces << 8)) != 0;
++}
++
++bool IsC1Control(base_icu::UChar32 code_point) {
++  return code_point >= 0x80 && code_point <= 0x9F;
++}
++
++// Offset of the first byte SanitizeForOutput would change, or npos
++size_t FindFirstUnclean(std::string_view input) {
++  const char* data = input.data();
++  const size_t size = input.size();
++  if (size && (data[0] == ' ' || data[size - 1] == ' ')) {
++    return 0;
++  }
++  size_t i = 0;
++  while (i < size) {
++    if (i + sizeof(uint64_t) <= size) {
++      uint64_t word;
++      std::memcpy(&word, data + i, sizeof(word));
++      if (!HasSpecialByte(word)) {
++        const bool space_run_across_words =
++            i && data[i - 1] == ' ' && data[i] == ' ';
++        if (HasDoubleSpace(word) || space_run_across_words) {
++          return i;
++        }
++        i += sizeof(word);
++        continue;
++      }
++    }
++    const auto c = static_cast<unsigned char>(data[i]);
++    if (c < 0x80) {
++      if (c < 0x20 || c == 0x7F || (c == ' ' && i && data[i - 1] == ' ')) {
++        return i;
++      }
++      ++i;
++      continue;
++    }
++    size_t end = i;
++    base_icu::UChar32 code_point;
++    if (!base::ReadUnicodeCharacter(data, size, &end, &code_point) ||
++        IsC1Control(code_point)) {
++      return i;
++    }
++    i = end + 1;
++  }
++  return std::string_view::npos;
++}
++
++}  // namespace
++
++void CollapseWhitespace(std::string& text) {
++  Normalize(text, kCollapseTable, 0);
++}
++
++void CollapseWhitespace(std::u16string& text) {
++  Normalize(text, kCollapseTable, 0);
++}
++
++void NormalizePageText(std::string& text) {
++  Normalize(text, kPageTextTable, 2);
++}
++
++void NormalizePageText(std::u16string& text) {
++  Normalize(text, kPageTextTable, 2);
++}
++
++std::string_view SanitizeForOutput(std::string_view input,
++                                   std::string* storage) {
++  const size_t clean_prefix = FindFirstUnclean(input);
++  if (clean_prefix == std::string_view::npos) {
++    return input;
++  }
++
++  storage->clear();
++  storage->reserve(input.size());
++  const char* data = input.data();
++  const size_t size = input.size();
++  // The clean prefix is copied as is, except for a trailing space, which
++  // may turn out to start a run or end the text
++  storage->append(data, clean_prefix);
++  bool pending_space = !storage->empty() && storage->back() == ' ';
++  if (pending_space) {
++    storage->pop_back();
++  }
++  for (size_t i = clean_prefix; i < size; ++i) {
++    const auto c = static_cast<unsigned char>(data[i]);
++    if (c < 0x80) {
++      if (c == ' ' || (c >= '\t' && c <= '\r')) {
++        pending_space = true;
++        continue;
++      }
++      if (c < 0x20 || c == 0x7F) {
++        continue;
++      }
++      if (pending_space && !storage->empty()) {
++        storage->push_back(' ');
++      }
++      pending_space = false;
++      storage->push_back(static_cast<char>(c));
++      continue;
++    }
++
++    const size_t start = i;
++    base_icu::UChar32 code_point;
++    const bool valid = base::ReadUnicodeCharacter(data, size, &i, &code_point);
++    if (valid && IsC1Control(code_point)) {
++      continue;
++    }
++    if (pending_space && !storage->empty()) {
++      storage->push_back(' ');
++    }
++    pending_space = false;
++    if (valid) {
++      storage->append(data + start, i + 1 - start);
++    } else {
++      base::WriteUnicodeCharacter(base_icu::UChar32{0xFFFD}, storage);
++    }
++  }
++  return *storage;
++}
++
++}  // namespace browseros
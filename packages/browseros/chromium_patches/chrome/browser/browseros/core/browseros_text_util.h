@@ -0,0 +1,49 @@
+diff --git a/chrome/browser/browseros/core/browseros_text_util.h b/chrome/browser/browseros/core/browseros_text_util.h
+new file mode 100644
+index 0000000000000..aeabd47762ed2
+--- /dev/null
++++ b/chrome/browser/browseros/core/browseros_text_util.h
+@@ -0,0 +1,43 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_BROWSEROS_CORE_BROWSEROS_TEXT_UTIL_H_
++#define CHROME_BROWSER_BROWSEROS_CORE_BROWSEROS_TEXT_UTIL_H_
++
++#include <string>
++#include <string_view>
++
++namespace browseros {
++
++// Whitespace normalization shared by the page extractors. Both functions
++// work in place in a single pass: runs of ordinary characters are moved as
++// one block, and only ASCII whitespace is inspected, so non-ASCII text and
++// UTF-8 sequences pass through untouched.
++
++// Collapses every run of ASCII whitespace, line breaks included, to a single
++// space and trims both ends. For names and other one-line text.
++void CollapseWhitespace(std::string& text);
++void CollapseWhitespace(std::u16string& text);
++
++// Normalizes multi-line page text: runs of spaces become one space, spaces
++// around line breaks are dropped, more than two line breaks in a row become
++// two, and leading and trailing whitespace is trimmed. Tabs are kept, since
++// extractors use them for indentation.
++void NormalizePageText(std::string& text);
++void NormalizePageText(std::u16string& text);
++
++// Sanitizes text for agent-facing output. Valid UTF-8 is kept, so names on
++// non-English pages survive. ASCII whitespace becomes a space with runs
++// collapsed and both ends trimmed, other control characters (C0, DEL and
++// C1) are dropped, and invalid UTF-8 sequences become U+FFFD.
++//
++// Returns |input| itself when it is already clean, the common case, without
++// allocating. Otherwise the result is written to |*storage| and the returned
++// view points into it. Printable ASCII is checked eight bytes at a time.
++std::string_view SanitizeForOutput(std::string_view input,
++                                   std::string* storage);
++
++}  // namespace browseros
++
++#endif  // CHROME_BROWSER_BROWSEROS_CORE_BROWSEROS_TEXT_UTIL_H_
@@ -0,0 +1,129 @@
+diff --git a/chrome/browser/browseros/core/browseros_text_util_unittest.cc b/chrome/browser/browseros/core/browseros_text_util_unittest.cc
+new file mode 100644
+index 0000000000000..b965bd747ca63
+--- /dev/null
++++ b/chrome/browser/browseros/core/browseros_text_util_unittest.cc
+@@ -0,0 +1,123 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/browseros/core/browseros_text_util.h"
++
++#include <string>
++#include <string_view>
++
++#include "testing/gtest/include/gtest/gtest.h"
++
++namespace browseros {
++namespace {
++
++std::string Collapsed(std::string text) {
++  CollapseWhitespace(text);
++  return text;
++}
++
++std::string Normalized(std::string text) {
++  NormalizePageText(text);
++  return text;
++}
++
++std::string Sanitized(std::string_view text) {
++  std::string storage;
++  return std::string(SanitizeForOutput(text, &storage));
++}
++
++// =============================================================================
++// CollapseWhitespace Tests
++// =============================================================================
++
++TEST(BrowserOSTextUtilTest, CollapsesRunsAndTrims) {
++  EXPECT_EQ("a b c", Collapsed("  a \t\n b\r\n\n  c  "));
++  EXPECT_EQ("abc", Collapsed("abc"));
++  EXPECT_EQ("", Collapsed(" \n\t "));
++  EXPECT_EQ("", Collapsed(""));
++}
++
++TEST(BrowserOSTextUtilTest, CollapseKeepsNonAsciiText) {
++  EXPECT_EQ("caf\u00e9 \u65e5\u672c",
++            Collapsed(" caf\u00e9\n\n\u65e5\u672c "));
++
++  // Only ASCII whitespace is collapsed
++  std::u16string text = u"  caf\u00e9\u00a0\u00a0x  ";
++  CollapseWhitespace(text);
++  EXPECT_EQ(u"caf\u00e9\u00a0\u00a0x", text);
++}
++
++// =============================================================================
++// NormalizePageText Tests
++// =============================================================================
++
++TEST(BrowserOSTextUtilTest, NormalizesPageText) {
++  EXPECT_EQ("# Title\n\nSome text\n\nMore",
++            Normalized("\n# Title \n\n\n\nSome   text  \n\n\nMore \n\n"));
++  EXPECT_EQ("one\ntwo", Normalized("one  \n  two"));
++}
++
++TEST(BrowserOSTextUtilTest, NormalizeKeepsTabIndentation) {
++  EXPECT_EQ("Items\n\tnested", Normalized("Items\n\tnested\n"));
++
++  std::u16string text = u"a  b\n\n\n\n\tc ";
++  NormalizePageText(text);
++  EXPECT_EQ(u"a b\n\n\tc", text);
++}
++
++// Quadratic find-and-replace took seconds on inputs like this
++TEST(BrowserOSTextUtilTest, HandlesLongWhitespaceRuns) {
++  std::string text = "start" + std::string(1 << 20, ' ') + "middle" +
++                     std::string(1 << 20, '\n') + "end";
++  NormalizePageText(text);
++  EXPECT_EQ("start middle\n\nend", text);
++}
++
++// =============================================================================
++// SanitizeForOutput Tests
++// =============================================================================
++
++TEST(BrowserOSTextUtilTest, SanitizeKeepsCleanTextWithoutCopying) {
++  const std::string names[] = {
++      "Submit order",
++      "\u041e\u0442\u043f\u0440\u0430\u0432\u0438\u0442\u044c "
++      "\u0437\u0430\u043a\u0430\u0437",
++      "\u6ce8\u6587\u3092\u78ba\u5b9a\u3059\u308b",
++      "caf\u00e9 \U0001f600",
++  };
++  for (const std::string& name : names) {
++    std::string storage;
++    std::string_view result = SanitizeForOutput(name, &storage);
++    EXPECT_EQ(name, result);
++    EXPECT_EQ(name.data(), result.data());
++    EXPECT_TRUE(storage.empty());
++  }
++}
++
++TEST(BrowserOSTextUtilTest, SanitizeCollapsesWhitespaceAndDropsControls) {
++  EXPECT_EQ("a b c", Sanitized("  a \t\n b\r\n  c  "));
++  EXPECT_EQ("ab", Sanitized(std::string_view("a\x01\0b\x7f", 5)));
++  EXPECT_EQ("", Sanitized(" \n\x02 "));
++  // C1 controls are dropped, U+00A0 and other printable code points kept
++  EXPECT_EQ("\u0414\u0430 \u00a0x",
++            Sanitized("\u0414\u0430\u0085 \u00a0x"));
++}
++
++TEST(BrowserOSTextUtilTest, SanitizeReplacesInvalidUtf8) {
++  EXPECT_EQ("a\ufffdb", Sanitized("a\xff" "b"));
++  // Truncated multibyte sequence at the end
++  EXPECT_EQ("\u65e5\ufffd", Sanitized("\u65e5\xe6\x9c"));
++}
++
++TEST(BrowserOSTextUtilTest, SanitizeHandlesTextAcrossWordBoundaries) {
++  // Dirty bytes at every offset of the eight-byte fast path
++  for (size_t i = 0; i < 17; ++i) {
++    std::string text = std::string(i, 'x') + "  \t" + std::string(9, 'y');
++    EXPECT_EQ(std::string(i, 'x') + (i ? " " : "") + std::string(9, 'y'),
++              Sanitized(text));
++  }
++}
++
++}  // namespace
++}  // namespace browseros
@@ -1,15 +1,17 @@
 diff --git a/chrome/browser/extensions/api/browser_os/browser_os_api.cc b/chrome/browser/extensions/api/browser_os/browser_os_api.cc
 new file mode 100644
-index 0000000000000..c08b705ef6869
+index 0000000000000..4d0ad7ffba05c
 --- /dev/null
 +++ b/chrome/browser/extensions/api/browser_os/browser_os_api.cc
-@@ -0,0 +1,1437 @@
+@@ -0,0 +1,2190 @@
 +// Copyright 2024 The Chromium Authors
 +// Use of this source code is governed by a BSD-style license that can be
 +// found in the LICENSE file.
 +
 +#include "chrome/browser/extensions/api/browser_os/browser_os_api.h"
 +
++#include <algorithm>
++#include <optional>
 +#include <set>
 +#include <string>
 +
@@ -22,6 +24,9 @@ index 0000000000000..c08b705ef6869
 +#include <vector>
 +
 +#include "base/functional/bind.h"
++#include "base/notreached.h"
++#include "base/task/sequenced_task_runner.h"
++#include "base/task/thread_pool.h"
 +#include "base/threading/platform_thread.h"
 +#include "chrome/browser/browser_process.h"
 +#include "chrome/browser/profiles/profile.h"
@@ -29,15 +34,21 @@ index 0000000000000..c08b705ef6869
 +#include "base/json/json_writer.h"
 +#include "base/strings/utf_string_conversions.h"
 +#include "base/strings/string_number_conversions.h"
-+#include "base/base64.h"
++#include "base/strings/stringprintf.h"
 +#include "base/time/time.h"
 +#include "base/values.h"
 +#include "base/version_info/version_info.h"
 +#include "chrome/browser/browseros/metrics/browseros_metrics.h"
 +#include "chrome/browser/extensions/api/browser_os/browser_os_api_helpers.h"
 +#include "chrome/browser/extensions/api/browser_os/browser_os_api_utils.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_ax_serialization.h"
 +#include "chrome/browser/extensions/api/browser_os/browser_os_change_detector.h"
 +#include "chrome/browser/extensions/api/browser_os/browser_os_content_processor.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_id_store.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_screencast.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_screenshot_diff.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_screenshot_highlights.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_snapshot_cache.h"
 +#include "chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor.h"
 +#include "chrome/browser/extensions/extension_tab_util.h"
 +#include "chrome/browser/extensions/window_controller.h"
@@ -66,9 +77,10 @@ index 0000000000000..c08b705ef6869
 +#include "ui/events/keycodes/keyboard_codes.h"
 +#include "ui/gfx/geometry/point_f.h"
 +#include "ui/gfx/geometry/rect.h"
++#include "ui/gfx/geometry/rect_conversions.h"
 +#include "ui/gfx/geometry/rect_f.h"
++#include "ui/gfx/geometry/size_conversions.h"
 +#include "ui/gfx/range/range.h"
-+#include "ui/gfx/codec/png_codec.h"
 +#include "ui/gfx/image/image.h"
 +#include "ui/snapshot/snapshot.h"
 +
@@ -77,164 +89,6 @@ index 0000000000000..c08b705ef6869
 +
 +namespace {
 +
-+// Serializes ui::AXNodeData to base::Value::Dict with all fields
-+base::Value::Dict SerializeAXNodeData(const ui::AXNodeData& node) {
-+  base::Value::Dict dict;
-+
-+  // Core identity
-+  dict.Set("id", node.id);
-+  dict.Set("role", ui::ToString(node.role));
-+
-+  // Hierarchy
-+  if (!node.child_ids.empty()) {
-+    base::Value::List children;
-+    for (int32_t child_id : node.child_ids) {
-+      children.Append(child_id);
-+    }
-+    dict.Set("childIds", std::move(children));
-+  }
-+
-+  // State bitfield converted to string array
-+  base::Value::List states;
-+  for (int i = static_cast<int>(ax::mojom::State::kMinValue);
-+       i <= static_cast<int>(ax::mojom::State::kMaxValue); ++i) {
-+    auto state = static_cast<ax::mojom::State>(i);
-+    if (node.HasState(state)) {
-+      states.Append(ui::ToString(state));
-+    }
-+  }
-+  if (!states.empty()) {
-+    dict.Set("states", std::move(states));
-+  }
-+
-+  // Actions bitfield converted to string array
-+  base::Value::List actions;
-+  for (int i = static_cast<int>(ax::mojom::Action::kMinValue);
-+       i <= static_cast<int>(ax::mojom::Action::kMaxValue); ++i) {
-+    auto action = static_cast<ax::mojom::Action>(i);
-+    if (node.HasAction(action)) {
-+      actions.Append(ui::ToString(action));
-+    }
-+  }
-+  if (!actions.empty()) {
-+    dict.Set("actions", std::move(actions));
-+  }
-+
-+  // String attributes map with enum keys converted to strings
-+  if (node.string_attributes.size() > 0) {
-+    base::Value::Dict attrs;
-+    for (const auto& [key, value] : node.string_attributes) {
-+      attrs.Set(ui::ToString(key), value);
-+    }
-+    dict.Set("stringAttributes", std::move(attrs));
-+  }
-+
-+  // Int attributes map
-+  if (node.int_attributes.size() > 0) {
-+    base::Value::Dict attrs;
-+    for (const auto& [key, value] : node.int_attributes) {
-+      attrs.Set(ui::ToString(key), value);
-+    }
-+    dict.Set("intAttributes", std::move(attrs));
-+  }
-+
-+  // Float attributes map
-+  if (node.float_attributes.size() > 0) {
-+    base::Value::Dict attrs;
-+    for (const auto& [key, value] : node.float_attributes) {
-+      attrs.Set(ui::ToString(key), static_cast<double>(value));
-+    }
-+    dict.Set("floatAttributes", std::move(attrs));
-+  }
-+
-+  // Bool attributes map
-+  if (node.bool_attributes && node.bool_attributes->Size() > 0) {
-+    base::Value::Dict attrs;
-+    node.bool_attributes->ForEach([&attrs](ax::mojom::BoolAttribute key, bool value) {
-+      attrs.Set(ui::ToString(key), value);
-+    });
-+    dict.Set("boolAttributes", std::move(attrs));
-+  }
-+
-+  // IntList attributes map
-+  if (node.intlist_attributes.size() > 0) {
-+    base::Value::Dict attrs;
-+    for (const auto& [key, values] : node.intlist_attributes) {
-+      base::Value::List list;
-+      for (int v : values) {
-+        list.Append(v);
-+      }
-+      attrs.Set(ui::ToString(key), std::move(list));
-+    }
-+    dict.Set("intListAttributes", std::move(attrs));
-+  }
-+
-+  // StringList attributes map
-+  if (node.stringlist_attributes.size() > 0) {
-+    base::Value::Dict attrs;
-+    for (const auto& [key, values] : node.stringlist_attributes) {
-+      base::Value::List list;
-+      for (const auto& v : values) {
-+        list.Append(v);
-+      }
-+      attrs.Set(ui::ToString(key), std::move(list));
-+    }
-+    dict.Set("stringListAttributes", std::move(attrs));
-+  }
-+
-+  // HTML attributes (name-value pairs)
-+  if (!node.html_attributes.empty()) {
-+    base::Value::Dict attrs;
-+    for (const auto& [name, value] : node.html_attributes) {
-+      attrs.Set(name, value);
-+    }
-+    dict.Set("htmlAttributes", std::move(attrs));
-+  }
-+
-+  return dict;
-+}
-+
-+// Serializes ui::AXTreeData to base::Value::Dict
-+base::Value::Dict SerializeAXTreeData(const ui::AXTreeData& tree_data) {
-+  base::Value::Dict dict;
-+
-+  // Document metadata
-+  if (!tree_data.title.empty()) {
-+    dict.Set("title", tree_data.title);
-+  }
-+  if (!tree_data.url.empty()) {
-+    dict.Set("url", tree_data.url);
-+  }
-+  if (!tree_data.doctype.empty()) {
-+    dict.Set("doctype", tree_data.doctype);
-+  }
-+  if (!tree_data.mimetype.empty()) {
-+    dict.Set("mimetype", tree_data.mimetype);
-+  }
-+
-+  // Loading state
-+  dict.Set("loaded", tree_data.loaded);
-+  dict.Set("loadingProgress", tree_data.loading_progress);
-+
-+  // Focus
-+  if (tree_data.focus_id != -1) {
-+    dict.Set("focusId", tree_data.focus_id);
-+  }
-+
-+  // Selection
-+  if (tree_data.sel_anchor_object_id != -1) {
-+    base::Value::Dict selection;
-+    selection.Set("anchorObjectId", tree_data.sel_anchor_object_id);
-+    selection.Set("anchorOffset", tree_data.sel_anchor_offset);
-+    selection.Set("focusObjectId", tree_data.sel_focus_object_id);
-+    selection.Set("focusOffset", tree_data.sel_focus_offset);
-+    selection.Set("isBackward", tree_data.sel_is_backward);
-+    dict.Set("selection", std::move(selection));
-+  }
-+
-+  return dict;
-+}
-+
 +// Helper to find which PrefService contains a preference
 +// Tries Local State first, then Profile prefs
 +PrefService* FindPrefService(const std::string& pref_name, Profile* profile) {
@@ -270,6 +124,137 @@ index 0000000000000..c08b705ef6869
 +  }
 +}
 +
++// Accessibility nodes requested from the renderer per interactive element
++// when getInteractiveSnapshot is given a maxNodes budget. Interactive nodes
++// are a small fraction of the tree, so the tree cap has to be generous.
++constexpr size_t kTreeNodesPerInteractiveNode = 50;
++
++// Converts a caller-supplied deadlineMs into an absolute deadline, or a null
++// TimeTicks when none was given.
++base::TimeTicks DeadlineFromMs(const std::optional<int>& deadline_ms) {
++  if (!deadline_ms || *deadline_ms <= 0) {
++    return base::TimeTicks();
++  }
++  return base::TimeTicks::Now() + base::Milliseconds(*deadline_ms);
++}
++
++// Share of a deadlineMs budget that the renderer may spend acquiring the
++// tree. The rest is reserved for serializing or processing it, so a slow
++// acquisition cannot leave an empty result.
++constexpr double kAcquisitionShareOfDeadline = 0.6;
++
++// Deadline for the renderer's tree acquisition within |deadline|, or a null
++// TimeTicks when there is no deadline.
++base::TimeTicks AcquisitionDeadline(base::TimeTicks deadline) {
++  if (deadline.is_null()) {
++    return base::TimeTicks();
++  }
++  base::TimeTicks now = base::TimeTicks::Now();
++  return now + (deadline - now) * kAcquisitionShareOfDeadline;
++}
++
++// The renderer does not report whether it stopped at its timeout, so a tree
++// that arrives after the acquisition deadline is treated as possibly cut off.
++bool AcquisitionTimedOut(base::TimeTicks acquisition_deadline) {
++  return !acquisition_deadline.is_null() &&
++         base::TimeTicks::Now() >= acquisition_deadline;
++}
++
++// Time left until |deadline| for RequestAXTreeSnapshot, where an empty delta
++// means no timeout. A deadline that already passed still gets a minimal
++// timeout rather than none.
++base::TimeDelta TimeoutUntil(base::TimeTicks deadline) {
++  if (deadline.is_null()) {
++    return base::TimeDelta();
++  }
++  return std::max(deadline - base::TimeTicks::Now(), base::Milliseconds(1));
++}
++
++browser_os::PageChanges ToIdlPageChanges(const PageChanges& changes) {
++  browser_os::PageChanges result;
++  result.navigated = changes.navigated;
++  result.dom_changed = changes.dom_changed;
++  result.focus_changed = changes.focus_changed;
++  result.new_tab_opened = changes.new_tab_opened;
++  result.load_started = changes.load_started;
++  result.settled = changes.settled;
++  result.elapsed_ms = changes.elapsed.InMillisecondsF();
++  return result;
++}
++
++// Looks up |node_id| in the latest snapshot of |web_contents|, remapping IDs
++// from older snapshots of the same page. Returns null and sets |error| if the
++// tab has no snapshot or the element cannot be found.
++const NodeInfo* FindNode(content::WebContents* web_contents,
++                         uint32_t node_id,
++                         std::string* error) {
++  BrowserOSNodeIdStore* node_id_store =
++      BrowserOSNodeIdStore::FromWebContents(web_contents);
++  if (!node_id_store) {
++    *error = "No snapshot data for this tab";
++    return nullptr;
++  }
++  return node_id_store->Resolve(node_id, error).node;
++}
++
++// Clips |region|, in CSS pixels relative to the viewport, to a view of
++// |view_size| DIPs. |css_to_dip| is the page's CSS to widget scale, which
++// covers browser zoom, CSS zoom and page scale. Returns nullopt if nothing
++// is left.
++std::optional<gfx::Rect> ClipToView(const gfx::RectF& region,
++                                    float css_to_dip,
++                                    const gfx::Size& view_size) {
++  gfx::Rect clipped = gfx::ToEnclosingRect(gfx::ScaleRect(region, css_to_dip));
++  clipped.Intersect(gfx::Rect(view_size));
++  if (clipped.IsEmpty()) {
++    return std::nullopt;
++  }
++  return clipped;
++}
++
++// Draws |highlights| onto |bitmap|, if any, and encodes the result. Runs on
++// a worker.
++std::optional<base::Value> HighlightAndEncodeScreenshot(
++    SkBitmap bitmap,
++    ScreenshotHighlights highlights,
++    ScreenshotEncoding encoding) {
++  if (!highlights.boxes.empty()) {
++    bitmap = PaintScreenshotHighlights(bitmap, highlights);
++  }
++  return EncodeScreenshotValue(std::move(bitmap), encoding);
++}
++
++// Draws |highlights| onto |bitmap|, if any, and encodes the tiles that
++// changed since |previous|. Runs on a worker.
++ScreenshotDiffOutput HighlightAndDiffScreenshot(SkBitmap bitmap,
++                                                ScreenshotHighlights highlights,
++                                                SkBitmap previous,
++                                                int sequence,
++                                                int base_sequence,
++                                                ScreenshotEncoding encoding) {
++  if (!highlights.boxes.empty()) {
++    bitmap = PaintScreenshotHighlights(bitmap, highlights);
++  }
++  return DiffAndEncodeScreenshot(std::move(bitmap), std::move(previous),
++                                 sequence, base_sequence, encoding);
++}
++
++browser_os::TextInputMethod ToIdlTextInputMethod(TextInputMethod method) {
++  switch (method) {
++    case TextInputMethod::kNone:
++      return browser_os::TextInputMethod::kNone;
++    case TextInputMethod::kIme:
++      return browser_os::TextInputMethod::kIme;
++    case TextInputMethod::kSetValue:
++      return browser_os::TextInputMethod::kSetValue;
++    case TextInputMethod::kScript:
++      return browser_os::TextInputMethod::kScript;
++    case TextInputMethod::kKeystrokes:
++      return browser_os::TextInputMethod::kKeystrokes;
++  }
++  NOTREACHED();
++}
++
 +}  // namespace
 +
 +// Static member initialization
@@ -301,16 +286,39 @@ index 0000000000000..c08b705ef6869
 +    return RespondNow(Error("No render frame"));
 +  }
 +
++  if (params->options) {
++    if (params->options->max_nodes.value_or(0) < 0) {
++      return RespondNow(Error("maxNodes must not be negative"));
++    }
++    max_nodes_ = params->options->max_nodes.value_or(0);
++    deadline_ = DeadlineFromMs(params->options->deadline_ms);
++    acquisition_deadline_ = AcquisitionDeadline(deadline_);
++    switch (params->options->format) {
++      case browser_os::AccessibilityTreeFormat::kNone:
++      case browser_os::AccessibilityTreeFormat::kObject:
++        format_ = AXTreeFormat::kObject;
++        break;
++      case browser_os::AccessibilityTreeFormat::kJson:
++        format_ = AXTreeFormat::kJson;
++        break;
++      case browser_os::AccessibilityTreeFormat::kCompact:
++        format_ = AXTreeFormat::kCompact;
++        break;
++    }
++  }
++
 +  // Request accessibility tree snapshot
-+  // Use WebContents with extended properties to get a full tree
++  // Use WebContents with extended properties to get a full tree. The renderer
++  // stops serializing once the node budget or its share of the deadline is
++  // reached.
 +  web_contents->RequestAXTreeSnapshot(
 +      base::BindOnce(
 +          &BrowserOSGetAccessibilityTreeFunction::OnAccessibilityTreeReceived,
 +          this),
 +      ui::AXMode(ui::AXMode::kWebContents | ui::AXMode::kExtendedProperties |
 +                 ui::AXMode::kInlineTextBoxes),
-+      /* max_nodes= */ 0,  // No limit
-+      /* timeout= */ base::TimeDelta(),
++      max_nodes_,
++      TimeoutUntil(acquisition_deadline_),
 +      content::WebContents::AXTreeSnapshotPolicy::kAll);
 +
 +  return RespondLater();
@@ -321,19 +329,44 @@ index 0000000000000..c08b705ef6869
 +  browser_os::AccessibilityTree result;
 +  result.root_id = tree_update.root_id;
 +
-+  // Serialize all nodes with complete AX data
-+  base::Value::Dict nodes;
-+  for (const auto& node_data : tree_update.nodes) {
-+    nodes.Set(base::NumberToString(node_data.id),
-+              SerializeAXNodeData(node_data));
++  // A tree that filled the node budget or ran into the acquisition timeout
++  // was most likely cut off by it
++  if (max_nodes_ > 0 || !deadline_.is_null()) {
++    result.truncated =
++        (max_nodes_ > 0 && tree_update.nodes.size() >= max_nodes_) ||
++        AcquisitionTimedOut(acquisition_deadline_);
 +  }
-+  result.nodes.additional_properties = std::move(nodes);
 +
 +  // Serialize tree-level metadata
 +  browser_os::AccessibilityTree::TreeData tree_data_obj;
-+  tree_data_obj.additional_properties = SerializeAXTreeData(tree_update.tree_data);
++  tree_data_obj.additional_properties =
++      SerializeAXTreeData(tree_update.tree_data);
 +  result.tree_data = std::move(tree_data_obj);
 +
++  // Node serialization is proportional to the tree and can take hundreds of
++  // milliseconds on large pages, so it runs on a worker
++  base::ThreadPool::PostTaskAndReplyWithResult(
++      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
++      base::BindOnce(&SerializeAXTree, std::move(tree_update.nodes), format_,
++                     deadline_),
++      base::BindOnce(&BrowserOSGetAccessibilityTreeFunction::OnTreeSerialized,
++                     this, std::move(result)));
++}
++
++void BrowserOSGetAccessibilityTreeFunction::OnTreeSerialized(
++    browser_os::AccessibilityTree result,
++    SerializedAXTree serialized) {
++  if (format_ == AXTreeFormat::kObject) {
++    browser_os::AccessibilityTree::Nodes nodes;
++    nodes.additional_properties = std::move(serialized.nodes);
++    result.nodes = std::move(nodes);
++  } else {
++    result.json = std::move(serialized.json);
++  }
++  if (serialized.truncated) {
++    result.truncated = true;
++  }
++
 +  Respond(ArgumentList(
 +      browser_os::GetAccessibilityTree::Results::Create(result)));
 +}
@@ -377,32 +410,101 @@ index 0000000000000..c08b705ef6869
 +        browser_os::GetInteractiveSnapshot::Results::Create(empty_snapshot)));
 +  }
 +  
-+  // Request accessibility tree snapshot
++  incremental_ = params->options && params->options->incremental.value_or(false);
++  viewport_only_ =
++      params->options && params->options->viewport_only.value_or(false);
++  const bool stream =
++      params->options && params->options->stream.value_or(false);
++  if (stream && incremental_) {
++    return RespondNow(
++        Error("The stream and incremental options cannot be combined"));
++  }
++  if (params->options) {
++    if (params->options->max_nodes.value_or(0) < 0) {
++      return RespondNow(Error("maxNodes must not be negative"));
++    }
++    max_nodes_ = params->options->max_nodes.value_or(0);
++    deadline_ = DeadlineFromMs(params->options->deadline_ms);
++    acquisition_deadline_ = AcquisitionDeadline(deadline_);
++  }
++  // A truncated snapshot would poison the cache for later unbounded calls
++  if (incremental_ && (max_nodes_ > 0 || !deadline_.is_null())) {
++    return RespondNow(Error(
++        "The maxNodes and deadlineMs options cannot be combined with "
++        "incremental"));
++  }
++  if (incremental_) {
++    BrowserOSSnapshotCache::CreateForWebContents(web_contents);
++    BrowserOSSnapshotCache* cache =
++        BrowserOSSnapshotCache::FromWebContents(web_contents);
++    // Nothing changed since the last incremental snapshot of this tab
++    if (cache->IsClean(viewport_only_)) {
++      browser_os::InteractiveSnapshot snapshot = cache->GetCachedSnapshot();
++      snapshot.snapshot_id = next_snapshot_id_++;
++      snapshot.timestamp = base::Time::Now().InMillisecondsFSinceUnixEpoch();
++      snapshot.processing_time_ms = 0;
++      return RespondNow(ArgumentList(
++          browser_os::GetInteractiveSnapshot::Results::Create(snapshot)));
++    }
++    cache->MarkSnapshotRequested();
++    cache_generation_ = cache->generation();
++  } else if (auto* cache =
++                 BrowserOSSnapshotCache::FromWebContents(web_contents)) {
++    // A full snapshot renumbers the tab's node IDs
++    cache->Invalidate();
++  }
++  
++  // Request accessibility tree snapshot. With a node budget the tree is
++  // capped at a multiple of it, and the renderer's serialization time is
++  // bounded by its share of the deadline.
 +  web_contents->RequestAXTreeSnapshot(
 +      base::BindOnce(
 +          &BrowserOSGetInteractiveSnapshotFunction::OnAccessibilityTreeReceived,
 +          this),
 +      ui::AXMode(ui::AXMode::kWebContents | ui::AXMode::kExtendedProperties |
 +                 ui::AXMode::kInlineTextBoxes),
-+      /* max_nodes= */ 0,  // No limit
-+      /* timeout= */ base::TimeDelta(),
++      max_nodes_ * kTreeNodesPerInteractiveNode,
++      TimeoutUntil(acquisition_deadline_),
 +      content::WebContents::AXTreeSnapshotPolicy::kAll);
 +      // content::WebContents::AXTreeSnapshotPolicy::kSameOriginDirectDescendants);
 +
++  if (stream) {
++    // Respond right away; elements follow through getInteractiveSnapshotChunk
++    stream_ = SnapshotStream::Create(browser_context(), extension_id());
++    stream_snapshot_id_ = next_snapshot_id_++;
++    browser_os::InteractiveSnapshot snapshot;
++    snapshot.snapshot_id = stream_snapshot_id_;
++    snapshot.timestamp = base::Time::Now().InMillisecondsFSinceUnixEpoch();
++    snapshot.processing_time_ms = 0;
++    snapshot.stream_id = stream_->id();
++    return RespondNow(ArgumentList(
++        browser_os::GetInteractiveSnapshot::Results::Create(snapshot)));
++  }
++
 +  return RespondLater();
 +}
 +
++void BrowserOSGetInteractiveSnapshotFunction::RespondWithSnapshot(
++    browser_os::InteractiveSnapshot snapshot) {
++  if (stream_) {
++    stream_->Finish(std::move(snapshot));
++    return;
++  }
++  Respond(ArgumentList(
++      browser_os::GetInteractiveSnapshot::Results::Create(snapshot)));
++}
++
 +void BrowserOSGetInteractiveSnapshotFunction::OnAccessibilityTreeReceived(
 +    ui::AXTreeUpdate& tree_update) {
 +  // Double-check frame is still valid before processing
 +  if (!web_contents_) {
 +    LOG(WARNING) << "[browseros] WebContents gone during AX snapshot callback";
 +    browser_os::InteractiveSnapshot empty_snapshot;
-+    empty_snapshot.snapshot_id = next_snapshot_id_++;
++    empty_snapshot.snapshot_id =
++        stream_ ? stream_snapshot_id_ : next_snapshot_id_++;
 +    empty_snapshot.timestamp = base::Time::Now().InMillisecondsFSinceUnixEpoch();
 +    empty_snapshot.processing_time_ms = 0;
-+    Respond(ArgumentList(
-+        browser_os::GetInteractiveSnapshot::Results::Create(empty_snapshot)));
++    RespondWithSnapshot(std::move(empty_snapshot));
 +    return;
 +  }
 +  
@@ -410,20 +512,44 @@ index 0000000000000..c08b705ef6869
 +  if (!rfh || !rfh->IsRenderFrameLive()) {
 +    LOG(WARNING) << "[browseros] Frame became unstable during AX snapshot callback";
 +    browser_os::InteractiveSnapshot empty_snapshot;
-+    empty_snapshot.snapshot_id = next_snapshot_id_++;
++    empty_snapshot.snapshot_id =
++        stream_ ? stream_snapshot_id_ : next_snapshot_id_++;
 +    empty_snapshot.timestamp = base::Time::Now().InMillisecondsFSinceUnixEpoch();
 +    empty_snapshot.processing_time_ms = 0;
-+    Respond(ArgumentList(
-+        browser_os::GetInteractiveSnapshot::Results::Create(empty_snapshot)));
++    RespondWithSnapshot(std::move(empty_snapshot));
 +    return;
 +  }
 +  
++  // The renderer stopped at the tree cap or its timeout, so part of the page
++  // was never seen
++  tree_truncated_ =
++      (max_nodes_ > 0 &&
++       tree_update.nodes.size() >= max_nodes_ * kTreeNodesPerInteractiveNode) ||
++      AcquisitionTimedOut(acquisition_deadline_);
++
++  SnapshotOptions options;
++  options.incremental = incremental_;
++  options.viewport_only = viewport_only_;
++  options.max_nodes = max_nodes_;
++  options.deadline = deadline_;
++  if (stream_) {
++    options.on_chunk =
++        base::BindRepeating(&SnapshotStream::AddElements, stream_);
++  }
++  if (incremental_) {
++    if (auto* cache =
++            BrowserOSSnapshotCache::FromWebContents(web_contents_.get())) {
++      options.reuse_table = cache->reuse_table();
++    }
++  }
++  
 +  // Simple API layer - just delegates to the processor
 +  SnapshotProcessor::ProcessAccessibilityTree(
-+      tree_update,
++      std::move(tree_update),
 +      tab_id_,
-+      next_snapshot_id_++,
++      stream_ ? stream_snapshot_id_ : next_snapshot_id_++,
 +      web_contents_.get(),
++      options,
 +      base::BindOnce(
 +          &BrowserOSGetInteractiveSnapshotFunction::OnSnapshotProcessed,
 +          base::WrapRefCounted(this)));
@@ -431,8 +557,74 @@ index 0000000000000..c08b705ef6869
 +
 +void BrowserOSGetInteractiveSnapshotFunction::OnSnapshotProcessed(
 +    SnapshotProcessingResult result) {
++  // Sampled so that the fleet-wide snapshot cost is visible without logging
++  // every agent step
++  browseros_metrics::BrowserOSMetrics::Log(
++      "api.snapshot.interactive",
++      {{"tree_nodes", base::Value(static_cast<int>(result.stats.tree_nodes))},
++       {"interactive_nodes", base::Value(result.nodes_processed)},
++       {"processing_ms",
++        base::Value(static_cast<int>(result.processing_time_ms))},
++       {"index_kb",
++        base::Value(static_cast<int>(result.stats.node_index_bytes / 1024))},
++       {"incremental", base::Value(incremental_)},
++       {"viewport_only", base::Value(viewport_only_)},
++       {"nodes_culled",
++        base::Value(static_cast<int>(result.stats.nodes_culled))},
++       {"nodes_reused", base::Value(result.nodes_reused)},
++       {"max_nodes", base::Value(static_cast<int>(max_nodes_))},
++       {"deadline", base::Value(!deadline_.is_null())},
++       {"truncated", base::Value(result.truncated)},
++       {"streamed", base::Value(!!stream_)},
++       {"first_element_ms",
++        base::Value(stream_ && stream_->time_to_first_element()
++                        ? static_cast<int>(stream_->time_to_first_element()
++                                               ->InMilliseconds())
++                        : -1)}},
++      0.01);
++
++  if (max_nodes_ > 0 || !deadline_.is_null()) {
++    result.truncated |= tree_truncated_;
++    result.snapshot.truncated = result.truncated;
++  }
++
++  if (incremental_ && web_contents_) {
++    auto* cache = BrowserOSSnapshotCache::FromWebContents(web_contents_.get());
++    // A navigation or executeActions invalidated the cache while this
++    // snapshot was in flight, so it may describe the old document
++    if (cache && cache->generation() == cache_generation_) {
++      cache->Update(viewport_only_, result);
++    }
++  }
++
++  RespondWithSnapshot(std::move(result.snapshot));
++}
++
++// Implementation of BrowserOSGetInteractiveSnapshotChunkFunction
++
++ExtensionFunction::ResponseAction
++BrowserOSGetInteractiveSnapshotChunkFunction::Run() {
++  std::optional<browser_os::GetInteractiveSnapshotChunk::Params> params =
++      browser_os::GetInteractiveSnapshotChunk::Params::Create(args());
++  EXTENSION_FUNCTION_VALIDATE(params);
++
++  scoped_refptr<SnapshotStream> stream = SnapshotStream::Find(
++      params->stream_id, browser_context(), extension_id());
++  if (!stream) {
++    return RespondNow(Error("Unknown or finished snapshot stream"));
++  }
++  if (!stream->ReadNextChunk(base::BindOnce(
++          &BrowserOSGetInteractiveSnapshotChunkFunction::OnChunk, this))) {
++    return RespondNow(Error("A read is already pending on this stream"));
++  }
++  // The chunk may already have been delivered synchronously
++  return did_respond() ? AlreadyResponded() : RespondLater();
++}
++
++void BrowserOSGetInteractiveSnapshotChunkFunction::OnChunk(
++    browser_os::SnapshotChunk chunk) {
 +  Respond(ArgumentList(
-+      browser_os::GetInteractiveSnapshot::Results::Create(result.snapshot)));
++      browser_os::GetInteractiveSnapshotChunk::Results::Create(chunk)));
 +}
 +
 +// Implementation of BrowserOSClickFunction
@@ -452,30 +644,31 @@ index 0000000000000..c08b705ef6869
 +  }
 +  
 +  content::WebContents* web_contents = tab_info->web_contents;
-+  int tab_id = tab_info->tab_id;
 +
 +  // Look up the AX node ID from our nodeId
-+  auto tab_it = GetNodeIdMappings().find(tab_id);
-+  if (tab_it == GetNodeIdMappings().end()) {
-+    return RespondNow(Error("No snapshot data for this tab"));
-+  }
-+  
-+  auto node_it = tab_it->second.find(params->node_id);
-+  if (node_it == tab_it->second.end()) {
-+    return RespondNow(Error("Node ID not found"));
++  std::string node_error;
++  const NodeInfo* found_node =
++      FindNode(web_contents, params->node_id, &node_error);
++  if (!found_node) {
++    return RespondNow(Error(node_error));
 +  }
-+  
-+  const NodeInfo& node_info = node_it->second;
++  const NodeInfo& node_info = *found_node;
 +  
 +  // Perform click with change detection
-+  bool change_detected = ClickWithDetection(web_contents, node_info);
-+  
++  ClickWithDetection(
++      web_contents, node_info,
++      base::BindOnce(&BrowserOSClickFunction::OnClickDone, this));
++  return did_respond() ? AlreadyResponded() : RespondLater();
++}
++
++void BrowserOSClickFunction::OnClickDone(const PageChanges& changes) {
++  const bool change_detected = changes.any();
 +  // Create interaction response
 +  browser_os::InteractionResponse response;
 +  response.success = change_detected;
-+  
-+  return RespondNow(ArgumentList(
-+      browser_os::Click::Results::Create(response)));
++  response.changes = ToIdlPageChanges(changes);
++
++  Respond(ArgumentList(browser_os::Click::Results::Create(response)));
 +}
 +
 +// Implementation of BrowserOSInputTextFunction
@@ -495,36 +688,40 @@ index 0000000000000..c08b705ef6869
 +  }
 +  
 +  content::WebContents* web_contents = tab_info->web_contents;
-+  int tab_id = tab_info->tab_id;
 +
 +  // Look up the AX node ID from our nodeId
-+  auto tab_it = GetNodeIdMappings().find(tab_id);
-+  if (tab_it == GetNodeIdMappings().end()) {
-+    return RespondNow(Error("No snapshot data for this tab"));
++  std::string node_error;
++  const NodeInfo* found_node =
++      FindNode(web_contents, params->node_id, &node_error);
++  if (!found_node) {
++    return RespondNow(Error(node_error));
 +  }
-+  
-+  auto node_it = tab_it->second.find(params->node_id);
-+  if (node_it == tab_it->second.end()) {
-+    return RespondNow(Error("Node ID not found"));
-+  }
-+  
-+  const NodeInfo& node_info = node_it->second;
++  const NodeInfo& node_info = *found_node;
 +  
 +  LOG(INFO) << "[browseros] InputText: Starting input for nodeId: " << params->node_id;
 +  
-+  // Use TypeWithDetection which tries both native and JavaScript methods
-+  bool change_detected = TypeWithDetection(web_contents, node_info, params->text);
-+  
++  // Use TypeWithDetection which tries IME, SetValue and script input before
++  // falling back to per-character key events
++  TypeWithDetection(
++      web_contents, node_info, params->text,
++      base::BindOnce(&BrowserOSInputTextFunction::OnInputDone, this));
++  return did_respond() ? AlreadyResponded() : RespondLater();
++}
++
++void BrowserOSInputTextFunction::OnInputDone(const PageChanges& changes,
++                                             TextInputMethod method) {
++  const bool change_detected = changes.any();
 +  if (!change_detected) {
 +    LOG(WARNING) << "[browseros] InputText: No change detected after typing";
 +  }
-+  
++
 +  // Create interaction response
 +  browser_os::InteractionResponse response;
 +  response.success = change_detected;
-+  
-+  return RespondNow(ArgumentList(
-+      browser_os::InputText::Results::Create(response)));
++  response.changes = ToIdlPageChanges(changes);
++  response.input_method = ToIdlTextInputMethod(method);
++
++  Respond(ArgumentList(browser_os::InputText::Results::Create(response)));
 +}
 +
 +// Implementation of BrowserOSClearFunction
@@ -544,36 +741,37 @@ index 0000000000000..c08b705ef6869
 +  }
 +  
 +  content::WebContents* web_contents = tab_info->web_contents;
-+  int tab_id = tab_info->tab_id;
 +
 +  // Look up the AX node ID from our nodeId
-+  auto tab_it = GetNodeIdMappings().find(tab_id);
-+  if (tab_it == GetNodeIdMappings().end()) {
-+    return RespondNow(Error("No snapshot data for this tab"));
-+  }
-+  
-+  auto node_it = tab_it->second.find(params->node_id);
-+  if (node_it == tab_it->second.end()) {
-+    return RespondNow(Error("Node ID not found"));
++  std::string node_error;
++  const NodeInfo* found_node =
++      FindNode(web_contents, params->node_id, &node_error);
++  if (!found_node) {
++    return RespondNow(Error(node_error));
 +  }
-+  
-+  const NodeInfo& node_info = node_it->second;
++  const NodeInfo& node_info = *found_node;
 +  
 +  LOG(INFO) << "[browseros] Clear: Clearing field for nodeId: " << params->node_id;
 +  
 +  // Use ClearWithDetection which handles focus and clearing
-+  bool change_detected = ClearWithDetection(web_contents, node_info);
-+  
++  ClearWithDetection(
++      web_contents, node_info,
++      base::BindOnce(&BrowserOSClearFunction::OnClearDone, this));
++  return did_respond() ? AlreadyResponded() : RespondLater();
++}
++
++void BrowserOSClearFunction::OnClearDone(const PageChanges& changes) {
++  const bool change_detected = changes.any();
 +  if (!change_detected) {
 +    LOG(WARNING) << "[browseros] Clear: No change detected after clearing";
 +  }
-+  
++
 +  // Create interaction response
 +  browser_os::InteractionResponse response;
 +  response.success = change_detected;
-+  
-+  return RespondNow(ArgumentList(
-+      browser_os::Clear::Results::Create(response)));
++  response.changes = ToIdlPageChanges(changes);
++
++  Respond(ArgumentList(browser_os::Clear::Results::Create(response)));
 +}
 +
 +// Implementation of BrowserOSGetPageLoadStatusFunction
@@ -632,30 +830,11 @@ index 0000000000000..c08b705ef6869
 +    return RespondNow(Error(error_message));
 +  }
 +  
-+  content::WebContents* web_contents = tab_info->web_contents;
-+  
-+  // Get viewport height to scroll by approximately one page
-+  content::RenderFrameHost* rfh = web_contents->GetPrimaryMainFrame();
-+  if (!rfh) {
-+    return RespondNow(Error("No render frame"));
-+  }
-+  
-+  content::RenderWidgetHost* rwh = rfh->GetRenderWidgetHost();
-+  if (!rwh) {
-+    return RespondNow(Error("No render widget host"));
-+  }
-+  
-+  content::RenderWidgetHostView* rwhv = rwh->GetView();
-+  if (!rwhv) {
++  // Scroll by about one page
++  if (!ScrollPage(tab_info->web_contents, /*down=*/false)) {
 +    return RespondNow(Error("No render widget host view"));
 +  }
-+  
-+  gfx::Rect viewport_bounds = rwhv->GetViewBounds();
-+  int scroll_amount = viewport_bounds.height() * 0.9;  // 90% of viewport height
-+  
-+  // Perform scroll up (negative delta_y)
-+  Scroll(web_contents, 0, -scroll_amount, true);
-+  
++
 +  return RespondNow(NoArguments());
 +}
 +
@@ -675,30 +854,11 @@ index 0000000000000..c08b705ef6869
 +    return RespondNow(Error(error_message));
 +  }
 +  
-+  content::WebContents* web_contents = tab_info->web_contents;
-+  
-+  // Get viewport height to scroll by approximately one page
-+  content::RenderFrameHost* rfh = web_contents->GetPrimaryMainFrame();
-+  if (!rfh) {
-+    return RespondNow(Error("No render frame"));
-+  }
-+  
-+  content::RenderWidgetHost* rwh = rfh->GetRenderWidgetHost();
-+  if (!rwh) {
-+    return RespondNow(Error("No render widget host"));
-+  }
-+  
-+  content::RenderWidgetHostView* rwhv = rwh->GetView();
-+  if (!rwhv) {
++  // Scroll by about one page
++  if (!ScrollPage(tab_info->web_contents, /*down=*/true)) {
 +    return RespondNow(Error("No render widget host view"));
 +  }
-+  
-+  gfx::Rect viewport_bounds = rwhv->GetViewBounds();
-+  int scroll_amount = viewport_bounds.height() * 0.9;  // 90% of viewport height
-+  
-+  // Perform scroll down (positive delta_y)
-+  Scroll(web_contents, 0, scroll_amount, true);
-+  
++
 +  return RespondNow(NoArguments());
 +}
 +
@@ -719,20 +879,15 @@ index 0000000000000..c08b705ef6869
 +  }
 +  
 +  content::WebContents* web_contents = tab_info->web_contents;
-+  int tab_id = tab_info->tab_id;
 +  
 +  // Look up the AX node ID from our nodeId
-+  auto tab_it = GetNodeIdMappings().find(tab_id);
-+  if (tab_it == GetNodeIdMappings().end()) {
-+    return RespondNow(Error("No snapshot data for this tab"));
-+  }
-+  
-+  auto node_it = tab_it->second.find(params->node_id);
-+  if (node_it == tab_it->second.end()) {
-+    return RespondNow(Error("Node ID not found"));
++  std::string node_error;
++  const NodeInfo* found_node =
++      FindNode(web_contents, params->node_id, &node_error);
++  if (!found_node) {
++    return RespondNow(Error(node_error));
 +  }
-+  
-+  const NodeInfo& node_info = node_it->second;
++  const NodeInfo& node_info = *found_node;
 +  
 +  // Get viewport bounds to check if node is already in view
 +  content::RenderFrameHost* rfh = web_contents->GetPrimaryMainFrame();
@@ -798,32 +953,32 @@ index 0000000000000..c08b705ef6869
 +  
 +  content::WebContents* web_contents = tab_info->web_contents;
 +  
-+  // Validate the key - use a simple check instead of std::set to avoid exit-time destructor
-+  const std::string& key = params->key;
-+  bool is_supported = (key == "Enter" || key == "Delete" || key == "Backspace" ||
-+                       key == "Tab" || key == "Escape" || key == "ArrowUp" ||
-+                       key == "ArrowDown" || key == "ArrowLeft" || key == "ArrowRight" ||
-+                       key == "Home" || key == "End" || key == "PageUp" || key == "PageDown");
-+  
-+  if (!is_supported) {
++  // Validate the key
++  if (!IsSupportedKey(params->key)) {
 +    return RespondNow(Error("Unsupported key: " + params->key));
 +  }
 +  
 +  LOG(INFO) << "[browseros] SendKeys: Sending key '" << params->key << "'";
 +  
 +  // Send the key with change detection
-+  bool change_detected = KeyPressWithDetection(web_contents, params->key);
-+  
++  KeyPressWithDetection(
++      web_contents, params->key,
++      base::BindOnce(&BrowserOSSendKeysFunction::OnKeyPressDone, this));
++  return did_respond() ? AlreadyResponded() : RespondLater();
++}
++
++void BrowserOSSendKeysFunction::OnKeyPressDone(const PageChanges& changes) {
++  const bool change_detected = changes.any();
 +  if (!change_detected) {
 +    LOG(WARNING) << "[browseros] SendKeys: No change detected after key press";
 +  }
-+  
++
 +  // Create interaction response
 +  browser_os::InteractionResponse response;
 +  response.success = change_detected;
-+  
-+  return RespondNow(ArgumentList(
-+      browser_os::SendKeys::Results::Create(response)));
++  response.changes = ToIdlPageChanges(changes);
++
++  Respond(ArgumentList(browser_os::SendKeys::Results::Create(response)));
 +}
 +
 +// Implementation of BrowserOSCaptureScreenshotFunction
@@ -839,6 +994,29 @@ index 0000000000000..c08b705ef6869
 +  // Store whether to show highlights
 +  show_highlights_ = params->show_highlights.value_or(false);
 +
++  if (params->options) {
++    switch (params->options->format) {
++      case browser_os::ImageFormat::kNone:
++      case browser_os::ImageFormat::kPng:
++        encoding_.format = ScreenshotFormat::kPng;
++        break;
++      case browser_os::ImageFormat::kJpeg:
++        encoding_.format = ScreenshotFormat::kJpeg;
++        break;
++      case browser_os::ImageFormat::kWebp:
++        encoding_.format = ScreenshotFormat::kWebp;
++        break;
++    }
++    if (params->options->quality) {
++      if (*params->options->quality < 0 || *params->options->quality > 100) {
++        return RespondNow(Error("quality must be between 0 and 100"));
++      }
++      encoding_.quality = *params->options->quality;
++    }
++    encoding_.binary = params->options->binary.value_or(false);
++    diff_ = params->options->diff.value_or(false);
++  }
++
 +  // Get the target tab
 +  std::string error_message;
 +  auto tab_info = GetTabFromOptionalId(params->tab_id, browser_context(),
@@ -850,7 +1028,6 @@ index 0000000000000..c08b705ef6869
 +  
 +  content::WebContents* web_contents = tab_info->web_contents;
 +  web_contents_ = web_contents->GetWeakPtr();
-+  tab_id_ = tab_info->tab_id;
 +  
 +  // Get the render widget host view
 +  content::RenderFrameHost* rfh = web_contents->GetPrimaryMainFrame();
@@ -870,6 +1047,34 @@ index 0000000000000..c08b705ef6869
 +  
 +  // Get the view bounds to determine the size
 +  gfx::Rect view_bounds = rwhv->GetViewBounds();
++
++  // A crop limits the readback, and with it the encode, to that region
++  if (params->options && (params->options->node_id || params->options->clip)) {
++    if (params->options->node_id && params->options->clip) {
++      return RespondNow(Error("Specify either nodeId or clip, not both"));
++    }
++    gfx::RectF region;
++    if (params->options->node_id) {
++      const NodeInfo* node_info = FindNode(
++          web_contents, *params->options->node_id, &error_message);
++      if (!node_info) {
++        return RespondNow(Error(error_message));
++      }
++      region = node_info->bounds;
++    } else {
++      const browser_os::Rect& clip = *params->options->clip;
++      region = gfx::RectF(clip.x, clip.y, clip.width, clip.height);
++    }
++    std::optional<gfx::Rect> source_rect = ClipToView(
++        region, CssToWidgetScale(web_contents, rwh), view_bounds.size());
++    if (!source_rect) {
++      return RespondNow(Error("Region to capture is empty or outside the "
++                              "viewport; scroll it into view first"));
++    }
++    source_rect_ = *source_rect;
++  }
++  const gfx::Size source_size =
++      source_rect_.IsEmpty() ? view_bounds.size() : source_rect_.size();
 +  
 +  // Check if exact width and height are specified
 +  if (params->width && params->height) {
@@ -889,18 +1094,18 @@ index 0000000000000..c08b705ef6869
 +    int max_dimension;
 +    if (params->thumbnail_size) {
 +      // Take minimum of requested size and viewport dimensions
-+      int viewport_max = std::max(view_bounds.width(), view_bounds.height());
++      int viewport_max = std::max(source_size.width(), source_size.height());
 +      max_dimension = std::min(static_cast<int>(*params->thumbnail_size), viewport_max);
 +      LOG(INFO) << "[browseros] CaptureScreenshot: Using thumbnail size: " << max_dimension 
 +                << " (requested: " << *params->thumbnail_size 
 +                << ", viewport max: " << viewport_max << ")";
 +    } else {
 +      // No thumbnail size specified, use viewport dimensions
-+      max_dimension = std::max(view_bounds.width(), view_bounds.height());
++      max_dimension = std::max(source_size.width(), source_size.height());
 +      LOG(INFO) << "[browseros] CaptureScreenshot: Using viewport size: " << max_dimension;
 +    }
 +    
-+    gfx::Size thumbnail_size = view_bounds.size();
++    gfx::Size thumbnail_size = source_size;
 +    
 +    // Scale down proportionally if needed
 +    if (thumbnail_size.width() > max_dimension || 
@@ -914,41 +1119,23 @@ index 0000000000000..c08b705ef6869
 +    target_size_ = thumbnail_size;
 +  }
 +  
-+  // Store target size for later use
-+  
-+  // Draw highlights first, then capture after a short delay
-+  DrawHighlightsAndCapture();
-+  
-+  return RespondLater();
-+}
-+
-+void BrowserOSCaptureScreenshotFunction::DrawHighlightsAndCapture() {
-+  // Only draw highlights if requested via the showHighlights flag
 +  if (show_highlights_) {
-+    // Check if we have snapshot data for this tab to draw highlights
-+    auto tab_it = GetNodeIdMappings().find(tab_id_);
-+    if (tab_it != GetNodeIdMappings().end() && !tab_it->second.empty()) {
-+      LOG(INFO) << "[browseros] Drawing highlights for screenshot with " 
-+                << tab_it->second.size() << " interactive elements";
-+      if (web_contents_) {
-+        ShowHighlights(web_contents_.get(), tab_it->second, true /* show_labels */);
-+      }
++    BrowserOSNodeIdStore* node_id_store =
++        BrowserOSNodeIdStore::FromWebContents(web_contents);
++    const BrowserOSNodeIdStore::NodeMap* nodes =
++        node_id_store ? node_id_store->current_nodes() : nullptr;
++    if (nodes) {
++      highlights_ = CollectScreenshotHighlights(
++          *nodes, source_rect_.IsEmpty() ? gfx::Rect(view_bounds.size())
++                                         : source_rect_);
 +    } else {
 +      LOG(INFO) << "[browseros] No snapshot data available for highlighting";
 +    }
-+    
-+    // Use PostDelayedTask to allow the renderer to paint the highlights
-+    // This lets the event loop run and process the DOM changes
-+    // Use scoped_refptr to keep the function alive
-+    base::SequencedTaskRunner::GetCurrentDefault()->PostDelayedTask(
-+        FROM_HERE,
-+        base::BindOnce(&BrowserOSCaptureScreenshotFunction::CaptureScreenshotNow,
-+                       base::WrapRefCounted(this)),
-+        base::Milliseconds(1000));  // Give enough time for JS execution and paint
-+  } else {
-+    // No highlights needed, capture immediately
-+    CaptureScreenshotNow();
 +  }
++
++  CaptureScreenshotNow();
++
++  return RespondLater();
 +}
 +
 +void BrowserOSCaptureScreenshotFunction::CaptureScreenshotNow() {
@@ -979,8 +1166,10 @@ index 0000000000000..c08b705ef6869
 +  }
 +  
 +  // Request the screenshot
++  // The source rect is in DIPs and the view scales it by the device scale
++  // factor, so only the cropped pixels are read back
 +  view->CopyFromSurface(
-+      gfx::Rect(),  // Empty rect means copy entire surface
++      source_rect_,  // Empty rect means copy entire surface
 +      target_size_,
 +      base::BindOnce(&BrowserOSCaptureScreenshotFunction::OnScreenshotCaptured,
 +                     this));
@@ -988,30 +1177,193 @@ index 0000000000000..c08b705ef6869
 +
 +void BrowserOSCaptureScreenshotFunction::OnScreenshotCaptured(
 +    const SkBitmap& bitmap) {
-+  // Clean up the highlights immediately after capture (only if we added them)
-+  if (show_highlights_ && web_contents_) {
-+    RemoveHighlights(web_contents_.get());
-+  }
-+  
 +  if (bitmap.empty()) {
 +    Respond(Error("Failed to capture screenshot"));
 +    return;
 +  }
-+  
-+  // Convert bitmap to PNG
-+  auto png_data = gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false);
-+  if (!png_data.has_value()) {
++
++  if (diff_) {
++    content::WebContents* web_contents = web_contents_.get();
++    if (!web_contents) {
++      Respond(Error("Web contents destroyed"));
++      return;
++    }
++    BrowserOSScreenshotCache::CreateForWebContents(web_contents);
++    BrowserOSScreenshotCache* cache =
++        BrowserOSScreenshotCache::FromWebContents(web_contents);
++    const BrowserOSScreenshotCache::Frame& last_frame = cache->last_frame();
++    // Frames of another region are not comparable even at the same size
++    SkBitmap previous =
++        last_frame.region == source_rect_ ? last_frame.bitmap : SkBitmap();
++    const int sequence = cache->NextSequence();
++    base::ThreadPool::PostTaskAndReplyWithResult(
++        FROM_HERE,
++        {base::TaskPriority::USER_BLOCKING,
++         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
++        base::BindOnce(&HighlightAndDiffScreenshot, bitmap,
++                       std::move(highlights_), std::move(previous), sequence,
++                       last_frame.sequence, encoding_),
++        base::BindOnce(&BrowserOSCaptureScreenshotFunction::OnScreenshotDiffed,
++                       this, sequence));
++    return;
++  }
++
++  // Encoding a full-HD frame takes tens of milliseconds, so it runs on a
++  // worker instead of blocking input, together with drawing the highlights.
++  // The bitmap shares its pixels.
++  base::ThreadPool::PostTaskAndReplyWithResult(
++      FROM_HERE,
++      {base::TaskPriority::USER_BLOCKING,
++       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
++      base::BindOnce(&HighlightAndEncodeScreenshot, bitmap,
++                     std::move(highlights_), encoding_),
++      base::BindOnce(&BrowserOSCaptureScreenshotFunction::OnScreenshotEncoded,
++                     this));
++}
++
++void BrowserOSCaptureScreenshotFunction::OnScreenshotEncoded(
++    std::optional<base::Value> screenshot) {
++  if (!screenshot) {
 +    Respond(Error("Failed to encode screenshot"));
 +    return;
 +  }
-+  
-+  // Convert to base64 data URL
-+  std::string base64_data = base::Base64Encode(png_data.value());
-+  
-+  std::string data_url = "data:image/png;base64," + base64_data;
-+  
++
++  Respond(ArgumentList(
++      browser_os::CaptureScreenshot::Results::Create(*screenshot)));
++}
++
++void BrowserOSCaptureScreenshotFunction::OnScreenshotDiffed(
++    int sequence,
++    ScreenshotDiffOutput output) {
++  if (web_contents_ && output.value) {
++    if (BrowserOSScreenshotCache* cache =
++            BrowserOSScreenshotCache::FromWebContents(web_contents_.get())) {
++      cache->StoreFrame(sequence, source_rect_, std::move(output.frame));
++    }
++  }
++  OnScreenshotEncoded(std::move(output.value));
++}
++
++// Implementation of BrowserOSStartScreencastFunction
++
++ExtensionFunction::ResponseAction BrowserOSStartScreencastFunction::Run() {
++  std::optional<browser_os::StartScreencast::Params> params =
++      browser_os::StartScreencast::Params::Create(args());
++  EXTENSION_FUNCTION_VALIDATE(params);
++
++  std::string error_message;
++  auto tab_info = GetTabFromOptionalId(params->tab_id, browser_context(),
++                                       include_incognito_information(),
++                                       &error_message);
++  if (!tab_info) {
++    return RespondNow(Error(error_message));
++  }
++
++  content::WebContents* web_contents = tab_info->web_contents;
++  content::RenderWidgetHostView* rwhv =
++      web_contents->GetRenderWidgetHostView();
++  if (!rwhv) {
++    return RespondNow(Error("No render widget host view"));
++  }
++  // Frames arrive in physical pixels, so the default bound is the view's
++  // size in those rather than in DIPs
++  const gfx::Size view_size = gfx::ScaleToCeiledSize(
++      rwhv->GetViewBounds().size(), rwhv->GetDeviceScaleFactor());
++
++  BrowserOSScreencast::Options options;
++  options.encoding.format = ScreenshotFormat::kJpeg;
++  options.max_size = view_size;
++  if (params->options) {
++    const browser_os::ScreencastOptions& screencast_options = *params->options;
++    if (screencast_options.max_fps) {
++      if (*screencast_options.max_fps < 1 ||
++          *screencast_options.max_fps > BrowserOSScreencast::kMaxFps) {
++        return RespondNow(Error(base::StringPrintf(
++            "maxFps must be between 1 and %d", BrowserOSScreencast::kMaxFps)));
++      }
++      options.max_fps = *screencast_options.max_fps;
++    }
++    if (screencast_options.max_width.value_or(1) <= 0 ||
++        screencast_options.max_height.value_or(1) <= 0) {
++      return RespondNow(Error("maxWidth and maxHeight must be positive"));
++    }
++    options.max_size =
++        gfx::Size(screencast_options.max_width.value_or(view_size.width()),
++                  screencast_options.max_height.value_or(view_size.height()));
++    switch (screencast_options.format) {
++      case browser_os::ImageFormat::kNone:
++      case browser_os::ImageFormat::kJpeg:
++        options.encoding.format = ScreenshotFormat::kJpeg;
++        break;
++      case browser_os::ImageFormat::kPng:
++        options.encoding.format = ScreenshotFormat::kPng;
++        break;
++      case browser_os::ImageFormat::kWebp:
++        options.encoding.format = ScreenshotFormat::kWebp;
++        break;
++    }
++    if (screencast_options.quality) {
++      if (*screencast_options.quality < 0 ||
++          *screencast_options.quality > 100) {
++        return RespondNow(Error("quality must be between 0 and 100"));
++      }
++      options.encoding.quality = *screencast_options.quality;
++    }
++    options.encoding.binary = screencast_options.binary.value_or(false);
++  }
++  if (options.max_size.IsEmpty()) {
++    return RespondNow(Error("The tab has no visible area to capture"));
++  }
++
++  BrowserOSScreencast* screencast =
++      BrowserOSScreencast::Start(web_contents, browser_context(),
++                                 extension_id(), options, &error_message);
++  if (!screencast) {
++    return RespondNow(Error(error_message));
++  }
++  return RespondNow(ArgumentList(
++      browser_os::StartScreencast::Results::Create(screencast->id())));
++}
++
++// Implementation of BrowserOSReadScreencastFrameFunction
++
++ExtensionFunction::ResponseAction BrowserOSReadScreencastFrameFunction::Run() {
++  std::optional<browser_os::ReadScreencastFrame::Params> params =
++      browser_os::ReadScreencastFrame::Params::Create(args());
++  EXTENSION_FUNCTION_VALIDATE(params);
++
++  BrowserOSScreencast* screencast = BrowserOSScreencast::Find(
++      params->screencast_id, browser_context(), extension_id());
++  if (!screencast) {
++    return RespondNow(Error("Unknown or stopped screencast"));
++  }
++  if (!screencast->ReadNextFrame(base::BindOnce(
++          &BrowserOSReadScreencastFrameFunction::OnFrame, this))) {
++    return RespondNow(Error("A read is already pending on this screencast"));
++  }
++  return RespondLater();
++}
++
++void BrowserOSReadScreencastFrameFunction::OnFrame(
++    browser_os::ScreencastFrame frame) {
 +  Respond(ArgumentList(
-+      browser_os::CaptureScreenshot::Results::Create(data_url)));
++      browser_os::ReadScreencastFrame::Results::Create(frame)));
++}
++
++// Implementation of BrowserOSStopScreencastFunction
++
++ExtensionFunction::ResponseAction BrowserOSStopScreencastFunction::Run() {
++  std::optional<browser_os::StopScreencast::Params> params =
++      browser_os::StopScreencast::Params::Create(args());
++  EXTENSION_FUNCTION_VALIDATE(params);
++
++  BrowserOSScreencast* screencast = BrowserOSScreencast::Find(
++      params->screencast_id, browser_context(), extension_id());
++  if (!screencast) {
++    return RespondNow(Error("Unknown or stopped screencast"));
++  }
++  screencast->Stop();
++  return RespondNow(NoArguments());
 +}
 +
 +// BrowserOSGetSnapshotFunction implementation
@@ -1029,6 +1381,27 @@ index 0000000000000..c08b705ef6869
 +  }
 +  
 +  content::WebContents* web_contents = tab_info->web_contents;
++
++  if (params->options) {
++    switch (params->options->format) {
++      case browser_os::PageContentFormat::kNone:
++      case browser_os::PageContentFormat::kItems:
++        content_options_.format = ContentFormat::kItems;
++        break;
++      case browser_os::PageContentFormat::kMarkdown:
++        content_options_.format = ContentFormat::kMarkdown;
++        break;
++      case browser_os::PageContentFormat::kText:
++        content_options_.format = ContentFormat::kText;
++        break;
++    }
++    if (params->options->max_chars) {
++      if (*params->options->max_chars <= 0) {
++        return RespondNow(Error("maxChars must be positive"));
++      }
++      content_options_.max_chars = *params->options->max_chars;
++    }
++  }
 +  
 +  // Request accessibility tree snapshot
 +  web_contents->RequestAXTreeSnapshot(
@@ -1048,16 +1421,25 @@ index 0000000000000..c08b705ef6869
 +    return;
 +  }
 +
-+  // Extract page content using the processor
-+  base::Time start_time = base::Time::Now();
-+  auto items = ContentProcessor::ExtractPageContent(tree_update);
++  // Extract page content on the thread pool; the update is not used again,
++  // so its nodes are moved rather than copied
++  start_time_ = base::Time::Now();
++  ContentProcessor::ExtractPageContentAsync(
++      std::move(tree_update), content_options_,
++      base::BindOnce(&BrowserOSGetSnapshotFunction::OnContentExtracted, this));
++}
 +
++void BrowserOSGetSnapshotFunction::OnContentExtracted(ContentResult content) {
 +  // Build result
 +  browser_os::PageContent result;
-+  result.items = std::move(items);
++  result.items = std::move(content.items);
++  if (content_options_.format != ContentFormat::kItems) {
++    result.content = std::move(content.content);
++    result.truncated = content.truncated;
++  }
 +  result.timestamp = base::Time::Now().InMillisecondsFSinceUnixEpoch();
 +  result.processing_time_ms =
-+      (base::Time::Now() - start_time).InMilliseconds();
++      (base::Time::Now() - start_time_).InMilliseconds();
 +
 +  Respond(ArgumentList(browser_os::GetSnapshot::Results::Create(result)));
 +}
@@ -1286,16 +1668,23 @@ index 0000000000000..c08b705ef6869
 +            << params->x << ", " << params->y << ")";
 +  
 +  // Perform the click with change detection
-+  bool success = ClickCoordinatesWithDetection(web_contents, click_point);
-+  
++  ClickCoordinatesWithDetection(
++      web_contents, click_point,
++      base::BindOnce(&BrowserOSClickCoordinatesFunction::OnClickDone, this));
++  return did_respond() ? AlreadyResponded() : RespondLater();
++}
++
++void BrowserOSClickCoordinatesFunction::OnClickDone(const PageChanges& changes) {
++  const bool success = changes.any();
 +  // Prepare the response
 +  browser_os::InteractionResponse response;
 +  response.success = success;
-+  
-+  LOG(INFO) << "[browseros] ClickCoordinates: Result = " 
++  response.changes = ToIdlPageChanges(changes);
++
++  LOG(INFO) << "[browseros] ClickCoordinates: Result = "
 +            << (success ? "success" : "no change detected");
-+  
-+  return RespondNow(ArgumentList(
++
++  Respond(ArgumentList(
 +      browser_os::ClickCoordinates::Results::Create(response)));
 +}
 +
@@ -1327,19 +1716,383 @@ index 0000000000000..c08b705ef6869
 +            << params->x << ", " << params->y << ") and typing: " << params->text;
 +  
 +  // Perform the click and type operation
-+  bool success = TypeAtCoordinatesWithDetection(web_contents, click_point, params->text);
-+  
++  TypeAtCoordinatesWithDetection(
++      web_contents, click_point, params->text,
++      base::BindOnce(&BrowserOSTypeAtCoordinatesFunction::OnTypeDone, this));
++  return did_respond() ? AlreadyResponded() : RespondLater();
++}
++
++void BrowserOSTypeAtCoordinatesFunction::OnTypeDone(const PageChanges& changes,
++                                                    TextInputMethod method) {
++  const bool success = changes.any();
 +  // Prepare the response
 +  browser_os::InteractionResponse response;
 +  response.success = success;
-+  
-+  LOG(INFO) << "[browseros] TypeAtCoordinates: Result = " 
++  response.changes = ToIdlPageChanges(changes);
++  response.input_method = ToIdlTextInputMethod(method);
++
++  LOG(INFO) << "[browseros] TypeAtCoordinates: Result = "
 +            << (success ? "success" : "failed");
-+  
-+  return RespondNow(ArgumentList(
++
++  Respond(ArgumentList(
 +      browser_os::TypeAtCoordinates::Results::Create(response)));
 +}
 +
++// Implementation of BrowserOSExecuteActionsFunction
++
++BrowserOSExecuteActionsFunction::BrowserOSExecuteActionsFunction() = default;
++BrowserOSExecuteActionsFunction::~BrowserOSExecuteActionsFunction() = default;
++
++ExtensionFunction::ResponseAction BrowserOSExecuteActionsFunction::Run() {
++  std::optional<browser_os::ExecuteActions::Params> params =
++      browser_os::ExecuteActions::Params::Create(args());
++  EXTENSION_FUNCTION_VALIDATE(params);
++
++  // Get the target tab once for the whole batch
++  std::string error_message;
++  auto tab_info = GetTabFromOptionalId(params->tab_id, browser_context(),
++                                       include_incognito_information(),
++                                       &error_message);
++  if (!tab_info) {
++    return RespondNow(Error(error_message));
++  }
++  if (params->actions.empty()) {
++    return RespondNow(Error("No actions given"));
++  }
++  if (params->actions.size() > kMaxActions) {
++    return RespondNow(Error(base::StringPrintf(
++        "At most %zu actions can be given, got %zu", kMaxActions,
++        params->actions.size())));
++  }
++
++  tab_id_ = tab_info->tab_id;
++  web_contents_ = tab_info->web_contents->GetWeakPtr();
++  actions_ = std::move(params->actions);
++  if (params->options) {
++    detect_each_ = params->options->change_detection !=
++                   browser_os::ChangeDetection::kFinal;
++    stop_on_error_ = params->options->stop_on_error.value_or(true);
++    snapshot_ = params->options->snapshot.value_or(false);
++  }
++
++  LOG(INFO) << "[browseros] ExecuteActions: " << actions_.size()
++            << " actions, detecting " << (detect_each_ ? "each" : "final");
++
++  // Every action moves on through a posted task, so the response always
++  // comes later
++  RunNextAction();
++  return RespondLater();
++}
++
++void BrowserOSExecuteActionsFunction::PostNextAction() {
++  base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
++      FROM_HERE,
++      base::BindOnce(&BrowserOSExecuteActionsFunction::RunNextAction, this));
++}
++
++void BrowserOSExecuteActionsFunction::RunNextAction() {
++  if (next_action_ == actions_.size()) {
++    Finish();
++    return;
++  }
++  if (!web_contents_) {
++    OnActionFailed("Tab was closed");
++    return;
++  }
++
++  content::WebContents* web_contents = web_contents_.get();
++  const browser_os::Action& action = actions_[next_action_];
++  // In final mode only the last action waits for the page
++  const bool detect = detect_each_ || next_action_ + 1 == actions_.size();
++
++  // Node targets are looked up per action, so a node from the tab's latest
++  // snapshot is always used
++  const NodeInfo* node_info = nullptr;
++  switch (action.type) {
++    case browser_os::ActionType::kClick:
++    case browser_os::ActionType::kInputText:
++    case browser_os::ActionType::kClear: {
++      if (!action.node_id) {
++        OnActionFailed("nodeId is required");
++        return;
++      }
++      std::string node_error;
++      node_info = FindNode(web_contents, *action.node_id, &node_error);
++      if (!node_info) {
++        OnActionFailed(node_error);
++        return;
++      }
++      break;
++    }
++    default:
++      break;
++  }
++
++  auto detected =
++      base::BindOnce(&BrowserOSExecuteActionsFunction::OnActionDetected, this);
++  auto text_detected = base::BindOnce(
++      &BrowserOSExecuteActionsFunction::OnTextActionDetected, this);
++  auto dispatched =
++      base::BindOnce(&BrowserOSExecuteActionsFunction::OnActionDispatched, this);
++
++  switch (action.type) {
++    case browser_os::ActionType::kClick:
++      if (detect) {
++        ClickWithDetection(web_contents, *node_info, std::move(detected));
++      } else {
++        ClickNode(web_contents, *node_info, std::move(dispatched));
++      }
++      return;
++
++    case browser_os::ActionType::kInputText:
++      if (!action.text) {
++        OnActionFailed("text is required");
++        return;
++      }
++      if (detect) {
++        TypeWithDetection(web_contents, *node_info, *action.text,
++                          std::move(text_detected));
++      } else {
++        TypeIntoNode(web_contents, *node_info, *action.text,
++                     std::move(dispatched));
++      }
++      return;
++
++    case browser_os::ActionType::kClear:
++      if (detect) {
++        ClearWithDetection(web_contents, *node_info, std::move(detected));
++      } else {
++        ClearField(web_contents, *node_info);
++        std::move(dispatched).Run();
++      }
++      return;
++
++    case browser_os::ActionType::kSendKeys:
++      if (!action.key || !IsSupportedKey(*action.key)) {
++        OnActionFailed("Unsupported key: " + action.key.value_or(""));
++        return;
++      }
++      if (detect) {
++        KeyPressWithDetection(web_contents, *action.key, std::move(detected));
++      } else {
++        KeyPress(web_contents, *action.key);
++        std::move(dispatched).Run();
++      }
++      return;
++
++    case browser_os::ActionType::kScrollUp:
++    case browser_os::ActionType::kScrollDown: {
++      const bool down = action.type == browser_os::ActionType::kScrollDown;
++      if (detect) {
++        BrowserOSChangeDetector::ExecuteWithDetectionAsync(
++            web_contents,
++            [web_contents, down]() { ScrollPage(web_contents, down); },
++            std::move(detected));
++      } else if (ScrollPage(web_contents, down)) {
++        std::move(dispatched).Run();
++      } else {
++        OnActionFailed("No render widget host view");
++      }
++      return;
++    }
++
++    case browser_os::ActionType::kClickCoordinates:
++    case browser_os::ActionType::kTypeAtCoordinates: {
++      if (!action.x || !action.y) {
++        OnActionFailed("x and y are required");
++        return;
++      }
++      gfx::PointF point(*action.x, *action.y);
++      if (action.type == browser_os::ActionType::kClickCoordinates) {
++        if (detect) {
++          ClickCoordinatesWithDetection(web_contents, point,
++                                        std::move(detected));
++        } else {
++          PointClick(web_contents, point);
++          std::move(dispatched).Run();
++        }
++        return;
++      }
++      if (!action.text) {
++        OnActionFailed("text is required");
++        return;
++      }
++      if (detect) {
++        TypeAtCoordinatesWithDetection(web_contents, point, *action.text,
++                                       std::move(text_detected));
++      } else {
++        TypeAtPoint(web_contents, point, *action.text, std::move(dispatched));
++      }
++      return;
++    }
++
++    case browser_os::ActionType::kNone:
++      OnActionFailed("Unknown action type");
++      return;
++  }
++}
++
++void BrowserOSExecuteActionsFunction::OnActionDetected(
++    const PageChanges& changes) {
++  browser_os::ActionResult action_result;
++  action_result.success = changes.any();
++  action_result.changes = ToIdlPageChanges(changes);
++  result_.results.push_back(std::move(action_result));
++  ++next_action_;
++  PostNextAction();
++}
++
++void BrowserOSExecuteActionsFunction::OnTextActionDetected(
++    const PageChanges& changes,
++    TextInputMethod method) {
++  browser_os::ActionResult action_result;
++  action_result.success = changes.any();
++  action_result.changes = ToIdlPageChanges(changes);
++  action_result.input_method = ToIdlTextInputMethod(method);
++  result_.results.push_back(std::move(action_result));
++  ++next_action_;
++  PostNextAction();
++}
++
++void BrowserOSExecuteActionsFunction::OnActionDispatched() {
++  browser_os::ActionResult action_result;
++  action_result.success = true;
++  result_.results.push_back(std::move(action_result));
++  ++next_action_;
++  PostNextAction();
++}
++
++void BrowserOSExecuteActionsFunction::OnActionFailed(const std::string& error) {
++  LOG(WARNING) << "[browseros] ExecuteActions: action " << next_action_
++               << " failed: " << error;
++  browser_os::ActionResult action_result;
++  action_result.success = false;
++  action_result.error = error;
++  result_.results.push_back(std::move(action_result));
++  ++next_action_;
++
++  // Later actions usually depend on this one, so by default they are not run
++  if (stop_on_error_ || !web_contents_) {
++    next_action_ = actions_.size();
++  }
++  PostNextAction();
++}
++
++void BrowserOSExecuteActionsFunction::Finish() {
++  if (!snapshot_ || !web_contents_) {
++    Respond(ArgumentList(browser_os::ExecuteActions::Results::Create(result_)));
++    return;
++  }
++
++  // Post-action snapshot: a full one, which renumbers the tab's node IDs
++  if (auto* cache =
++          BrowserOSSnapshotCache::FromWebContents(web_contents_.get())) {
++    cache->Invalidate();
++  }
++  web_contents_->RequestAXTreeSnapshot(
++      base::BindOnce(
++          &BrowserOSExecuteActionsFunction::OnAccessibilityTreeReceived, this),
++      ui::AXMode(ui::AXMode::kWebContents | ui::AXMode::kExtendedProperties |
++                 ui::AXMode::kInlineTextBoxes),
++      /*max_nodes=*/0,
++      /*timeout=*/base::TimeDelta(),
++      content::WebContents::AXTreeSnapshotPolicy::kAll);
++}
++
++void BrowserOSExecuteActionsFunction::OnAccessibilityTreeReceived(
++    ui::AXTreeUpdate& tree_update) {
++  if (!web_contents_) {
++    Respond(ArgumentList(browser_os::ExecuteActions::Results::Create(result_)));
++    return;
++  }
++  SnapshotProcessor::ProcessAccessibilityTree(
++      std::move(tree_update), tab_id_,
++      BrowserOSGetInteractiveSnapshotFunction::TakeSnapshotId(),
++      web_contents_.get(), SnapshotOptions(),
++      base::BindOnce(&BrowserOSExecuteActionsFunction::OnSnapshotProcessed,
++                     base::WrapRefCounted(this)));
++}
++
++void BrowserOSExecuteActionsFunction::OnSnapshotProcessed(
++    SnapshotProcessingResult result) {
++  result_.snapshot = std::move(result.snapshot);
++  Respond(ArgumentList(browser_os::ExecuteActions::Results::Create(result_)));
++}
++
++// Implementation of BrowserOSWaitForSettleFunction
++
++ExtensionFunction::ResponseAction BrowserOSWaitForSettleFunction::Run() {
++  std::optional<browser_os::WaitForSettle::Params> params =
++      browser_os::WaitForSettle::Params::Create(args());
++  EXTENSION_FUNCTION_VALIDATE(params);
++
++  // Get the target tab
++  std::string error_message;
++  auto tab_info = GetTabFromOptionalId(params->tab_id, browser_context(),
++                                       include_incognito_information(),
++                                       &error_message);
++  if (!tab_info) {
++    return RespondNow(Error(error_message));
++  }
++
++  SettleOptions options;
++  if (params->options) {
++    if (params->options->quiet_ms) {
++      if (*params->options->quiet_ms < 0) {
++        return RespondNow(Error("quietMs must not be negative"));
++      }
++      options.quiet_period = base::Milliseconds(*params->options->quiet_ms);
++    }
++    if (params->options->timeout_ms) {
++      if (*params->options->timeout_ms < 0) {
++        return RespondNow(Error("timeoutMs must not be negative"));
++      }
++      options.max_wait = base::Milliseconds(*params->options->timeout_ms);
++    }
++  }
++
++  BrowserOSChangeDetector::WaitForSettle(
++      tab_info->web_contents, options,
++      base::BindOnce(&BrowserOSWaitForSettleFunction::OnSettled, this));
++  return did_respond() ? AlreadyResponded() : RespondLater();
++}
++
++void BrowserOSWaitForSettleFunction::OnSettled(const PageChanges& changes) {
++  Respond(ArgumentList(browser_os::WaitForSettle::Results::Create(
++      ToIdlPageChanges(changes))));
++}
++
++// Implementation of BrowserOSGetNodeMappingStatsFunction
++
++ExtensionFunction::ResponseAction BrowserOSGetNodeMappingStatsFunction::Run() {
++  std::optional<browser_os::GetNodeMappingStats::Params> params =
++      browser_os::GetNodeMappingStats::Params::Create(args());
++  EXTENSION_FUNCTION_VALIDATE(params);
++
++  // Get the target tab
++  std::string error_message;
++  auto tab_info = GetTabFromOptionalId(params->tab_id, browser_context(),
++                                       include_incognito_information(),
++                                       &error_message);
++  if (!tab_info) {
++    return RespondNow(Error(error_message));
++  }
++
++  browser_os::NodeMappingStats stats;
++  if (BrowserOSNodeIdStore* node_id_store =
++          BrowserOSNodeIdStore::FromWebContents(tab_info->web_contents)) {
++    stats.snapshots = static_cast<int>(node_id_store->snapshot_count());
++    stats.nodes = static_cast<int>(node_id_store->node_count());
++    stats.bytes = static_cast<double>(node_id_store->memory_usage());
++  }
++  stats.total_bytes =
++      static_cast<double>(BrowserOSNodeIdStore::GetTotalMemoryUsage());
++  stats.total_tabs = static_cast<int>(BrowserOSNodeIdStore::GetStoreCount());
++
++  return RespondNow(ArgumentList(
++      browser_os::GetNodeMappingStats::Results::Create(stats)));
++}
++
 +// BrowserOSChoosePathFunction implementation
 +
 +namespace {
@@ -1,9 +1,9 @@
 diff --git a/chrome/browser/extensions/api/browser_os/browser_os_api.h b/chrome/browser/extensions/api/browser_os/browser_os_api.h
 new file mode 100644
-index 0000000000000..2e2f5f0253f86
+index 0000000000000..f383f1fd69cc6
 --- /dev/null
 +++ b/chrome/browser/extensions/api/browser_os/browser_os_api.h
-@@ -0,0 +1,369 @@
+@@ -0,0 +1,584 @@
 +// Copyright 2024 The Chromium Authors
 +// Use of this source code is governed by a BSD-style license that can be
 +// found in the LICENSE file.
@@ -12,12 +12,22 @@ index 0000000000000..2e2f5f0253f86
 +#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_API_H_
 +
 +#include <cstdint>
++#include <optional>
++#include <string>
++#include <vector>
 +
 +#include "base/memory/weak_ptr.h"
 +#include "base/values.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_api_helpers.h"
 +#include "chrome/browser/extensions/api/browser_os/browser_os_api_utils.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_ax_serialization.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_change_detector.h"
 +#include "chrome/browser/extensions/api/browser_os/browser_os_content_processor.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_screenshot_diff.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_screenshot_highlights.h"
 +#include "chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_snapshot_stream.h"
 +#include "extensions/browser/extension_function.h"
 +#include "third_party/skia/include/core/SkBitmap.h"
 +#include "ui/shell_dialogs/select_file_dialog.h"
@@ -49,6 +59,15 @@ index 0000000000000..2e2f5f0253f86
 +
 + private:
 +  void OnAccessibilityTreeReceived(ui::AXTreeUpdate& tree_update);
++  void OnTreeSerialized(browser_os::AccessibilityTree result,
++                        SerializedAXTree serialized);
++
++  // Bounded-cost options; zero and null mean unbounded
++  size_t max_nodes_ = 0;
++  base::TimeTicks deadline_;
++  // Part of |deadline_| the renderer may spend acquiring the tree
++  base::TimeTicks acquisition_deadline_;
++  AXTreeFormat format_ = AXTreeFormat::kObject;
 +};
 +
 +class BrowserOSGetInteractiveSnapshotFunction : public ExtensionFunction {
@@ -58,6 +77,10 @@ index 0000000000000..2e2f5f0253f86
 +
 +  BrowserOSGetInteractiveSnapshotFunction();
 +
++  // Allocates the ID of a new snapshot; shared with executeActions, which
++  // can also return one
++  static uint32_t TakeSnapshotId() { return next_snapshot_id_++; }
++
 + protected:
 +  ~BrowserOSGetInteractiveSnapshotFunction() override;
 +
@@ -68,16 +91,58 @@ index 0000000000000..2e2f5f0253f86
 +  void OnAccessibilityTreeReceived(ui::AXTreeUpdate& tree_update);
 +  void OnSnapshotProcessed(SnapshotProcessingResult result);
 +  
++  // Responds with |snapshot|, or finishes the stream in streaming mode where
++  // the function has already responded
++  void RespondWithSnapshot(browser_os::InteractiveSnapshot snapshot);
++  
 +  // Counter for snapshot IDs
 +  static uint32_t next_snapshot_id_;
 +  
 +  // Tab ID for storing mappings
 +  int tab_id_ = -1;
 +  
++  // Whether the caller asked for an incremental snapshot
++  bool incremental_ = false;
++
++  // Generation of the tab's snapshot cache when the tree was requested
++  uint64_t cache_generation_ = 0;
++  
++  // Whether only nodes inside the viewport should be processed
++  bool viewport_only_ = false;
++  
++  // Bounded-cost options; zero and null mean unbounded
++  size_t max_nodes_ = 0;
++  base::TimeTicks deadline_;
++  // Part of |deadline_| the renderer may spend acquiring the tree
++  base::TimeTicks acquisition_deadline_;
++  // Set when the AX tree itself was cut off by the node budget or timeout
++  bool tree_truncated_ = false;
++  
++  // Streaming mode: receives the elements as batches finish
++  scoped_refptr<SnapshotStream> stream_;
++  uint32_t stream_snapshot_id_ = 0;
++  
 +  // Web contents for processing and drawing
 +  base::WeakPtr<content::WebContents> web_contents_;
 +};
 +
++class BrowserOSGetInteractiveSnapshotChunkFunction : public ExtensionFunction {
++ public:
++  DECLARE_EXTENSION_FUNCTION("browserOS.getInteractiveSnapshotChunk",
++                             BROWSER_OS_GETINTERACTIVESNAPSHOTCHUNK)
++
++  BrowserOSGetInteractiveSnapshotChunkFunction() = default;
++
++ protected:
++  ~BrowserOSGetInteractiveSnapshotChunkFunction() override = default;
++
++  // ExtensionFunction:
++  ResponseAction Run() override;
++
++ private:
++  void OnChunk(browser_os::SnapshotChunk chunk);
++};
++
 +class BrowserOSClickFunction : public ExtensionFunction {
 + public:
 +  DECLARE_EXTENSION_FUNCTION("browserOS.click", BROWSER_OS_CLICK)
@@ -89,6 +154,9 @@ index 0000000000000..2e2f5f0253f86
 +
 +  // ExtensionFunction:
 +  ResponseAction Run() override;
++
++ private:
++  void OnClickDone(const PageChanges& changes);
 +};
 +
 +class BrowserOSInputTextFunction : public ExtensionFunction {
@@ -102,6 +170,9 @@ index 0000000000000..2e2f5f0253f86
 +
 +  // ExtensionFunction:
 +  ResponseAction Run() override;
++
++ private:
++  void OnInputDone(const PageChanges& changes, TextInputMethod method);
 +};
 +
 +class BrowserOSClearFunction : public ExtensionFunction {
@@ -115,6 +186,9 @@ index 0000000000000..2e2f5f0253f86
 +
 +  // ExtensionFunction:
 +  ResponseAction Run() override;
++
++ private:
++  void OnClearDone(const PageChanges& changes);
 +};
 +
 +class BrowserOSGetPageLoadStatusFunction : public ExtensionFunction {
@@ -181,6 +255,9 @@ index 0000000000000..2e2f5f0253f86
 +
 +  // ExtensionFunction:
 +  ResponseAction Run() override;
++
++ private:
++  void OnKeyPressDone(const PageChanges& changes);
 +};
 +
 +class BrowserOSCaptureScreenshotFunction : public ExtensionFunction {
@@ -196,16 +273,68 @@ index 0000000000000..2e2f5f0253f86
 +  ResponseAction Run() override;
 +  
 + private:
-+  void DrawHighlightsAndCapture();
 +  void CaptureScreenshotNow();
 +  void OnScreenshotCaptured(const SkBitmap& bitmap);
++  void OnScreenshotEncoded(std::optional<base::Value> screenshot);
++  void OnScreenshotDiffed(int sequence, ScreenshotDiffOutput output);
 +  
-+  // Store web contents and tab id for highlight operations
++  // Store web contents for highlight operations
 +  base::WeakPtr<content::WebContents> web_contents_;
-+  int tab_id_ = -1;
 +  gfx::Size target_size_;
++  // Region of the view to read back in DIPs, or empty for all of it
++  gfx::Rect source_rect_;
 +  bool show_highlights_ = false;
 +  bool use_exact_dimensions_ = false;
++  ScreenshotEncoding encoding_;
++  // Return only the tiles that changed since the tab's last diff capture
++  bool diff_ = false;
++  // Drawn onto the captured bitmap when showHighlights is set
++  ScreenshotHighlights highlights_;
++};
++
++class BrowserOSStartScreencastFunction : public ExtensionFunction {
++ public:
++  DECLARE_EXTENSION_FUNCTION("browserOS.startScreencast",
++                             BROWSER_OS_STARTSCREENCAST)
++
++  BrowserOSStartScreencastFunction() = default;
++
++ protected:
++  ~BrowserOSStartScreencastFunction() override = default;
++
++  // ExtensionFunction:
++  ResponseAction Run() override;
++};
++
++class BrowserOSReadScreencastFrameFunction : public ExtensionFunction {
++ public:
++  DECLARE_EXTENSION_FUNCTION("browserOS.readScreencastFrame",
++                             BROWSER_OS_READSCREENCASTFRAME)
++
++  BrowserOSReadScreencastFrameFunction() = default;
++
++ protected:
++  ~BrowserOSReadScreencastFrameFunction() override = default;
++
++  // ExtensionFunction:
++  ResponseAction Run() override;
++
++ private:
++  void OnFrame(browser_os::ScreencastFrame frame);
++};
++
++class BrowserOSStopScreencastFunction : public ExtensionFunction {
++ public:
++  DECLARE_EXTENSION_FUNCTION("browserOS.stopScreencast",
++                             BROWSER_OS_STOPSCREENCAST)
++
++  BrowserOSStopScreencastFunction() = default;
++
++ protected:
++  ~BrowserOSStopScreencastFunction() override = default;
++
++  // ExtensionFunction:
++  ResponseAction Run() override;
 +};
 +
 +class BrowserOSGetSnapshotFunction : public ExtensionFunction {
@@ -222,6 +351,10 @@ index 0000000000000..2e2f5f0253f86
 +
 + private:
 +  void OnAccessibilityTreeReceived(ui::AXTreeUpdate& tree_update);
++  void OnContentExtracted(ContentResult content);
++
++  ContentOptions content_options_;
++  base::Time start_time_;
 +};
 +
 +// Settings API functions
@@ -330,6 +463,9 @@ index 0000000000000..2e2f5f0253f86
 +
 +  // ExtensionFunction:
 +  ResponseAction Run() override;
++
++ private:
++  void OnClickDone(const PageChanges& changes);
 +};
 +
 +class BrowserOSTypeAtCoordinatesFunction : public ExtensionFunction {
@@ -343,6 +479,85 @@ index 0000000000000..2e2f5f0253f86
 +
 +  // ExtensionFunction:
 +  ResponseAction Run() override;
++
++ private:
++  void OnTypeDone(const PageChanges& changes, TextInputMethod method);
++};
++
++class BrowserOSExecuteActionsFunction : public ExtensionFunction {
++ public:
++  DECLARE_EXTENSION_FUNCTION("browserOS.executeActions",
++                             BROWSER_OS_EXECUTEACTIONS)
++
++  // Largest batch a single call accepts
++  static constexpr size_t kMaxActions = 100;
++
++  BrowserOSExecuteActionsFunction();
++
++ protected:
++  ~BrowserOSExecuteActionsFunction() override;
++
++  // ExtensionFunction:
++  ResponseAction Run() override;
++
++ private:
++  // Runs the next action, or finishes once every action has run
++  void RunNextAction();
++  // Runs the next action from a fresh task. Actions can complete
++  // synchronously, so calling RunNextAction() directly would nest one stack
++  // frame per action.
++  void PostNextAction();
++  // Records the result of the current action and moves on
++  void OnActionDetected(const PageChanges& changes);
++  void OnTextActionDetected(const PageChanges& changes,
++                            TextInputMethod method);
++  void OnActionDispatched();
++  void OnActionFailed(const std::string& error);
++  void Finish();
++  void OnAccessibilityTreeReceived(ui::AXTreeUpdate& tree_update);
++  void OnSnapshotProcessed(SnapshotProcessingResult result);
++
++  std::vector<browser_os::Action> actions_;
++  size_t next_action_ = 0;
++  // Whether every action is detected, or only the last one
++  bool detect_each_ = true;
++  bool stop_on_error_ = true;
++  bool snapshot_ = false;
++
++  int tab_id_ = -1;
++  base::WeakPtr<content::WebContents> web_contents_;
++  browser_os::ExecuteActionsResult result_;
++};
++
++class BrowserOSWaitForSettleFunction : public ExtensionFunction {
++ public:
++  DECLARE_EXTENSION_FUNCTION("browserOS.waitForSettle",
++                             BROWSER_OS_WAITFORSETTLE)
++
++  BrowserOSWaitForSettleFunction() = default;
++
++ protected:
++  ~BrowserOSWaitForSettleFunction() override = default;
++
++  // ExtensionFunction:
++  ResponseAction Run() override;
++
++ private:
++  void OnSettled(const PageChanges& changes);
++};
++
++class BrowserOSGetNodeMappingStatsFunction : public ExtensionFunction {
++ public:
++  DECLARE_EXTENSION_FUNCTION("browserOS.getNodeMappingStats",
++                             BROWSER_OS_GETNODEMAPPINGSTATS)
++
++  BrowserOSGetNodeMappingStatsFunction() = default;
++
++ protected:
++  ~BrowserOSGetNodeMappingStatsFunction() override = default;
++
++  // ExtensionFunction:
++  ResponseAction Run() override;
 +};
 +
 +class BrowserOSChoosePathFunction : public ExtensionFunction,
@@ -1,19 +1,30 @@
 diff --git a/chrome/browser/extensions/api/browser_os/browser_os_api_helpers.cc b/chrome/browser/extensions/api/browser_os/browser_os_api_helpers.cc
 new file mode 100644
-index 0000000000000..f40a2424641e1
+index 0000000000000..12a362101305e
 --- /dev/null
 +++ b/chrome/browser/extensions/api/browser_os/browser_os_api_helpers.cc
-@@ -0,0 +1,1073 @@
+@@ -0,0 +1,1279 @@
 +// Copyright 2024 The Chromium Authors
 +// Use of this source code is governed by a BSD-style license that can be
 +// found in the LICENSE file.
 +
 +#include "chrome/browser/extensions/api/browser_os/browser_os_api_helpers.h"
 +
++#include <functional>
++#include <iterator>
++#include <optional>
++
++#include "base/functional/bind.h"
++#include "base/json/string_escape.h"
++#include "base/memory/weak_ptr.h"
++#include "base/notreached.h"
 +#include "base/strings/string_number_conversions.h"
 +#include "base/strings/stringprintf.h"
++#include "base/strings/utf_string_conversion_utils.h"
 +#include "base/strings/utf_string_conversions.h"
 +#include "base/task/sequenced_task_runner.h"
++#include "base/time/time.h"
++#include "base/values.h"
 +#include "chrome/browser/extensions/api/browser_os/browser_os_api_utils.h"
 +#include "chrome/browser/extensions/api/browser_os/browser_os_change_detector.h"
 +#include "components/input/native_web_keyboard_event.h"
@@ -42,6 +53,391 @@ index 0000000000000..f40a2424641e1
 +namespace extensions {
 +namespace api {
 +
++namespace {
++
++// How long focus gets to land before typing. These are posted delays, not
++// sleeps, so the UI thread and other tabs keep running while an action waits.
++constexpr base::TimeDelta kFocusSettleDelay = base::Milliseconds(50);
++constexpr base::TimeDelta kClickFocusDelay = base::Milliseconds(100);
++
++// A scroll is done once the compositor has stopped producing frames for this
++// long, up to the max wait
++constexpr base::TimeDelta kScrollQuietPeriod = base::Milliseconds(50);
++constexpr base::TimeDelta kScrollMaxWait = base::Milliseconds(500);
++
++void PostAfter(base::TimeDelta delay, base::OnceClosure task) {
++  base::SequencedTaskRunner::GetCurrentDefault()->PostDelayedTask(
++      FROM_HERE, std::move(task), delay);
++}
++
++// Runs |task| once a scroll started on |web_contents| has settled
++void AfterScrollSettles(content::WebContents* web_contents,
++                        base::OnceClosure task) {
++  SettleOptions options;
++  options.quiet_period = kScrollQuietPeriod;
++  options.max_wait = kScrollMaxWait;
++  BrowserOSChangeDetector::WaitForSettle(
++      web_contents, options,
++      base::BindOnce(
++          [](base::OnceClosure task, const PageChanges& changes) {
++            std::move(task).Run();
++          },
++          std::move(task)));
++}
++
++void LogAndReport(const char* action,
++                  DetectionCallback callback,
++                  const PageChanges& changes) {
++  LOG(INFO) << "[browseros] " << action << " result: "
++            << (changes.any() ? "changed" : "no change")
++            << (changes.settled ? "" : " (page still busy)") << " after "
++            << changes.elapsed.InMilliseconds() << " ms";
++  std::move(callback).Run(changes);
++}
++
++// Click steps: coordinate click, then HTML click if the page did not react
++
++void OnPointClickResult(base::WeakPtr<content::WebContents> web_contents,
++                        NodeInfo node_info,
++                        DetectionCallback callback,
++                        const PageChanges& changes) {
++  if (changes.any() || !web_contents) {
++    LogAndReport("Click", std::move(callback), changes);
++    return;
++  }
++
++  LOG(INFO) << "[browseros] No change from coordinate click, trying HTML click";
++  content::WebContents* contents = web_contents.get();
++  BrowserOSChangeDetector::ExecuteWithDetectionAsync(
++      contents,
++      [contents, node_info]() { HtmlClick(contents, node_info); },
++      base::BindOnce(&LogAndReport, "Click", std::move(callback)),
++      base::Milliseconds(200));
++}
++
++void ClickWithFallback(base::WeakPtr<content::WebContents> web_contents,
++                       NodeInfo node_info,
++                       DetectionCallback callback) {
++  if (!web_contents) {
++    std::move(callback).Run(PageChanges());
++    return;
++  }
++
++  content::WebContents* contents = web_contents.get();
++  gfx::PointF click_point = GetNodeCenterPoint(contents, node_info);
++  BrowserOSChangeDetector::ExecuteWithDetectionAsync(
++      contents,
++      [contents, click_point]() { PointClick(contents, click_point); },
++      base::BindOnce(&OnPointClickResult, web_contents, std::move(node_info),
++                     std::move(callback)),
++      base::Milliseconds(300));
++}
++
++// Type steps: the bulk methods first, each inserting the whole text at once,
++// and per-character key events only for fields that ignore all of them
++constexpr TextInputMethod kTextInputOrder[] = {
++    TextInputMethod::kIme,
++    TextInputMethod::kSetValue,
++    TextInputMethod::kScript,
++    TextInputMethod::kKeystrokes,
++};
++
++const char* TextInputMethodName(TextInputMethod method) {
++  switch (method) {
++    case TextInputMethod::kNone:
++      return "none";
++    case TextInputMethod::kIme:
++      return "IME commit";
++    case TextInputMethod::kSetValue:
++      return "accessibility SetValue";
++    case TextInputMethod::kScript:
++      return "script";
++    case TextInputMethod::kKeystrokes:
++      return "keystrokes";
++  }
++  NOTREACHED();
++}
++
++// Sets the value of the focused input, textarea or contenteditable element
++// and fires input and change events
++void FocusedElementScriptType(content::WebContents* web_contents,
++                              const std::string& text) {
++  content::RenderFrameHost* rfh = web_contents->GetPrimaryMainFrame();
++  if (!rfh)
++    return;
++
++  std::string js_code = base::StringPrintf(R"(
++    (function() {
++      var text = %s;
++      var focused = document.activeElement;
++      if (focused && (focused.tagName === 'INPUT' ||
++                     focused.tagName === 'TEXTAREA' ||
++                     focused.isContentEditable)) {
++        if (focused.isContentEditable) {
++          focused.textContent = text;
++        } else {
++          focused.value = text;
++        }
++        // Trigger input event
++        focused.dispatchEvent(new Event('input', { bubbles: true }));
++        focused.dispatchEvent(new Event('change', { bubbles: true }));
++        return true;
++      }
++      return false;
++    })();
++  )", base::GetQuotedJSONString(text).c_str());
++
++  rfh->ExecuteJavaScriptForTests(
++      base::UTF8ToUTF16(js_code),
++      base::NullCallback(),
++      false);
++}
++
++using FocusedValue = std::optional<std::string>;
++
++// Reads the value of the focused input, textarea or contenteditable element,
++// or nullopt if nothing readable has focus
++void ReadFocusedValue(base::WeakPtr<content::WebContents> web_contents,
++                      base::OnceCallback<void(FocusedValue)> callback) {
++  content::RenderFrameHost* rfh =
++      web_contents ? web_contents->GetPrimaryMainFrame() : nullptr;
++  if (!rfh) {
++    std::move(callback).Run(std::nullopt);
++    return;
++  }
++  rfh->ExecuteJavaScriptForTests(
++      u"(function() {"
++      u"  var focused = document.activeElement;"
++      u"  if (!focused) return null;"
++      u"  if (focused.isContentEditable) return focused.textContent;"
++      u"  return typeof focused.value === 'string' ? focused.value : null;"
++      u"})();",
++      base::BindOnce(
++          [](base::OnceCallback<void(FocusedValue)> callback,
++             base::Value value) {
++            std::move(callback).Run(value.is_string()
++                                        ? FocusedValue(value.TakeString())
++                                        : std::nullopt);
++          },
++          std::move(callback)),
++      /*honor_js_content_settings=*/false);
++}
++
++void TryTextInput(base::WeakPtr<content::WebContents> web_contents,
++                  std::optional<NodeInfo> node_info,
++                  std::string text,
++                  FocusedValue initial_value,
++                  size_t attempt,
++                  TypeCallback callback);
++
++void OnFocusedValueRead(base::WeakPtr<content::WebContents> web_contents,
++                        std::optional<NodeInfo> node_info,
++                        std::string text,
++                        FocusedValue initial_value,
++                        size_t attempt,
++                        PageChanges changes,
++                        TypeCallback callback,
++                        FocusedValue value);
++
++void OnTextInputResult(base::WeakPtr<content::WebContents> web_contents,
++                       std::optional<NodeInfo> node_info,
++                       std::string text,
++                       FocusedValue initial_value,
++                       size_t attempt,
++                       TypeCallback callback,
++                       const PageChanges& changes) {
++  const TextInputMethod method = kTextInputOrder[attempt];
++  if (changes.any() || !web_contents ||
++      attempt + 1 == std::size(kTextInputOrder)) {
++    LOG(INFO) << "[browseros] Type result: "
++              << (changes.any() ? "changed" : "no change") << " via "
++              << TextInputMethodName(method) << " (" << text.size()
++              << " bytes) after " << changes.elapsed.InMilliseconds()
++              << " ms";
++    std::move(callback).Run(changes,
++                            changes.any() ? method : TextInputMethod::kNone);
++    return;
++  }
++
++  // A method can insert the text without the page reacting within the
++  // change timeout, e.g. a slow IME commit, and the next method would then
++  // overwrite or double it. Check the field before moving on.
++  ReadFocusedValue(
++      web_contents,
++      base::BindOnce(&OnFocusedValueRead, web_contents, std::move(node_info),
++                     std::move(text), std::move(initial_value), attempt,
++                     changes, std::move(callback)));
++}
++
++void OnFocusedValueRead(base::WeakPtr<content::WebContents> web_contents,
++                        std::optional<NodeInfo> node_info,
++                        std::string text,
++                        FocusedValue initial_value,
++                        size_t attempt,
++                        PageChanges changes,
++                        TypeCallback callback,
++                        FocusedValue value) {
++  const TextInputMethod method = kTextInputOrder[attempt];
++  // Only a value that changed counts: a field that already held the text,
++  // prefilled or from an earlier attempt, says nothing about this one
++  if (!text.empty() && value && value != initial_value &&
++      value->find(text) != std::string::npos) {
++    LOG(INFO) << "[browseros] Text entered via " << TextInputMethodName(method)
++              << " without a detected change, skipping the other methods";
++    // The field changed even though the page did not react in time
++    changes.dom_changed = true;
++    std::move(callback).Run(changes, method);
++    return;
++  }
++
++  const TextInputMethod next = kTextInputOrder[attempt + 1];
++  LOG(INFO) << "[browseros] No change from " << TextInputMethodName(method)
++            << ", trying " << TextInputMethodName(next);
++
++  if (next == TextInputMethod::kKeystrokes && node_info && web_contents) {
++    // Key events go to the focused element, which a failed script may have
++    // moved, so focus the node again first
++    AccessibilityFocus(web_contents.get(), *node_info);
++    PostAfter(kFocusSettleDelay,
++              base::BindOnce(&TryTextInput, web_contents,
++                             std::move(node_info), std::move(text),
++                             std::move(initial_value), attempt + 1,
++                             std::move(callback)));
++    return;
++  }
++  TryTextInput(web_contents, std::move(node_info), std::move(text),
++               std::move(initial_value), attempt + 1, std::move(callback));
++}
++
++// Types with kTextInputOrder[attempt], moving on to the next method while
++// the page does not react and the focused value has not changed from
++// |initial_value|. Without |node_info| the text goes to whatever has focus,
++// and SetValue, which needs a node, is skipped.
++void TryTextInput(base::WeakPtr<content::WebContents> web_contents,
++                  std::optional<NodeInfo> node_info,
++                  std::string text,
++                  FocusedValue initial_value,
++                  size_t attempt,
++                  TypeCallback callback) {
++  if (!web_contents) {
++    std::move(callback).Run(PageChanges(), TextInputMethod::kNone);
++    return;
++  }
++  if (kTextInputOrder[attempt] == TextInputMethod::kSetValue && !node_info) {
++    ++attempt;
++  }
++
++  content::WebContents* contents = web_contents.get();
++  std::function<void()> action;
++  switch (kTextInputOrder[attempt]) {
++    case TextInputMethod::kIme:
++      action = [contents, text]() { NativeType(contents, text); };
++      break;
++    case TextInputMethod::kSetValue:
++      action = [contents, node = *node_info, text]() {
++        AccessibilitySetValue(contents, node, text);
++      };
++      break;
++    case TextInputMethod::kScript:
++      if (node_info) {
++        action = [contents, node = *node_info, text]() {
++          JavaScriptType(contents, node, text);
++        };
++      } else {
++        action = [contents, text]() {
++          FocusedElementScriptType(contents, text);
++        };
++      }
++      break;
++    case TextInputMethod::kKeystrokes:
++      action = [contents, text]() { KeystrokeType(contents, text); };
++      break;
++    case TextInputMethod::kNone:
++      NOTREACHED();
++  }
++
++  BrowserOSChangeDetector::ExecuteWithDetectionAsync(
++      contents, std::move(action),
++      base::BindOnce(&OnTextInputResult, web_contents, std::move(node_info),
++                     text, std::move(initial_value), attempt,
++                     std::move(callback)),
++      attempt == 0 ? base::Milliseconds(300) : base::Milliseconds(200));
++}
++
++// Reads the focused value once, then runs the methods in kTextInputOrder.
++// Call once the target has focus.
++void StartTextInput(base::WeakPtr<content::WebContents> web_contents,
++                    std::optional<NodeInfo> node_info,
++                    std::string text,
++                    TypeCallback callback) {
++  ReadFocusedValue(
++      web_contents,
++      base::BindOnce(
++          [](base::WeakPtr<content::WebContents> web_contents,
++             std::optional<NodeInfo> node_info, std::string text,
++             TypeCallback callback, FocusedValue initial_value) {
++            TryTextInput(web_contents, std::move(node_info), std::move(text),
++                         std::move(initial_value), 0, std::move(callback));
++          },
++          web_contents, std::move(node_info), std::move(text),
++          std::move(callback)));
++}
++
++void FocusAndType(base::WeakPtr<content::WebContents> web_contents,
++                  NodeInfo node_info,
++                  std::string text,
++                  TypeCallback callback) {
++  if (!web_contents) {
++    std::move(callback).Run(PageChanges(), TextInputMethod::kNone);
++    return;
++  }
++
++  // First ensure the element is focused using accessibility
++  LOG(INFO) << "[browseros] Focusing element for typing";
++  AccessibilityFocus(web_contents.get(), node_info);
++  PostAfter(kFocusSettleDelay,
++            base::BindOnce(&StartTextInput, web_contents,
++                           std::make_optional(std::move(node_info)),
++                           std::move(text), std::move(callback)));
++}
++
++// Dispatch-only steps of ClickNode, TypeIntoNode and TypeAtPoint
++
++void ClickNodeCenter(base::WeakPtr<content::WebContents> web_contents,
++                     NodeInfo node_info,
++                     base::OnceClosure done) {
++  if (web_contents) {
++    PointClick(web_contents.get(),
++               GetNodeCenterPoint(web_contents.get(), node_info));
++  }
++  std::move(done).Run();
++}
++
++void TypeText(base::WeakPtr<content::WebContents> web_contents,
++              std::string text,
++              base::OnceClosure done) {
++  if (web_contents) {
++    NativeType(web_contents.get(), text);
++  }
++  std::move(done).Run();
++}
++
++void FocusThenType(base::WeakPtr<content::WebContents> web_contents,
++                   NodeInfo node_info,
++                   std::string text,
++                   base::OnceClosure done) {
++  if (!web_contents) {
++    std::move(done).Run();
++    return;
++  }
++  AccessibilityFocus(web_contents.get(), node_info);
++  PostAfter(kFocusSettleDelay,
++            base::BindOnce(&TypeText, web_contents, std::move(text),
++                           std::move(done)));
++}
++
++}  // namespace
++
 +// Compute CSS->widget scale matching DevTools InputHandler::ScaleFactor.
 +// We intentionally exclude device scale factor (DSF). Widget coordinates
 +// used by input are in DIPs; DSF is handled by the compositor. We also set
@@ -141,10 +537,11 @@ index 0000000000000..f40a2424641e1
 +  std::u16string js_code = u"(function() {";
 +  
 +  // Try to find element by ID first
-+  auto id_it = node_info.attributes.find("id");
-+  if (id_it != node_info.attributes.end() && !id_it->second.empty()) {
++  const std::string* id_value =
++      node_info.attributes.Find(NodeAttribute::kId);
++  if (id_value && !id_value->empty()) {
 +    js_code += u"  var element = document.getElementById('" + 
-+               base::UTF8ToUTF16(id_it->second) + u"');";
++               base::UTF8ToUTF16(*id_value) + u"');";
 +    js_code += u"  if (element) {";
 +    js_code += u"    element.click();";
 +    js_code += u"    return 'clicked by id';";
@@ -152,13 +549,15 @@ index 0000000000000..f40a2424641e1
 +  }
 +  
 +  // Try to find by class and tag combination
-+  auto class_it = node_info.attributes.find("class");
-+  auto tag_it = node_info.attributes.find("html-tag");
++  const std::string* class_value =
++      node_info.attributes.Find(NodeAttribute::kClass);
++  const std::string* tag_value =
++      node_info.attributes.Find(NodeAttribute::kHtmlTag);
 +  
-+  if (class_it != node_info.attributes.end() && !class_it->second.empty() &&
-+      tag_it != node_info.attributes.end() && !tag_it->second.empty()) {
++  if (class_value && !class_value->empty() &&
++      tag_value && !tag_value->empty()) {
 +    // Split class names and create selector
-+    std::string class_selector = "." + class_it->second;
++    std::string class_selector = "." + *class_value;
 +    // Replace spaces with dots for multiple classes
 +    for (size_t i = 0; i < class_selector.length(); ++i) {
 +      if (class_selector[i] == ' ') {
@@ -167,7 +566,7 @@ index 0000000000000..f40a2424641e1
 +    }
 +    
 +    js_code += u"  var elements = document.querySelectorAll('" + 
-+               base::UTF8ToUTF16(tag_it->second + class_selector) + u"');";
++               base::UTF8ToUTF16(*tag_value + class_selector) + u"');";
 +    js_code += u"  if (elements.length > 0) {";
 +    js_code += u"    elements[0].click();";
 +    js_code += u"    return 'clicked by class and tag';";
@@ -175,9 +574,9 @@ index 0000000000000..f40a2424641e1
 +  }
 +  
 +  // Fallback: try just by tag name if available
-+  if (tag_it != node_info.attributes.end() && !tag_it->second.empty()) {
++  if (tag_value && !tag_value->empty()) {
 +    js_code += u"  var elements = document.getElementsByTagName('" + 
-+               base::UTF8ToUTF16(tag_it->second) + u"');";
++               base::UTF8ToUTF16(*tag_value) + u"');";
 +    js_code += u"  if (elements.length > 0) {";
 +    js_code += u"    elements[0].click();";
 +    js_code += u"    return 'clicked by tag';";
@@ -205,10 +604,11 @@ index 0000000000000..f40a2424641e1
 +  std::u16string js_code = u"(function() {";
 +  
 +  // Try to find element by ID first
-+  auto id_it = node_info.attributes.find("id");
-+  if (id_it != node_info.attributes.end() && !id_it->second.empty()) {
++  const std::string* id_value =
++      node_info.attributes.Find(NodeAttribute::kId);
++  if (id_value && !id_value->empty()) {
 +    js_code += u"  var element = document.getElementById('" + 
-+               base::UTF8ToUTF16(id_it->second) + u"');";
++               base::UTF8ToUTF16(*id_value) + u"');";
 +    js_code += u"  if (element) {";
 +    js_code += u"    element.focus();";
 +    js_code += u"    if (element.select) element.select();";  // Select text if possible
@@ -217,13 +617,15 @@ index 0000000000000..f40a2424641e1
 +  }
 +  
 +  // Try to find by class and tag combination
-+  auto class_it = node_info.attributes.find("class");
-+  auto tag_it = node_info.attributes.find("html-tag");
++  const std::string* class_value =
++      node_info.attributes.Find(NodeAttribute::kClass);
++  const std::string* tag_value =
++      node_info.attributes.Find(NodeAttribute::kHtmlTag);
 +  
-+  if (class_it != node_info.attributes.end() && !class_it->second.empty() &&
-+      tag_it != node_info.attributes.end() && !tag_it->second.empty()) {
++  if (class_value && !class_value->empty() &&
++      tag_value && !tag_value->empty()) {
 +    // Split class names and create selector
-+    std::string class_selector = "." + class_it->second;
++    std::string class_selector = "." + *class_value;
 +    // Replace spaces with dots for multiple classes
 +    for (size_t i = 0; i < class_selector.length(); ++i) {
 +      if (class_selector[i] == ' ') {
@@ -232,7 +634,7 @@ index 0000000000000..f40a2424641e1
 +    }
 +    
 +    js_code += u"  var elements = document.querySelectorAll('" + 
-+               base::UTF8ToUTF16(tag_it->second + class_selector) + u"');";
++               base::UTF8ToUTF16(*tag_value + class_selector) + u"');";
 +    js_code += u"  if (elements.length > 0) {";
 +    js_code += u"    elements[0].focus();";
 +    js_code += u"    if (elements[0].select) elements[0].select();";
@@ -241,9 +643,9 @@ index 0000000000000..f40a2424641e1
 +  }
 +  
 +  // Fallback: try just by tag name if available
-+  if (tag_it != node_info.attributes.end() && !tag_it->second.empty()) {
++  if (tag_value && !tag_value->empty()) {
 +    js_code += u"  var elements = document.getElementsByTagName('" + 
-+               base::UTF8ToUTF16(tag_it->second) + u"');";
++               base::UTF8ToUTF16(*tag_value) + u"');";
 +    js_code += u"  if (elements.length > 0) {";
 +    js_code += u"    elements[0].focus();";
 +    js_code += u"    if (elements[0].select) elements[0].select();";
@@ -323,6 +725,21 @@ index 0000000000000..f40a2424641e1
 +  rwh->ForwardWheelEvent(wheel_event);
 +}
 +
++// Helper to scroll by about one page
++bool ScrollPage(content::WebContents* web_contents, bool down) {
++  content::RenderFrameHost* rfh = web_contents->GetPrimaryMainFrame();
++  if (!rfh)
++    return false;
++
++  content::RenderWidgetHost* rwh = rfh->GetRenderWidgetHost();
++  if (!rwh || !rwh->GetView())
++    return false;
++
++  int scroll_amount = rwh->GetView()->GetViewBounds().height() * 0.9;
++  Scroll(web_contents, 0, down ? scroll_amount : -scroll_amount, true);
++  return true;
++}
++
 +// Helper to send special key events
 +void KeyPress(content::WebContents* web_contents,
 +                    const std::string& key) {
@@ -444,6 +861,15 @@ index 0000000000000..f40a2424641e1
 +  }
 +}
 +
++bool IsSupportedKey(const std::string& key) {
++  // A simple check instead of std::set to avoid an exit-time destructor
++  return key == "Enter" || key == "Delete" || key == "Backspace" ||
++         key == "Tab" || key == "Escape" || key == "ArrowUp" ||
++         key == "ArrowDown" || key == "ArrowLeft" || key == "ArrowRight" ||
++         key == "Home" || key == "End" || key == "PageUp" ||
++         key == "PageDown";
++}
++
 +// Helper to type text into a focused element using native IME
 +void NativeType(content::WebContents* web_contents,
 +                const std::string& text) {
@@ -473,6 +899,54 @@ index 0000000000000..f40a2424641e1
 +                      0);  // relative_cursor_pos = 0 means after the text
 +}
 +
++// Helper to type text as key down, char and key up events per character
++void KeystrokeType(content::WebContents* web_contents,
++                   const std::string& text) {
++  content::RenderFrameHost* rfh = web_contents->GetPrimaryMainFrame();
++  if (!rfh)
++    return;
++
++  content::RenderWidgetHost* rwh = rfh->GetRenderWidgetHost();
++  if (!rwh)
++    return;
++
++  for (size_t i = 0; i < text.size(); ++i) {
++    base_icu::UChar32 code_point;
++    if (!base::ReadUnicodeCharacter(text.data(), text.size(), &i,
++                                    &code_point)) {
++      continue;
++    }
++
++    // Newlines are typed as Enter, like a user would
++    const bool is_newline = code_point == '\n';
++    std::u16string char_text;
++    base::WriteUnicodeCharacter(is_newline ? '\r' : code_point, &char_text);
++    const ui::KeyboardCode key_code =
++        is_newline ? ui::VKEY_RETURN : ui::VKEY_UNKNOWN;
++    const ui::DomKey dom_key =
++        is_newline ? ui::DomKey::ENTER : ui::DomKey::FromCharacter(code_point);
++
++    for (auto type : {blink::WebInputEvent::Type::kRawKeyDown,
++                      blink::WebInputEvent::Type::kChar,
++                      blink::WebInputEvent::Type::kKeyUp}) {
++      input::NativeWebKeyboardEvent event(type,
++                                          blink::WebInputEvent::kNoModifiers,
++                                          ui::EventTimeForNow());
++      event.windows_key_code = key_code;
++      event.native_key_code = key_code;
++      event.dom_key = static_cast<int>(dom_key);
++      if (type == blink::WebInputEvent::Type::kChar) {
++        // Characters outside the BMP take two UTF-16 units
++        for (size_t unit = 0; unit < char_text.size(); ++unit) {
++          event.text[unit] = char_text[unit];
++          event.unmodified_text[unit] = char_text[unit];
++        }
++      }
++      rwh->ForwardKeyboardEvent(event);
++    }
++  }
++}
++
 +// Helper to set text value using JavaScript
 +void JavaScriptType(content::WebContents* web_contents,
 +                    const NodeInfo& node_info,
@@ -481,64 +955,61 @@ index 0000000000000..f40a2424641e1
 +  if (!rfh)
 +    return;
 +  
-+  // Build JavaScript to find element and set its value
-+  std::u16string js_code = u"(function() {";
-+  std::u16string escaped_text = base::UTF8ToUTF16(text);
-+  
-+  // Escape quotes in the text
-+  for (size_t i = 0; i < escaped_text.length(); ++i) {
-+    if (escaped_text[i] == u'\'') {
-+      escaped_text.insert(i, u"\\");
-+      i++;
-+    }
-+  }
-+  
++  // Build JavaScript to find element and set its value. Text and selectors
++  // go in as JSON string literals, escaped in one linear pass.
++  const std::string quoted_text = base::GetQuotedJSONString(text);
++  std::string js_code = "(function() {";
++  js_code += "  var text = " + quoted_text + ";";
++
 +  // Try to find element by ID first
-+  auto id_it = node_info.attributes.find("id");
-+  if (id_it != node_info.attributes.end() && !id_it->second.empty()) {
-+    js_code += u"  var element = document.getElementById('" + 
-+               base::UTF8ToUTF16(id_it->second) + u"');";
-+    js_code += u"  if (element) {";
-+    js_code += u"    element.value = '" + escaped_text + u"';";
-+    js_code += u"    element.dispatchEvent(new Event('input', {bubbles: true}));";
-+    js_code += u"    element.dispatchEvent(new Event('change', {bubbles: true}));";
-+    js_code += u"    return 'set by id';";
-+    js_code += u"  }";
++  const std::string* id_value =
++      node_info.attributes.Find(NodeAttribute::kId);
++  if (id_value && !id_value->empty()) {
++    js_code += "  var element = document.getElementById(" +
++               base::GetQuotedJSONString(*id_value) + ");";
++    js_code += "  if (element) {";
++    js_code += "    element.value = text;";
++    js_code += "    element.dispatchEvent(new Event('input', {bubbles: true}));";
++    js_code += "    element.dispatchEvent(new Event('change', {bubbles: true}));";
++    js_code += "    return 'set by id';";
++    js_code += "  }";
 +  }
 +  
 +  // Try to find by class and tag combination
-+  auto class_it = node_info.attributes.find("class");
-+  auto tag_it = node_info.attributes.find("html-tag");
-+  
-+  if (class_it != node_info.attributes.end() && !class_it->second.empty() &&
-+      tag_it != node_info.attributes.end() && !tag_it->second.empty()) {
-+    std::string class_selector = "." + class_it->second;
++  const std::string* class_value =
++      node_info.attributes.Find(NodeAttribute::kClass);
++  const std::string* tag_value =
++      node_info.attributes.Find(NodeAttribute::kHtmlTag);
++  
++  if (class_value && !class_value->empty() &&
++      tag_value && !tag_value->empty()) {
++    std::string class_selector = "." + *class_value;
 +    for (size_t i = 0; i < class_selector.length(); ++i) {
 +      if (class_selector[i] == ' ') {
 +        class_selector[i] = '.';
 +      }
 +    }
 +    
-+    js_code += u"  var elements = document.querySelectorAll('" + 
-+               base::UTF8ToUTF16(tag_it->second + class_selector) + u"');";
-+    js_code += u"  if (elements.length > 0) {";
-+    js_code += u"    if (elements[0].value !== undefined) {";
-+    js_code += u"      elements[0].value = '" + escaped_text + u"';";
-+    js_code += u"    } else if (elements[0].isContentEditable) {";
-+    js_code += u"      elements[0].textContent = '" + escaped_text + u"';";
-+    js_code += u"    }";
-+    js_code += u"    elements[0].dispatchEvent(new Event('input', {bubbles: true}));";
-+    js_code += u"    elements[0].dispatchEvent(new Event('change', {bubbles: true}));";
-+    js_code += u"    return 'set by class and tag';";
-+    js_code += u"  }";
++    js_code += "  var elements = document.querySelectorAll(" +
++               base::GetQuotedJSONString(*tag_value + class_selector) + ");";
++    js_code += "  if (elements.length > 0) {";
++    js_code += "    if (elements[0].value !== undefined) {";
++    js_code += "      elements[0].value = text;";
++    js_code += "    } else if (elements[0].isContentEditable) {";
++    js_code += "      elements[0].textContent = text;";
++    js_code += "    }";
++    js_code += "    elements[0].dispatchEvent(new Event('input', {bubbles: true}));";
++    js_code += "    elements[0].dispatchEvent(new Event('change', {bubbles: true}));";
++    js_code += "    return 'set by class and tag';";
++    js_code += "  }";
 +  }
 +  
-+  js_code += u"  return 'no element found';";
-+  js_code += u"})();";
++  js_code += "  return 'no element found';";
++  js_code += "})();";
 +  
 +  // Execute the JavaScript
 +  rfh->ExecuteJavaScriptForTests(
-+      js_code,
++      base::UTF8ToUTF16(js_code),
 +      base::NullCallback(),
 +      /*honor_js_content_settings=*/false);
 +}
@@ -620,67 +1091,26 @@ index 0000000000000..f40a2424641e1
 +}
 +
 +// Helper to perform a click with change detection and retrying
-+bool ClickWithDetection(content::WebContents* web_contents,
-+                        const NodeInfo& node_info) {
++void ClickWithDetection(content::WebContents* web_contents,
++                        const NodeInfo& node_info,
++                        DetectionCallback callback) {
 +  // Check if node is out of viewport and needs scrolling
-+  auto viewport_it = node_info.attributes.find("in_viewport");
-+  bool is_out_of_viewport = (viewport_it != node_info.attributes.end() && 
-+                              viewport_it->second == "false");
-+  
++  bool is_out_of_viewport = !node_info.attributes.in_viewport().value_or(true);
++
 +  if (is_out_of_viewport) {
 +    LOG(INFO) << "[browseros] Node is out of viewport, scrolling to make visible";
 +    AccessibilityScrollToMakeVisible(web_contents, node_info, true /* center */);
-+    // Wait for scroll to complete
-+    base::PlatformThread::Sleep(base::Milliseconds(300));
-+    
-+    // For out-of-viewport nodes, use AccessibilityDoDefault first (most reliable after scroll)
-+    // LOG(INFO) << "[browseros] Node was out of viewport, trying AccessibilityDoDefault click first";
-+    // bool changed = BrowserOSChangeDetector::ExecuteWithDetection(
-+    //     web_contents,
-+    //     [&]() { AccessibilityDoDefault(web_contents, node_info); },
-+    //     base::Milliseconds(300));
-+    
-+    gfx::PointF click_point = GetNodeCenterPoint(web_contents, node_info);
-+    
-+    bool changed = BrowserOSChangeDetector::ExecuteWithDetection(
++    // Click once the scroll has settled so the center point is current
++    AfterScrollSettles(
 +        web_contents,
-+        [&]() { PointClick(web_contents, click_point); },
-+        base::Milliseconds(300));
-+    
-+    if (!changed) {
-+      // Skip coordinate click for out-of-viewport nodes (coordinates unreliable)
-+      // Go straight to HTML click
-+      LOG(INFO) << "[browseros] No change from accessibility click, trying HTML click";
-+      changed = BrowserOSChangeDetector::ExecuteWithDetection(
-+          web_contents,
-+          [&]() { HtmlClick(web_contents, node_info); },
-+          base::Milliseconds(200));
-+    }
-+    
-+    LOG(INFO) << "[browseros] Click result: " << (changed ? "changed" : "no change");
-+    return changed;
++        base::BindOnce(&ClickWithFallback, web_contents->GetWeakPtr(),
++                       node_info, std::move(callback)));
++    return;
 +  }
-+  
++
 +  // For in-viewport nodes, try coordinate click first (most natural)
 +  LOG(INFO) << "[browseros] Node is in viewport, trying coordinate click first";
-+  gfx::PointF click_point = GetNodeCenterPoint(web_contents, node_info);
-+  
-+  bool changed = BrowserOSChangeDetector::ExecuteWithDetection(
-+      web_contents,
-+      [&]() { PointClick(web_contents, click_point); },
-+      base::Milliseconds(300));
-+  
-+  // If still no change, try HTML click as final fallback
-+  if (!changed) {
-+      LOG(INFO) << "[browseros] No change from accessibility click, trying HTML click";
-+      changed = BrowserOSChangeDetector::ExecuteWithDetection(
-+          web_contents,
-+          [&]() { HtmlClick(web_contents, node_info); },
-+          base::Milliseconds(200));
-+  }
-+  
-+  LOG(INFO) << "[browseros] Click result: " << (changed ? "changed" : "no change");
-+  return changed;
++  ClickWithFallback(web_contents->GetWeakPtr(), node_info, std::move(callback));
 +}
 +
 +// Helper to perform accessibility action: SetValue
@@ -707,372 +1137,148 @@ index 0000000000000..f40a2424641e1
 +}
 +
 +// Helper to perform typing with change detection
-+bool TypeWithDetection(content::WebContents* web_contents,
-+                      const NodeInfo& node_info,
-+                      const std::string& text) {
++void TypeWithDetection(content::WebContents* web_contents,
++                       const NodeInfo& node_info,
++                       const std::string& text,
++                       TypeCallback callback) {
 +  // Check if node is out of viewport and needs scrolling
-+  auto viewport_it = node_info.attributes.find("in_viewport");
-+  bool is_out_of_viewport = (viewport_it != node_info.attributes.end() && 
-+                              viewport_it->second == "false");
-+  
++  bool is_out_of_viewport = !node_info.attributes.in_viewport().value_or(true);
++
 +  if (is_out_of_viewport) {
 +    LOG(INFO) << "[browseros] Node is out of viewport for typing, scrolling to make visible";
 +    AccessibilityScrollToMakeVisible(web_contents, node_info, true /* center */);
-+    // Wait for scroll to complete
-+    base::PlatformThread::Sleep(base::Milliseconds(300));
-+  }
-+  
-+  // First ensure the element is focused using accessibility
-+  LOG(INFO) << "[browseros] Focusing element for typing";
-+  AccessibilityFocus(web_contents, node_info);
-+  // Small delay to ensure focus is set
-+  base::PlatformThread::Sleep(base::Milliseconds(50));
-+  
-+  // Try native typing first (most natural method)
-+  LOG(INFO) << "[browseros] Trying native typing";
-+  bool changed = BrowserOSChangeDetector::ExecuteWithDetection(
-+      web_contents,
-+      [&]() {
-+        NativeType(web_contents, text);
-+      },
-+      base::Milliseconds(300));
-+  
-+  // If no change detected, try JavaScript typing as second fallback
-+  if (!changed) {
-+    LOG(INFO) << "[browseros] No change from native typing, trying JavaScript";
-+    changed = BrowserOSChangeDetector::ExecuteWithDetection(
++    AfterScrollSettles(
 +        web_contents,
-+        [&]() { JavaScriptType(web_contents, node_info, text); },
-+        base::Milliseconds(200));
++        base::BindOnce(&FocusAndType, web_contents->GetWeakPtr(), node_info,
++                       text, std::move(callback)));
++    return;
 +  }
-+  
-+  // If still no change, try accessibility SetValue as final fallback
-+  // if (!changed) {
-+  //   LOG(INFO) << "[browseros] No change from JavaScript, trying accessibility SetValue";
-+  //   changed = BrowserOSChangeDetector::ExecuteWithDetection(
-+  //       web_contents,
-+  //       [&]() {
-+  //         AccessibilitySetValue(web_contents, node_info, text);
-+  //       },
-+  //       base::Milliseconds(300));
-+  // }
-+  
-+  LOG(INFO) << "[browseros] Type result: " << (changed ? "changed" : "no change");
-+  return changed;
++
++  FocusAndType(web_contents->GetWeakPtr(), node_info, text,
++               std::move(callback));
++}
++
++// Helper to focus an input field and clear it using JavaScript
++void ClearField(content::WebContents* web_contents,
++                const NodeInfo& node_info) {
++  content::RenderFrameHost* rfh = web_contents->GetPrimaryMainFrame();
++  if (!rfh) return;
++
++  // First focus the element
++  HtmlFocus(web_contents, node_info);
++
++  // Then clear using JavaScript
++  rfh->ExecuteJavaScriptForTests(
++      u"(function() {"
++      u"  var activeElement = document.activeElement;"
++      u"  if (activeElement) {"
++      u"    if (activeElement.value !== undefined) {"
++      u"      activeElement.value = '';"
++      u"    }"
++      u"    if (activeElement.textContent !== undefined && activeElement.isContentEditable) {"
++      u"      activeElement.textContent = '';"
++      u"    }"
++      u"    activeElement.dispatchEvent(new Event('input', {bubbles: true}));"
++      u"    activeElement.dispatchEvent(new Event('change', {bubbles: true}));"
++      u"  }"
++      u"})();",
++      base::NullCallback(),
++      /*honor_js_content_settings=*/false);
 +}
 +
 +// Helper to clear an input field with change detection
-+bool ClearWithDetection(content::WebContents* web_contents,
-+                       const NodeInfo& node_info) {
++void ClearWithDetection(content::WebContents* web_contents,
++                        const NodeInfo& node_info,
++                        DetectionCallback callback) {
 +  // Use change detection with JavaScript clear
-+  bool changed = BrowserOSChangeDetector::ExecuteWithDetection(
++  BrowserOSChangeDetector::ExecuteWithDetectionAsync(
 +      web_contents,
-+      [&]() {
-+        content::RenderFrameHost* rfh = web_contents->GetPrimaryMainFrame();
-+        if (!rfh) return;
-+        
-+        // First focus the element
-+        HtmlFocus(web_contents, node_info);
-+        
-+        // Then clear using JavaScript
-+        rfh->ExecuteJavaScriptForTests(
-+            u"(function() {"
-+            u"  var activeElement = document.activeElement;"
-+            u"  if (activeElement) {"
-+            u"    if (activeElement.value !== undefined) {"
-+            u"      activeElement.value = '';"
-+            u"    }"
-+            u"    if (activeElement.textContent !== undefined && activeElement.isContentEditable) {"
-+            u"      activeElement.textContent = '';"
-+            u"    }"
-+            u"    activeElement.dispatchEvent(new Event('input', {bubbles: true}));"
-+            u"    activeElement.dispatchEvent(new Event('change', {bubbles: true}));"
-+            u"  }"
-+            u"})();",
-+            base::NullCallback(),
-+            /*honor_js_content_settings=*/false);
-+      },
++      [web_contents, node_info]() { ClearField(web_contents, node_info); },
++      base::BindOnce(&LogAndReport, "Clear", std::move(callback)),
 +      base::Milliseconds(200));
-+  
-+  LOG(INFO) << "[browseros] Clear result: " << (changed ? "changed" : "no change");
-+  return changed;
 +}
 +
 +// Helper to send a key press with change detection
-+bool KeyPressWithDetection(content::WebContents* web_contents,
-+                          const std::string& key) {
++void KeyPressWithDetection(content::WebContents* web_contents,
++                           const std::string& key,
++                           DetectionCallback callback) {
 +  // Use change detection with key press
-+  bool changed = BrowserOSChangeDetector::ExecuteWithDetection(
++  BrowserOSChangeDetector::ExecuteWithDetectionAsync(
 +      web_contents,
-+      [&]() { KeyPress(web_contents, key); },
++      [web_contents, key]() { KeyPress(web_contents, key); },
++      base::BindOnce(&LogAndReport, "KeyPress", std::move(callback)),
 +      base::Milliseconds(200));
-+  
-+  LOG(INFO) << "[browseros] KeyPress result for '" << key << "': " 
-+            << (changed ? "changed" : "no change");
-+  return changed;
-+}
-+
-+// Helper to show highlights for clickable, typeable, and selectable elements that are in viewport
-+void ShowHighlights(
-+    content::WebContents* web_contents,
-+    const std::unordered_map<uint32_t, NodeInfo>& node_mappings,
-+    bool show_labels) {
-+  
-+  content::RenderFrameHost* rfh = web_contents->GetPrimaryMainFrame();
-+  if (!rfh) return;
-+  
-+  // Filter nodes to only include:
-+  // 1. Elements that are in viewport (using stored in_viewport field)
-+  // 2. Elements that are clickable, typeable, or selectable (using stored node_type)
-+  std::unordered_map<uint32_t, NodeInfo> filtered_nodes;
-+  
-+  for (const auto& [node_id, node_info] : node_mappings) {
-+    // Check if element is in viewport using the stored field
-+    if (!node_info.in_viewport) {
-+      continue;  // Skip elements not in viewport
-+    }
-+    
-+    // Check if element is clickable, typeable, or selectable using stored node_type
-+    // Skip "other" interactive type as requested
-+    if (node_info.node_type == browser_os::InteractiveNodeType::kClickable ||
-+        node_info.node_type == browser_os::InteractiveNodeType::kTypeable ||
-+        node_info.node_type == browser_os::InteractiveNodeType::kSelectable) {
-+      filtered_nodes[node_id] = node_info;
-+    }
-+  }
-+  
-+  // If no nodes match our criteria, return early
-+  if (filtered_nodes.empty()) {
-+    LOG(INFO) << "[browseros] No interactive elements in viewport to highlight";
-+    return;
-+  }
-+  
-+  LOG(INFO) << "[browseros] Highlighting " << filtered_nodes.size() 
-+            << " interactive elements in viewport (out of " << node_mappings.size() << " total)";
-+  
-+  // Use the original drawing implementation but with filtered nodes
-+  
-+  // Build JavaScript to draw all bounding boxes at once
-+  std::string js_code = R"(
-+    (function() {
-+      // Remove any existing bounding boxes
-+      document.querySelectorAll('.browseros-bbox').forEach(e => e.remove());
-+      
-+      // Create container for all bounding boxes
-+      const container = document.createElement('div');
-+      container.className = 'browseros-bbox-container';
-+      container.style.cssText = `
-+        position: fixed;
-+        top: 0;
-+        left: 0;
-+        width: 100%;
-+        height: 100%;
-+        pointer-events: none;
-+        z-index: 2147483647;
-+      `;
-+      
-+      // Node data with bounds
-+      const nodes = [
-+  )";
-+  
-+  // Add filtered nodes with their bounds
-+  bool first = true;
-+  for (const auto& [node_id, node_info] : filtered_nodes) {
-+    if (!first) js_code += ",";
-+    first = false;
-+    
-+    // Bounds are already in CSS pixels from SnapshotProcessor
-+    js_code += base::StringPrintf(
-+        R"(
-+        {
-+          id: %d,
-+          x: %f,
-+          y: %f,
-+          width: %f,
-+          height: %f,
-+          role: "%s"
-+        })",
-+        node_id,
-+        node_info.bounds.x(),
-+        node_info.bounds.y(),
-+        node_info.bounds.width(),
-+        node_info.bounds.height(),
-+        node_info.attributes.count("role") ? node_info.attributes.at("role").c_str() : "unknown"
-+    );
-+  }
-+  
-+  js_code += R"(
-+      ];
-+      
-+      // Draw bounding boxes for all nodes in parallel
-+      nodes.forEach(node => {
-+        if (node.width <= 0 || node.height <= 0) return;
-+        
-+        const box = document.createElement('div');
-+        box.className = 'browseros-bbox';
-+        box.dataset.nodeId = node.id;
-+        box.style.cssText = `
-+          position: absolute;
-+          left: ${node.x}px;
-+          top: ${node.y}px;
-+          width: ${node.width}px;
-+          height: ${node.height}px;
-+          border: 2px solid #1E40AF;
-+          background: transparent;
-+          box-sizing: border-box;
-+        `;
-+  )";
-+  
-+  if (show_labels) {
-+    js_code += R"(
-+        // Add label with node ID
-+        const label = document.createElement('div');
-+        label.style.cssText = `
-+          position: absolute;
-+          top: -22px;
-+          left: 0;
-+          background: #2563EB;
-+          color: #FFFFFF;
-+          padding: 3px 7px;
-+          font-size: 14px;
-+          font-family: monospace;
-+          border-radius: 3px;
-+          white-space: nowrap;
-+          opacity: 0.9;
-+        `;
-+        label.textContent = node.id;
-+        box.appendChild(label);
-+    )";
-+  }
-+  
-+  js_code += R"(
-+        container.appendChild(box);
-+      });
-+      
-+      document.body.appendChild(container);
-+      
-+      // Return count for verification
-+      return nodes.length;
-+    })();
-+  )";
-+  
-+  // Execute the JavaScript
-+  rfh->ExecuteJavaScriptForTests(
-+      base::UTF8ToUTF16(js_code),
-+      base::NullCallback(),
-+      false);
-+}
-+
-+// Helper to remove all bounding box highlights from the page
-+void RemoveHighlights(content::WebContents* web_contents) {
-+  content::RenderFrameHost* rfh = web_contents->GetPrimaryMainFrame();
-+  if (!rfh) return;
-+  
-+  // JavaScript to remove all bounding box containers
-+  std::string js_code = R"(
-+    (function() {
-+      // Remove all bounding box containers
-+      document.querySelectorAll('.browseros-bbox-container').forEach(e => e.remove());
-+      document.querySelectorAll('.browseros-bbox').forEach(e => e.remove());
-+      
-+      // Remove all highlight containers  
-+      document.querySelectorAll('.browseros-highlight-container').forEach(e => e.remove());
-+      document.querySelectorAll('.browseros-highlight').forEach(e => e.remove());
-+      
-+      // Remove any style elements we added
-+      document.querySelectorAll('#browseros-highlight-styles').forEach(e => e.remove());
-+      
-+      return true;
-+    })();
-+  )";
-+  
-+  rfh->ExecuteJavaScriptForTests(
-+      base::UTF8ToUTF16(js_code),
-+      base::NullCallback(),
-+      false);
 +}
 +
 +// Helper to click at specific coordinates with change detection
-+bool ClickCoordinatesWithDetection(content::WebContents* web_contents,
-+                                   const gfx::PointF& point) {
-+  LOG(INFO) << "[browseros] ClickCoordinatesWithDetection at (" 
++void ClickCoordinatesWithDetection(content::WebContents* web_contents,
++                                   const gfx::PointF& point,
++                                   DetectionCallback callback) {
++  LOG(INFO) << "[browseros] ClickCoordinatesWithDetection at ("
 +            << point.x() << ", " << point.y() << ")";
-+  
++
 +  // Perform coordinate click with change detection
-+  bool changed = BrowserOSChangeDetector::ExecuteWithDetection(
++  BrowserOSChangeDetector::ExecuteWithDetectionAsync(
 +      web_contents,
-+      [&]() { 
-+        PointClick(web_contents, point);
-+      },
++      [web_contents, point]() { PointClick(web_contents, point); },
++      base::BindOnce(&LogAndReport, "Click coordinates", std::move(callback)),
 +      base::Milliseconds(300));
-+  
-+  LOG(INFO) << "[browseros] Click coordinates result: " 
-+            << (changed ? "changed" : "no change");
-+  return changed;
 +}
 +
 +// Helper to type text after clicking at coordinates to focus element
-+bool TypeAtCoordinatesWithDetection(content::WebContents* web_contents,
++void TypeAtCoordinatesWithDetection(content::WebContents* web_contents,
 +                                    const gfx::PointF& point,
-+                                    const std::string& text) {
-+  LOG(INFO) << "[browseros] TypeAtCoordinatesWithDetection at (" 
++                                    const std::string& text,
++                                    TypeCallback callback) {
++  LOG(INFO) << "[browseros] TypeAtCoordinatesWithDetection at ("
 +            << point.x() << ", " << point.y() << ") with text: " << text;
-+  
-+  // First click at the coordinates to focus the element
++
++  // First click at the coordinates to focus the element, then type once
++  // focus has been established
 +  PointClick(web_contents, point);
-+  
-+  // Wait a moment for focus to be established
-+  base::PlatformThread::Sleep(base::Milliseconds(100));
-+  
-+  // Now type the text with change detection
-+  bool changed = BrowserOSChangeDetector::ExecuteWithDetection(
-+      web_contents,
-+      [&]() { 
-+        NativeType(web_contents, text);
-+      },
-+      base::Milliseconds(300));
-+  
-+  // If native typing didn't work, try JavaScript injection to detect and type
-+  if (!changed) {
-+    LOG(INFO) << "[browseros] No change from native typing at coordinates, trying JS injection";
-+    
-+    // Execute JavaScript to find the focused element and set its value
-+    content::RenderFrameHost* rfh = web_contents->GetPrimaryMainFrame();
-+    if (rfh) {
-+      std::string js_code = base::StringPrintf(R"(
-+        (function() {
-+          var focused = document.activeElement;
-+          if (focused && (focused.tagName === 'INPUT' || 
-+                         focused.tagName === 'TEXTAREA' || 
-+                         focused.contentEditable === 'true')) {
-+            if (focused.contentEditable === 'true') {
-+              focused.textContent = '%s';
-+            } else {
-+              focused.value = '%s';
-+            }
-+            // Trigger input event
-+            focused.dispatchEvent(new Event('input', { bubbles: true }));
-+            focused.dispatchEvent(new Event('change', { bubbles: true }));
-+            return true;
-+          }
-+          return false;
-+        })();
-+      )", text.c_str(), text.c_str());
-+      
-+      rfh->ExecuteJavaScriptForTests(
-+          base::UTF8ToUTF16(js_code),
-+          base::NullCallback(),
-+          false);
-+      
-+      // Give it a moment to register
-+      base::PlatformThread::Sleep(base::Milliseconds(50));
-+      changed = true; // Assume success if we reached here
-+    }
++  PostAfter(kClickFocusDelay,
++            base::BindOnce(&StartTextInput, web_contents->GetWeakPtr(),
++                           std::optional<NodeInfo>(), text,
++                           std::move(callback)));
++}
++
++void ClickNode(content::WebContents* web_contents,
++               const NodeInfo& node_info,
++               base::OnceClosure done) {
++  if (!node_info.attributes.in_viewport().value_or(true)) {
++    AccessibilityScrollToMakeVisible(web_contents, node_info, true /* center */);
++    AfterScrollSettles(
++        web_contents,
++        base::BindOnce(&ClickNodeCenter, web_contents->GetWeakPtr(), node_info,
++                       std::move(done)));
++    return;
 +  }
-+  
-+  LOG(INFO) << "[browseros] Type at coordinates result: " 
-+            << (changed ? "success" : "failed");
-+  return changed;
++  ClickNodeCenter(web_contents->GetWeakPtr(), node_info, std::move(done));
++}
++
++void TypeIntoNode(content::WebContents* web_contents,
++                  const NodeInfo& node_info,
++                  const std::string& text,
++                  base::OnceClosure done) {
++  if (!node_info.attributes.in_viewport().value_or(true)) {
++    AccessibilityScrollToMakeVisible(web_contents, node_info, true /* center */);
++    AfterScrollSettles(
++        web_contents,
++        base::BindOnce(&FocusThenType, web_contents->GetWeakPtr(), node_info,
++                       text, std::move(done)));
++    return;
++  }
++  FocusThenType(web_contents->GetWeakPtr(), node_info, text, std::move(done));
++}
++
++void TypeAtPoint(content::WebContents* web_contents,
++                 const gfx::PointF& point,
++                 const std::string& text,
++                 base::OnceClosure done) {
++  PointClick(web_contents, point);
++  PostAfter(kClickFocusDelay,
++            base::BindOnce(&TypeText, web_contents->GetWeakPtr(), text,
++                           std::move(done)));
 +}
 +
 +}  // namespace api
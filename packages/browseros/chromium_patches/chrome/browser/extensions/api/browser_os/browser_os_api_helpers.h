@@ -1,9 +1,9 @@
 diff --git a/chrome/browser/extensions/api/browser_os/browser_os_api_helpers.h b/chrome/browser/extensions/api/browser_os/browser_os_api_helpers.h
 new file mode 100644
-index 0000000000000..2000fa3235290
+index 0000000000000..db6799b047202
 --- /dev/null
 +++ b/chrome/browser/extensions/api/browser_os/browser_os_api_helpers.h
-@@ -0,0 +1,137 @@
+@@ -0,0 +1,195 @@
 +// Copyright 2024 The Chromium Authors
 +// Use of this source code is governed by a BSD-style license that can be
 +// found in the LICENSE file.
@@ -12,7 +12,6 @@ index 0000000000000..2000fa3235290
 +#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_API_HELPERS_H_
 +
 +#include <string>
-+#include <unordered_map>
 +
 +#include "base/functional/callback.h"
 +#include "ui/gfx/geometry/point_f.h"
@@ -26,6 +25,32 @@ index 0000000000000..2000fa3235290
 +namespace api {
 +
 +struct NodeInfo;
++struct PageChanges;
++
++// Receives what an action changed in the page, once the page has settled.
++// The *WithDetection helpers below never block the UI thread; they wait for
++// the page through posted tasks and report through this callback.
++using DetectionCallback = base::OnceCallback<void(const PageChanges& changes)>;
++
++// How typed text reached the page. Typing tries the bulk methods in this
++// order and falls back to key events only when none of them had an effect.
++enum class TextInputMethod {
++  // Nothing changed in the page with any method
++  kNone,
++  // One IME commit of the whole text into the focused element
++  kIme,
++  // The accessibility SetValue action on the node
++  kSetValue,
++  // A script that sets the element's value and fires input and change
++  kScript,
++  // Key down, char and key up events for every character
++  kKeystrokes,
++};
++
++// Receives what typing changed in the page and the method that worked
++using TypeCallback =
++    base::OnceCallback<void(const PageChanges& changes,
++                            TextInputMethod method)>;
 +
 +// Returns the multiplicative factor that converts CSS pixels (frame
 +// coordinates) to widget DIPs for input events. This matches DevTools'
@@ -82,60 +107,93 @@ index 0000000000000..2000fa3235290
 +                   int delta_y,
 +                   bool precise = false);
 +
++// Helper to scroll by about one page (90% of the viewport height). Returns
++// false if the tab has no view to scroll.
++bool ScrollPage(content::WebContents* web_contents, bool down);
++
 +// Helper to send special key events
 +void KeyPress(content::WebContents* web_contents,
 +                    const std::string& key);
 +
++// Returns true if |key| is one of the special keys KeyPress supports
++bool IsSupportedKey(const std::string& key);
++
 +// Helper to type text into a focused element using native IME
 +void NativeType(content::WebContents* web_contents,
 +                const std::string& text);
 +
++// Helper to type text as one key event sequence per character. Slow for long
++// text, but works with fields that only listen for key events.
++void KeystrokeType(content::WebContents* web_contents,
++                   const std::string& text);
++
 +// Helper to set text value using JavaScript
 +void JavaScriptType(content::WebContents* web_contents,
 +                    const NodeInfo& node_info,
 +                    const std::string& text);
 +
 +// Helper to perform a click with change detection and retrying
-+// Returns true if the click caused a change in the page
-+bool ClickWithDetection(content::WebContents* web_contents,
-+                        const NodeInfo& node_info);
++// Reports what the click changed in the page
++void ClickWithDetection(content::WebContents* web_contents,
++                        const NodeInfo& node_info,
++                        DetectionCallback callback);
 +
 +// Helper to perform typing with change detection
-+// Returns true if the typing caused a change in the page
-+bool TypeWithDetection(content::WebContents* web_contents,
-+                      const NodeInfo& node_info,
-+                      const std::string& text);
++// Reports what the typing changed in the page and which method worked
++void TypeWithDetection(content::WebContents* web_contents,
++                       const NodeInfo& node_info,
++                       const std::string& text,
++                       TypeCallback callback);
++
++// Helper to focus an input field and clear it using JavaScript
++void ClearField(content::WebContents* web_contents, const NodeInfo& node_info);
 +
 +// Helper to clear an input field with change detection
-+// Returns true if the clear caused a change in the page
-+bool ClearWithDetection(content::WebContents* web_contents,
-+                       const NodeInfo& node_info);
++// Reports what the clear changed in the page
++void ClearWithDetection(content::WebContents* web_contents,
++                        const NodeInfo& node_info,
++                        DetectionCallback callback);
 +
 +// Helper to send a key press with change detection
-+// Returns true if the key press caused a change in the page
-+bool KeyPressWithDetection(content::WebContents* web_contents,
-+                          const std::string& key);
-+
-+// Helper to show highlights for clickable, typeable, and selectable elements that are in viewport
-+// Only highlights elements that are actually visible and interactable
-+void ShowHighlights(content::WebContents* web_contents,
-+                                 const std::unordered_map<uint32_t, NodeInfo>& node_mappings,
-+                                 bool show_labels = true);
-+
-+// Helper to remove all bounding box highlights from the page
-+void RemoveHighlights(content::WebContents* web_contents);
++// Reports what the key press changed in the page
++void KeyPressWithDetection(content::WebContents* web_contents,
++                           const std::string& key,
++                           DetectionCallback callback);
 +
 +// Helper to click at specific coordinates with change detection
-+// Returns true if the click caused a detectable change in the page
-+bool ClickCoordinatesWithDetection(content::WebContents* web_contents,
-+                                   const gfx::PointF& point);
++// Reports what the click changed in the page
++void ClickCoordinatesWithDetection(content::WebContents* web_contents,
++                                   const gfx::PointF& point,
++                                   DetectionCallback callback);
 +
 +// Helper to type text after clicking at coordinates to focus element
 +// First clicks at the coordinates to focus an element, then types the text
-+// Returns true if the operation succeeded
-+bool TypeAtCoordinatesWithDetection(content::WebContents* web_contents,
++// Reports what the typing changed in the page and which method worked
++void TypeAtCoordinatesWithDetection(content::WebContents* web_contents,
 +                                    const gfx::PointF& point,
-+                                    const std::string& text);
++                                    const std::string& text,
++                                    TypeCallback callback);
++
++// Helpers that perform an action without waiting to see its effect, for
++// batched actions that only detect changes after the last one. |done| runs
++// once the action has been dispatched.
++
++// Clicks the center of a node, scrolling it into view first if needed
++void ClickNode(content::WebContents* web_contents,
++               const NodeInfo& node_info,
++               base::OnceClosure done);
++
++// Focuses a node and types |text| into it using native IME
++void TypeIntoNode(content::WebContents* web_contents,
++                  const NodeInfo& node_info,
++                  const std::string& text,
++                  base::OnceClosure done);
++
++// Clicks at |point| and types |text| into whatever took focus
++void TypeAtPoint(content::WebContents* web_contents,
++                 const gfx::PointF& point,
++                 const std::string& text,
++                 base::OnceClosure done);
 +
 +}  // namespace api
 +}  // namespace extensions
@@ -1,9 +1,9 @@
 diff --git a/chrome/browser/extensions/api/browser_os/browser_os_api_utils.cc b/chrome/browser/extensions/api/browser_os/browser_os_api_utils.cc
 new file mode 100644
-index 0000000000000..0c3a060fc70de
+index 0000000000000..0a159dcf1d99c
 --- /dev/null
 +++ b/chrome/browser/extensions/api/browser_os/browser_os_api_utils.cc
-@@ -0,0 +1,167 @@
+@@ -0,0 +1,157 @@
 +// Copyright 2024 The Chromium Authors
 +// Use of this source code is governed by a BSD-style license that can be
 +// found in the LICENSE file.
@@ -11,7 +11,6 @@ index 0000000000000..0c3a060fc70de
 +#include "chrome/browser/extensions/api/browser_os/browser_os_api_utils.h"
 +
 +#include "base/hash/hash.h"
-+#include "base/no_destructor.h"
 +#include "base/strings/string_number_conversions.h"
 +#include "base/strings/utf_string_conversions.h"
 +#include "chrome/browser/extensions/extension_tab_util.h"
@@ -33,15 +32,6 @@ index 0000000000000..0c3a060fc70de
 +NodeInfo::NodeInfo(NodeInfo&&) = default;
 +NodeInfo& NodeInfo::operator=(NodeInfo&&) = default;
 +
-+// Global node ID mappings storage
-+// Use NoDestructor to avoid exit-time destructor
-+std::unordered_map<int, std::unordered_map<uint32_t, NodeInfo>>& 
-+GetNodeIdMappings() {
-+  static base::NoDestructor<std::unordered_map<int, std::unordered_map<uint32_t, NodeInfo>>> 
-+      g_node_id_mappings;
-+  return *g_node_id_mappings;
-+}
-+
 +std::optional<TabInfo> GetTabFromOptionalId(
 +    std::optional<int> tab_id_param,
 +    content::BrowserContext* browser_context,
@@ -0,0 +1,495 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_ax_serialization.cc b/chrome/browser/extensions/api/browser_os/browser_os_ax_serialization.cc
+new file mode 100644
+index 0000000000000..ba788b3681d19
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_ax_serialization.cc
+@@ -0,0 +1,489 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_ax_serialization.h"
++
++#include <bit>
++#include <cmath>
++#include <cstdint>
++#include <string>
++#include <string_view>
++#include <utility>
++#include <vector>
++
++#include "base/json/string_escape.h"
++#include "base/strings/string_number_conversions.h"
++#include "base/time/time.h"
++#include "ui/accessibility/ax_enum_util.h"
++#include "ui/accessibility/ax_node_data.h"
++#include "ui/accessibility/ax_tree_data.h"
++#include "ui/gfx/geometry/rect_f.h"
++
++namespace extensions {
++namespace api {
++
++namespace {
++
++// Calls |fn| with every enum value whose bit is set in |bits|. State and
++// action bitfields use the enum value as the bit index, so this visits only
++// the set bits instead of testing every enum value.
++template <typename Enum, typename Fn>
++void ForEachSetBit(uint64_t bits, Fn fn) {
++  while (bits) {
++    fn(static_cast<Enum>(std::countr_zero(bits)));
++    bits &= bits - 1;
++  }
++}
++
++void AppendString(std::string_view value, std::string* out) {
++  base::EscapeJSONString(value, /*put_in_quotes=*/true, out);
++}
++
++// Matches base::JSONWriter: integral doubles keep a ".0" so they read back
++// as doubles, and non-finite values become null.
++void AppendDouble(double value, std::string* out) {
++  if (!std::isfinite(value)) {
++    out->append("null");
++    return;
++  }
++  std::string number = base::NumberToString(value);
++  if (number.find_first_of(".eE") == std::string::npos) {
++    number.append(".0");
++  }
++  out->append(number);
++}
++
++// Starts the next member of an object, writing the separator if needed.
++void AppendKey(std::string_view key, bool& first, std::string* out) {
++  if (!first) {
++    out->push_back(',');
++  }
++  first = false;
++  AppendString(key, out);
++  out->push_back(':');
++}
++
++void AppendSeparator(bool& first, std::string* out) {
++  if (!first) {
++    out->push_back(',');
++  }
++  first = false;
++}
++
++void AppendIntList(const std::vector<int32_t>& values, std::string* out) {
++  out->push_back('[');
++  bool first = true;
++  for (int32_t value : values) {
++    AppendSeparator(first, out);
++    out->append(base::NumberToString(value));
++  }
++  out->push_back(']');
++}
++
++void AppendStringList(const std::vector<std::string>& values,
++                      std::string* out) {
++  out->push_back('[');
++  bool first = true;
++  for (const std::string& value : values) {
++    AppendSeparator(first, out);
++    AppendString(value, out);
++  }
++  out->push_back(']');
++}
++
++template <typename Enum>
++void AppendEnumList(uint64_t bits, std::string* out) {
++  out->push_back('[');
++  bool first = true;
++  ForEachSetBit<Enum>(bits, [&](Enum value) {
++    AppendSeparator(first, out);
++    AppendString(ui::ToString(value), out);
++  });
++  out->push_back(']');
++}
++
++// Writes the attribute maps of |node| as members of the current object, or
++// as array elements when |as_array| is set (compact format, null if empty).
++void AppendAttributeMaps(const ui::AXNodeData& node,
++                         bool as_array,
++                         bool& first,
++                         std::string* out) {
++  auto begin_map = [&](std::string_view key, bool empty) {
++    if (as_array) {
++      AppendSeparator(first, out);
++      if (empty) {
++        out->append("null");
++        return false;
++      }
++    } else {
++      if (empty) {
++        return false;
++      }
++      AppendKey(key, first, out);
++    }
++    out->push_back('{');
++    return true;
++  };
++
++  if (begin_map("stringAttributes", node.string_attributes.empty())) {
++    bool first_attr = true;
++    for (const auto& [key, value] : node.string_attributes) {
++      AppendKey(ui::ToString(key), first_attr, out);
++      AppendString(value, out);
++    }
++    out->push_back('}');
++  }
++  if (begin_map("intAttributes", node.int_attributes.empty())) {
++    bool first_attr = true;
++    for (const auto& [key, value] : node.int_attributes) {
++      AppendKey(ui::ToString(key), first_attr, out);
++      out->append(base::NumberToString(value));
++    }
++    out->push_back('}');
++  }
++  if (begin_map("floatAttributes", node.float_attributes.empty())) {
++    bool first_attr = true;
++    for (const auto& [key, value] : node.float_attributes) {
++      AppendKey(ui::ToString(key), first_attr, out);
++      AppendDouble(value, out);
++    }
++    out->push_back('}');
++  }
++  if (begin_map("boolAttributes",
++                !node.bool_attributes || node.bool_attributes->Size() == 0)) {
++    bool first_attr = true;
++    node.bool_attributes->ForEach(
++        [&](ax::mojom::BoolAttribute key, bool value) {
++          AppendKey(ui::ToString(key), first_attr, out);
++          out->append(value ? "true" : "false");
++        });
++    out->push_back('}');
++  }
++  if (begin_map("intListAttributes", node.intlist_attributes.empty())) {
++    bool first_attr = true;
++    for (const auto& [key, values] : node.intlist_attributes) {
++      AppendKey(ui::ToString(key), first_attr, out);
++      AppendIntList(values, out);
++    }
++    out->push_back('}');
++  }
++  if (begin_map("stringListAttributes", node.stringlist_attributes.empty())) {
++    bool first_attr = true;
++    for (const auto& [key, values] : node.stringlist_attributes) {
++      AppendKey(ui::ToString(key), first_attr, out);
++      AppendStringList(values, out);
++    }
++    out->push_back('}');
++  }
++  if (begin_map("htmlAttributes", node.html_attributes.empty())) {
++    bool first_attr = true;
++    for (const auto& [name, value] : node.html_attributes) {
++      AppendKey(name, first_attr, out);
++      AppendString(value, out);
++    }
++    out->push_back('}');
++  }
++}
++
++}  // namespace
++
++base::Value::Dict SerializeAXNodeData(const ui::AXNodeData& node) {
++  base::Value::Dict dict;
++
++  // Core identity
++  dict.Set("id", node.id);
++  dict.Set("role", ui::ToString(node.role));
++
++  // Bounds relative to the offset container, in physical pixels
++  base::Value::Dict bounds;
++  bounds.Set("x", static_cast<double>(node.relative_bounds.bounds.x()));
++  bounds.Set("y", static_cast<double>(node.relative_bounds.bounds.y()));
++  bounds.Set("width", static_cast<double>(node.relative_bounds.bounds.width()));
++  bounds.Set("height",
++             static_cast<double>(node.relative_bounds.bounds.height()));
++  if (node.relative_bounds.offset_container_id != -1) {
++    bounds.Set("offsetContainerId", node.relative_bounds.offset_container_id);
++  }
++  dict.Set("relativeBounds", std::move(bounds));
++
++  // Hierarchy
++  if (!node.child_ids.empty()) {
++    base::Value::List children;
++    for (int32_t child_id : node.child_ids) {
++      children.Append(child_id);
++    }
++    dict.Set("childIds", std::move(children));
++  }
++
++  // State bitfield converted to string array
++  if (node.state) {
++    base::Value::List states;
++    ForEachSetBit<ax::mojom::State>(
++        node.state, [&states](ax::mojom::State state) {
++          states.Append(ui::ToString(state));
++        });
++    dict.Set("states", std::move(states));
++  }
++
++  // Actions bitfield converted to string array
++  if (node.actions) {
++    base::Value::List actions;
++    ForEachSetBit<ax::mojom::Action>(
++        node.actions, [&actions](ax::mojom::Action action) {
++          actions.Append(ui::ToString(action));
++        });
++    dict.Set("actions", std::move(actions));
++  }
++
++  // String attributes map with enum keys converted to strings
++  if (node.string_attributes.size() > 0) {
++    base::Value::Dict attrs;
++    for (const auto& [key, value] : node.string_attributes) {
++      attrs.Set(ui::ToString(key), value);
++    }
++    dict.Set("stringAttributes", std::move(attrs));
++  }
++
++  // Int attributes map
++  if (node.int_attributes.size() > 0) {
++    base::Value::Dict attrs;
++    for (const auto& [key, value] : node.int_attributes) {
++      attrs.Set(ui::ToString(key), value);
++    }
++    dict.Set("intAttributes", std::move(attrs));
++  }
++
++  // Float attributes map
++  if (node.float_attributes.size() > 0) {
++    base::Value::Dict attrs;
++    for (const auto& [key, value] : node.float_attributes) {
++      attrs.Set(ui::ToString(key), static_cast<double>(value));
++    }
++    dict.Set("floatAttributes", std::move(attrs));
++  }
++
++  // Bool attributes map
++  if (node.bool_attributes && node.bool_attributes->Size() > 0) {
++    base::Value::Dict attrs;
++    node.bool_attributes->ForEach([&attrs](ax::mojom::BoolAttribute key, bool value) {
++      attrs.Set(ui::ToString(key), value);
++    });
++    dict.Set("boolAttributes", std::move(attrs));
++  }
++
++  // IntList attributes map
++  if (node.intlist_attributes.size() > 0) {
++    base::Value::Dict attrs;
++    for (const auto& [key, values] : node.intlist_attributes) {
++      base::Value::List list;
++      for (int v : values) {
++        list.Append(v);
++      }
++      attrs.Set(ui::ToString(key), std::move(list));
++    }
++    dict.Set("intListAttributes", std::move(attrs));
++  }
++
++  // StringList attributes map
++  if (node.stringlist_attributes.size() > 0) {
++    base::Value::Dict attrs;
++    for (const auto& [key, values] : node.stringlist_attributes) {
++      base::Value::List list;
++      for (const auto& v : values) {
++        list.Append(v);
++      }
++      attrs.Set(ui::ToString(key), std::move(list));
++    }
++    dict.Set("stringListAttributes", std::move(attrs));
++  }
++
++  // HTML attributes (name-value pairs)
++  if (!node.html_attributes.empty()) {
++    base::Value::Dict attrs;
++    for (const auto& [name, value] : node.html_attributes) {
++      attrs.Set(name, value);
++    }
++    dict.Set("htmlAttributes", std::move(attrs));
++  }
++
++  return dict;
++}
++
++base::Value::Dict SerializeAXTreeData(const ui::AXTreeData& tree_data) {
++  base::Value::Dict dict;
++
++  // Document metadata
++  if (!tree_data.title.empty()) {
++    dict.Set("title", tree_data.title);
++  }
++  if (!tree_data.url.empty()) {
++    dict.Set("url", tree_data.url);
++  }
++  if (!tree_data.doctype.empty()) {
++    dict.Set("doctype", tree_data.doctype);
++  }
++  if (!tree_data.mimetype.empty()) {
++    dict.Set("mimetype", tree_data.mimetype);
++  }
++
++  // Loading state
++  dict.Set("loaded", tree_data.loaded);
++  dict.Set("loadingProgress", tree_data.loading_progress);
++
++  // Focus
++  if (tree_data.focus_id != -1) {
++    dict.Set("focusId", tree_data.focus_id);
++  }
++
++  // Selection
++  if (tree_data.sel_anchor_object_id != -1) {
++    base::Value::Dict selection;
++    selection.Set("anchorObjectId", tree_data.sel_anchor_object_id);
++    selection.Set("anchorOffset", tree_data.sel_anchor_offset);
++    selection.Set("focusObjectId", tree_data.sel_focus_object_id);
++    selection.Set("focusOffset", tree_data.sel_focus_offset);
++    selection.Set("isBackward", tree_data.sel_is_backward);
++    dict.Set("selection", std::move(selection));
++  }
++
++  return dict;
++}
++
++void AppendAXNodeDataJSON(const ui::AXNodeData& node, std::string* out) {
++  out->push_back('{');
++  bool first = true;
++  AppendKey("id", first, out);
++  out->append(base::NumberToString(node.id));
++  AppendKey("role", first, out);
++  AppendString(ui::ToString(node.role), out);
++
++  const gfx::RectF& bounds = node.relative_bounds.bounds;
++  AppendKey("relativeBounds", first, out);
++  out->append("{\"x\":");
++  AppendDouble(bounds.x(), out);
++  out->append(",\"y\":");
++  AppendDouble(bounds.y(), out);
++  out->append(",\"width\":");
++  AppendDouble(bounds.width(), out);
++  out->append(",\"height\":");
++  AppendDouble(bounds.height(), out);
++  if (node.relative_bounds.offset_container_id != -1) {
++    out->append(",\"offsetContainerId\":");
++    out->append(base::NumberToString(node.relative_bounds.offset_container_id));
++  }
++  out->push_back('}');
++
++  if (!node.child_ids.empty()) {
++    AppendKey("childIds", first, out);
++    AppendIntList(node.child_ids, out);
++  }
++  if (node.state) {
++    AppendKey("states", first, out);
++    AppendEnumList<ax::mojom::State>(node.state, out);
++  }
++  if (node.actions) {
++    AppendKey("actions", first, out);
++    AppendEnumList<ax::mojom::Action>(node.actions, out);
++  }
++  AppendAttributeMaps(node, /*as_array=*/false, first, out);
++  out->push_back('}');
++}
++
++void AppendAXNodeDataCompactJSON(const ui::AXNodeData& node,
++                                 std::string* out) {
++  const gfx::RectF& bounds = node.relative_bounds.bounds;
++  out->push_back('[');
++  out->append(base::NumberToString(node.id));
++  out->push_back(',');
++  AppendString(ui::ToString(node.role), out);
++  out->append(",[");
++  AppendDouble(bounds.x(), out);
++  out->push_back(',');
++  AppendDouble(bounds.y(), out);
++  out->push_back(',');
++  AppendDouble(bounds.width(), out);
++  out->push_back(',');
++  AppendDouble(bounds.height(), out);
++  out->push_back(',');
++  out->append(base::NumberToString(node.relative_bounds.offset_container_id));
++  out->append("],");
++  AppendIntList(node.child_ids, out);
++  out->push_back(',');
++  AppendEnumList<ax::mojom::State>(node.state, out);
++  out->push_back(',');
++  AppendEnumList<ax::mojom::Action>(node.actions, out);
++  bool first = false;
++  AppendAttributeMaps(node, /*as_array=*/true, first, out);
++  out->push_back(']');
++}
++
++SerializedAXTree::SerializedAXTree() = default;
++SerializedAXTree::SerializedAXTree(SerializedAXTree&&) = default;
++SerializedAXTree& SerializedAXTree::operator=(SerializedAXTree&&) = default;
++SerializedAXTree::~SerializedAXTree() = default;
++
++SerializedAXTree SerializeAXTree(std::vector<ui::AXNodeData> nodes,
++                                 AXTreeFormat format,
++                                 base::TimeTicks deadline) {
++  SerializedAXTree result;
++  auto past_deadline = [&deadline] {
++    return !deadline.is_null() && base::TimeTicks::Now() >= deadline;
++  };
++
++  switch (format) {
++    case AXTreeFormat::kObject:
++      for (const ui::AXNodeData& node : nodes) {
++        if (past_deadline()) {
++          result.truncated = true;
++          break;
++        }
++        result.nodes.Set(base::NumberToString(node.id),
++                         SerializeAXNodeData(node));
++      }
++      break;
++
++    case AXTreeFormat::kJson: {
++      // Plenty for a typical node; avoids most regrowth on large trees
++      result.json.reserve(nodes.size() * 192);
++      result.json.push_back('{');
++      bool first = true;
++      for (const ui::AXNodeData& node : nodes) {
++        if (past_deadline()) {
++          result.truncated = true;
++          break;
++        }
++        AppendKey(base::NumberToString(node.id), first, &result.json);
++        AppendAXNodeDataJSON(node, &result.json);
++      }
++      result.json.push_back('}');
++      break;
++    }
++
++    case AXTreeFormat::kCompact: {
++      result.json.reserve(nodes.size() * 96);
++      result.json.append("{\"fields\":[");
++      bool first = true;
++      for (const char* field : kCompactAXNodeFields) {
++        AppendSeparator(first, &result.json);
++        AppendString(field, &result.json);
++      }
++      result.json.append("],\"nodes\":[");
++      first = true;
++      for (const ui::AXNodeData& node : nodes) {
++        if (past_deadline()) {
++          result.truncated = true;
++          break;
++        }
++        AppendSeparator(first, &result.json);
++        AppendAXNodeDataCompactJSON(node, &result.json);
++      }
++      result.json.append("]}");
++      break;
++    }
++  }
++  return result;
++}
++
++}  // namespace api
++}  // namespace extensions
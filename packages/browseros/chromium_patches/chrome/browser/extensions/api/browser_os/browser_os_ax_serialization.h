@@ -0,0 +1,94 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_ax_serialization.h b/chrome/browser/extensions/api/browser_os/browser_os_ax_serialization.h
+new file mode 100644
+index 0000000000000..61485b1bb9a29
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_ax_serialization.h
+@@ -0,0 +1,88 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_AX_SERIALIZATION_H_
++#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_AX_SERIALIZATION_H_
++
++#include <string>
++#include <vector>
++
++#include "base/time/time.h"
++#include "base/values.h"
++
++namespace ui {
++struct AXNodeData;
++struct AXTreeData;
++}  // namespace ui
++
++namespace extensions {
++namespace api {
++
++// Output formats of getAccessibilityTree
++enum class AXTreeFormat {
++  // base::Value::Dict per node, marshalled as a nested object
++  kObject,
++  // The same object, pre-encoded as one JSON string
++  kJson,
++  // JSON string of {fields, nodes}, one array per node in |fields| order
++  kCompact,
++};
++
++// Column order of a node in the compact format. relativeBounds is
++// [x, y, width, height, offsetContainerId]; empty attribute maps are null.
++inline constexpr const char* kCompactAXNodeFields[] = {
++    "id",
++    "role",
++    "relativeBounds",
++    "childIds",
++    "states",
++    "actions",
++    "stringAttributes",
++    "intAttributes",
++    "floatAttributes",
++    "boolAttributes",
++    "intListAttributes",
++    "stringListAttributes",
++    "htmlAttributes",
++};
++
++// Serializes ui::AXNodeData to base::Value::Dict with all fields, as returned
++// by getAccessibilityTree. Enum values are written as their string names.
++base::Value::Dict SerializeAXNodeData(const ui::AXNodeData& node);
++
++// Serializes ui::AXTreeData to base::Value::Dict
++base::Value::Dict SerializeAXTreeData(const ui::AXTreeData& tree_data);
++
++// Appends the JSON encoding of SerializeAXNodeData(|node|) to |out| without
++// building the intermediate base::Value.
++void AppendAXNodeDataJSON(const ui::AXNodeData& node, std::string* out);
++
++// Appends |node| as a compact array in kCompactAXNodeFields order.
++void AppendAXNodeDataCompactJSON(const ui::AXNodeData& node, std::string* out);
++
++struct SerializedAXTree {
++  SerializedAXTree();
++  SerializedAXTree(SerializedAXTree&&);
++  SerializedAXTree& operator=(SerializedAXTree&&);
++  ~SerializedAXTree();
++
++  // kObject only: node id -> node
++  base::Value::Dict nodes;
++  // kJson and kCompact only
++  std::string json;
++  // True if |deadline| passed before every node was written
++  bool truncated = false;
++};
++
++// Serializes |nodes| in |format|. Runs on any thread, and is meant for a
++// worker so that large trees do not block the UI thread. Nodes after
++// |deadline| (if set) are left out.
++SerializedAXTree SerializeAXTree(std::vector<ui::AXNodeData> nodes,
++                                 AXTreeFormat format,
++                                 base::TimeTicks deadline);
++
++}  // namespace api
++}  // namespace extensions
++
++#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_AX_SERIALIZATION_H_
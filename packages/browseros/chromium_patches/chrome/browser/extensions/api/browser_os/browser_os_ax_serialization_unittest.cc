@@ -0,0 +1,137 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_ax_serialization_unittest.cc b/chrome/browser/extensions/api/browser_os/browser_os_ax_serialization_unittest.cc
+new file mode 100644
+index 0000000000000..7e3caa84d6415
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_ax_serialization_unittest.cc
+@@ -0,0 +1,131 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_ax_serialization.h"
++
++#include <optional>
++#include <string>
++#include <string_view>
++
++#include "base/json/json_reader.h"
++#include "base/strings/string_number_conversions.h"
++#include "base/time/time.h"
++#include "base/values.h"
++#include "chrome/browser/extensions/api/browser_os/test/ax_tree_fixture.h"
++#include "chrome/browser/extensions/api/browser_os/test/snapshot_test_util.h"
++#include "testing/gtest/include/gtest/gtest.h"
++#include "ui/accessibility/ax_node_data.h"
++#include "ui/accessibility/ax_tree.h"
++#include "ui/accessibility/ax_tree_update.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++// =============================================================================
++// Fixture Format Tests
++// =============================================================================
++
++TEST(AXSerializationTest, FixtureFormatRoundTrips) {
++  ui::AXTreeUpdate update = test::BuildTableTreeUpdate(3);
++  // The table tree has no list attributes of its own
++  ui::AXNodeData& button = update.nodes.back();
++  button.AddIntListAttribute(ax::mojom::IntListAttribute::kLabelledbyIds,
++                             {update.root_id, button.id});
++  button.AddStringListAttribute(
++      ax::mojom::StringListAttribute::kCustomActionDescriptions,
++      {"Archive", "Delete"});
++  base::Value::Dict nodes;
++  for (const ui::AXNodeData& node : update.nodes) {
++    nodes.Set(base::NumberToString(node.id), SerializeAXNodeData(node));
++  }
++  base::Value::Dict tree;
++  tree.Set("rootId", update.root_id);
++  tree.Set("nodes", std::move(nodes));
++
++  std::optional<ui::AXTreeUpdate> parsed = test::ParseAXTreeFixture(tree);
++  ASSERT_TRUE(parsed);
++  EXPECT_EQ(update.root_id, parsed->root_id);
++  ASSERT_EQ(update.nodes.size(), parsed->nodes.size());
++  for (size_t i = 0; i < update.nodes.size(); ++i) {
++    EXPECT_EQ(update.nodes[i].ToString(), parsed->nodes[i].ToString());
++  }
++  EXPECT_EQ(button.GetIntListAttribute(
++                ax::mojom::IntListAttribute::kLabelledbyIds),
++            parsed->nodes.back().GetIntListAttribute(
++                ax::mojom::IntListAttribute::kLabelledbyIds));
++  EXPECT_EQ(button.GetStringListAttribute(
++                ax::mojom::StringListAttribute::kCustomActionDescriptions),
++            parsed->nodes.back().GetStringListAttribute(
++                ax::mojom::StringListAttribute::kCustomActionDescriptions));
++}
++
++TEST(AXSerializationTest, CheckedInFixturesAreValidTrees) {
++  for (std::string_view name : test::kAXTreeFixtures) {
++    std::optional<ui::AXTreeUpdate> update = test::LoadAXTreeFixture(name);
++    ASSERT_TRUE(update) << name;
++    ui::AXTree tree;
++    EXPECT_TRUE(tree.Unserialize(*update)) << name << ": " << tree.error();
++    EXPECT_TRUE(tree.root()) << name;
++  }
++}
++
++// =============================================================================
++// String Format Tests
++// =============================================================================
++
++TEST(AXSerializationTest, JsonMatchesObjectFormat) {
++  for (std::string_view name : test::kAXTreeFixtures) {
++    std::optional<ui::AXTreeUpdate> update = test::LoadAXTreeFixture(name);
++    ASSERT_TRUE(update) << name;
++    SerializedAXTree object = SerializeAXTree(
++        update->nodes, AXTreeFormat::kObject, base::TimeTicks());
++    SerializedAXTree json =
++        SerializeAXTree(update->nodes, AXTreeFormat::kJson, base::TimeTicks());
++    EXPECT_FALSE(json.truncated);
++
++    std::optional<base::Value::Dict> parsed =
++        base::JSONReader::ReadDict(json.json);
++    ASSERT_TRUE(parsed) << name;
++    EXPECT_EQ(object.nodes, *parsed) << name;
++  }
++}
++
++TEST(AXSerializationTest, CompactHasOneColumnPerField) {
++  ui::AXTreeUpdate update = test::BuildTableTreeUpdate(3);
++  SerializedAXTree compact =
++      SerializeAXTree(update.nodes, AXTreeFormat::kCompact, base::TimeTicks());
++
++  std::optional<base::Value::Dict> parsed =
++      base::JSONReader::ReadDict(compact.json);
++  ASSERT_TRUE(parsed);
++  const base::Value::List* fields = parsed->FindList("fields");
++  const base::Value::List* nodes = parsed->FindList("nodes");
++  ASSERT_TRUE(fields);
++  ASSERT_TRUE(nodes);
++  EXPECT_EQ(std::size(kCompactAXNodeFields), fields->size());
++  ASSERT_EQ(update.nodes.size(), nodes->size());
++  for (size_t i = 0; i < nodes->size(); ++i) {
++    const base::Value::List* row = (*nodes)[i].GetIfList();
++    ASSERT_TRUE(row);
++    ASSERT_EQ(fields->size(), row->size());
++    EXPECT_EQ(update.nodes[i].id, (*row)[0].GetInt());
++  }
++}
++
++TEST(AXSerializationTest, ExpiredDeadlineTruncates) {
++  ui::AXTreeUpdate update = test::BuildTableTreeUpdate(3);
++  SerializedAXTree json =
++      SerializeAXTree(update.nodes, AXTreeFormat::kJson,
++                      base::TimeTicks::Now() - base::Seconds(1));
++  EXPECT_TRUE(json.truncated);
++  std::optional<base::Value::Dict> parsed =
++      base::JSONReader::ReadDict(json.json);
++  ASSERT_TRUE(parsed);
++  EXPECT_TRUE(parsed->empty());
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
@@ -1,18 +1,21 @@
 diff --git a/chrome/browser/extensions/api/browser_os/browser_os_change_detector.cc b/chrome/browser/extensions/api/browser_os/browser_os_change_detector.cc
 new file mode 100644
-index 0000000000000..ea45bebcce461
+index 0000000000000..ca769abe84c3a
 --- /dev/null
 +++ b/chrome/browser/extensions/api/browser_os/browser_os_change_detector.cc
-@@ -0,0 +1,205 @@
+@@ -0,0 +1,320 @@
 +// Copyright 2024 The Chromium Authors
 +// Use of this source code is governed by a BSD-style license that can be
 +// found in the LICENSE file.
 +
 +#include "chrome/browser/extensions/api/browser_os/browser_os_change_detector.h"
 +
++#include <algorithm>
++
 +#include "base/functional/bind.h"
 +#include "base/logging.h"
-+#include "base/run_loop.h"
++#include "content/browser/renderer_host/render_frame_metadata_provider_impl.h"
++#include "content/browser/renderer_host/render_widget_host_impl.h"
 +#include "content/public/browser/focused_node_details.h"
 +#include "content/public/browser/navigation_handle.h"
 +#include "content/public/browser/render_frame_host.h"
@@ -27,132 +30,172 @@ index 0000000000000..ea45bebcce461
 +
 +BrowserOSChangeDetector::~BrowserOSChangeDetector() {
 +  timeout_timer_.Stop();
++  quiet_timer_.Stop();
++  ObserveFrames(nullptr);
 +}
 +
-+// Static method for synchronous detection
-+bool BrowserOSChangeDetector::ExecuteWithDetection(
++// Static method for asynchronous detection
++void BrowserOSChangeDetector::ExecuteWithDetectionAsync(
 +    content::WebContents* web_contents,
 +    std::function<void()> action,
++    ResultCallback callback,
 +    base::TimeDelta timeout) {
-+  auto detector = std::make_unique<BrowserOSChangeDetector>(web_contents);
-+  return detector->ExecuteAndWait(std::move(action), timeout);
++  SettleOptions options;
++  options.change_timeout = timeout;
++  ExecuteWithDetectionAsync(web_contents, std::move(action),
++                            std::move(callback), options);
 +}
 +
-+// Static method for asynchronous detection
 +void BrowserOSChangeDetector::ExecuteWithDetectionAsync(
 +    content::WebContents* web_contents,
 +    std::function<void()> action,
-+    base::OnceCallback<void(bool)> callback,
-+    base::TimeDelta timeout) {
++    ResultCallback callback,
++    const SettleOptions& options) {
 +  // Create detector on heap - it will delete itself when done
 +  auto* detector = new BrowserOSChangeDetector(web_contents);
-+  detector->ExecuteAndNotify(std::move(action), std::move(callback), timeout);
++  detector->ExecuteAndNotify(std::move(action), std::move(callback), options);
++}
++
++// static
++void BrowserOSChangeDetector::WaitForSettle(content::WebContents* web_contents,
++                                            const SettleOptions& options,
++                                            ResultCallback callback) {
++  auto* detector = new BrowserOSChangeDetector(web_contents);
++  detector->options_ = options;
++  detector->StartMonitoring();
++  detector->result_callback_ = std::move(callback);
++  // Nothing to wait for first: go straight to waiting for quiet
++  detector->OnChangeDetected();
 +}
 +
 +void BrowserOSChangeDetector::StartMonitoring() {
 +  monitoring_ = true;
 +  change_detected_ = false;
++  changes_ = PageChanges();
++  start_time_ = base::TimeTicks::Now();
++  if (web_contents()) {
++    ObserveFrames(web_contents()->GetPrimaryMainFrame());
++  }
 +  VLOG(1) << "[browseros] Started monitoring for changes";
 +}
 +
-+bool BrowserOSChangeDetector::ExecuteAndWait(std::function<void()> action,
-+                                             base::TimeDelta timeout) {
-+  StartMonitoring();
-+  
-+  // Execute the action
-+  action();
-+  
-+  // If change already detected (synchronously), return immediately
-+  if (change_detected_) {
-+    VLOG(1) << "[browseros] Change detected immediately";
-+    return true;
-+  }
-+  
-+  // Set up run loop to wait for changes
-+  base::RunLoop run_loop(base::RunLoop::Type::kNestableTasksAllowed);
-+  wait_callback_ = run_loop.QuitClosure();
-+  
-+  // Start timeout timer
-+  timeout_timer_.Start(FROM_HERE, timeout,
-+                      base::BindOnce(&BrowserOSChangeDetector::OnTimeout,
-+                                    weak_factory_.GetWeakPtr()));
-+  
-+  // Wait for change or timeout
-+  run_loop.Run();
-+  
-+  // Clean up
-+  timeout_timer_.Stop();
-+  wait_callback_.Reset();
-+  monitoring_ = false;
-+  
-+  VLOG(1) << "[browseros] Change detection result: " << change_detected_;
-+  return change_detected_;
-+}
-+
 +void BrowserOSChangeDetector::ExecuteAndNotify(
 +    std::function<void()> action,
-+    base::OnceCallback<void(bool)> callback,
-+    base::TimeDelta timeout) {
++    ResultCallback callback,
++    const SettleOptions& options) {
++  options_ = options;
 +  StartMonitoring();
-+  result_callback_ = std::move(callback);
-+  
++
 +  // Execute the action
 +  action();
-+  
-+  // If change already detected, notify immediately
++
++  result_callback_ = std::move(callback);
++
++  // The page may have gone away during the action
++  if (!web_contents()) {
++    Finish(/*settled=*/false);
++    return;
++  }
++
++  // If change already detected, go straight to waiting for quiet
 +  if (change_detected_) {
 +    VLOG(1) << "[browseros] Change detected immediately (async)";
-+    std::move(result_callback_).Run(true);
-+    delete this;  // Self-delete
++    change_detected_ = false;
++    OnChangeDetected();
 +    return;
 +  }
-+  
++
 +  // Start timeout timer
 +  timeout_timer_.Start(
-+      FROM_HERE, timeout,
++      FROM_HERE, options_.change_timeout,
 +      base::BindOnce(&BrowserOSChangeDetector::OnTimeout,
-+                    weak_factory_.GetWeakPtr()));
++                     weak_factory_.GetWeakPtr()));
++}
++
++void BrowserOSChangeDetector::ObserveFrames(
++    content::RenderFrameHost* render_frame_host) {
++  if (frame_metadata_provider_) {
++    frame_metadata_provider_->RemoveObserver(this);
++    frame_metadata_provider_ = nullptr;
++  }
++  if (!render_frame_host) {
++    return;
++  }
++  auto* widget = content::RenderWidgetHostImpl::From(
++      render_frame_host->GetRenderWidgetHost());
++  if (widget && widget->render_frame_metadata_provider()) {
++    frame_metadata_provider_ = widget->render_frame_metadata_provider();
++    frame_metadata_provider_->AddObserver(this);
++  }
 +}
 +
 +void BrowserOSChangeDetector::OnChangeDetected() {
 +  if (!monitoring_ || change_detected_) {
 +    return;
 +  }
-+  
++
 +  change_detected_ = true;
-+  monitoring_ = false;
-+  
-+  VLOG(1) << "[browseros] Change detected";
-+  
-+  // Stop the timeout timer
-+  timeout_timer_.Stop();
-+  
-+  // If synchronous wait, quit the run loop
-+  if (wait_callback_) {
-+    std::move(wait_callback_).Run();
++
++  VLOG(1) << "[browseros] Change detected, waiting for the page to settle";
++
++  // Changes seen while the action is still running are picked up by
++  // ExecuteAndNotify once it returns
++  if (!result_callback_) {
++    return;
 +  }
-+  
-+  // If async, notify callback and self-delete
-+  if (result_callback_) {
-+    std::move(result_callback_).Run(true);
-+    delete this;  // Self-delete for async mode
++
++  // From here on the page is settled after a quiet period, bounded by the
++  // max wait from the start of the action
++  base::TimeDelta remaining =
++      options_.max_wait - (base::TimeTicks::Now() - start_time_);
++  timeout_timer_.Start(
++      FROM_HERE, std::max(remaining, base::TimeDelta()),
++      base::BindOnce(&BrowserOSChangeDetector::OnTimeout,
++                     weak_factory_.GetWeakPtr()));
++  quiet_timer_.Start(
++      FROM_HERE, options_.quiet_period,
++      base::BindRepeating(&BrowserOSChangeDetector::OnQuiet,
++                          weak_factory_.GetWeakPtr()));
++}
++
++void BrowserOSChangeDetector::OnActivity() {
++  // Also restarts a quiet period that OnQuiet let lapse during a load
++  if (monitoring_ && change_detected_ && result_callback_) {
++    quiet_timer_.Reset();
 +  }
 +}
 +
-+void BrowserOSChangeDetector::OnTimeout() {
-+  VLOG(1) << "[browseros] Change detection timeout";
-+  monitoring_ = false;
-+  
-+  // If synchronous wait, quit the run loop
-+  if (wait_callback_) {
-+    std::move(wait_callback_).Run();
++void BrowserOSChangeDetector::OnQuiet() {
++  // A load in flight is not quiet; DidStopLoading restarts the period
++  if (web_contents() && web_contents()->IsLoading()) {
++    VLOG(2) << "[browseros] Quiet but still loading";
++    return;
 +  }
-+  
-+  // If async, notify callback with false and self-delete
-+  if (result_callback_) {
-+    std::move(result_callback_).Run(false);
-+    delete this;  // Self-delete for async mode
++  VLOG(1) << "[browseros] Page settled";
++  Finish(/*settled=*/true);
++}
++
++void BrowserOSChangeDetector::OnTimeout() {
++  if (!change_detected_) {
++    VLOG(1) << "[browseros] Change detection timeout";
++    // Nothing happened, which also means nothing is left to settle
++    Finish(/*settled=*/true);
++    return;
 +  }
++  VLOG(1) << "[browseros] Page did not settle before the max wait";
++  Finish(/*settled=*/false);
++}
++
++void BrowserOSChangeDetector::Finish(bool settled) {
++  monitoring_ = false;
++  timeout_timer_.Stop();
++  quiet_timer_.Stop();
++  ObserveFrames(nullptr);
++
++  changes_.settled = settled;
++  changes_.elapsed = base::TimeTicks::Now() - start_time_;
++  std::move(result_callback_).Run(changes_);
++  delete this;  // Self-delete
 +}
 +
 +// WebContentsObserver overrides - any of these counts as a "change"
@@ -160,28 +203,43 @@ index 0000000000000..ea45bebcce461
 +void BrowserOSChangeDetector::AccessibilityEventReceived(
 +    const ui::AXUpdatesAndEvents& details) {
 +  if (!monitoring_) return;
-+  
-+  // Any accessibility event indicates a change
++
++  // Any accessibility event indicates a change; bursts of them keep the page
++  // from settling
 +  if (!details.updates.empty() || !details.events.empty()) {
 +    VLOG(2) << "[browseros] Accessibility event detected";
++    changes_.dom_changed = true;
 +    OnChangeDetected();
++    OnActivity();
 +  }
 +}
 +
 +void BrowserOSChangeDetector::DidFinishNavigation(
 +    content::NavigationHandle* navigation_handle) {
 +  if (!monitoring_) return;
-+  
++
++  OnActivity();
++  if (!navigation_handle->HasCommitted()) {
++    return;
++  }
++
 +  VLOG(2) << "[browseros] Navigation detected";
++  if (navigation_handle->IsInPrimaryMainFrame()) {
++    changes_.navigated = true;
++  } else {
++    changes_.dom_changed = true;
++  }
 +  OnChangeDetected();
 +}
 +
 +void BrowserOSChangeDetector::DOMContentLoaded(
 +    content::RenderFrameHost* render_frame_host) {
 +  if (!monitoring_) return;
-+  
++
 +  VLOG(2) << "[browseros] DOM content loaded";
++  changes_.dom_changed = true;
 +  OnChangeDetected();
++  OnActivity();
 +}
 +
 +void BrowserOSChangeDetector::OnFocusChangedInPage(
@@ -189,7 +247,9 @@ index 0000000000000..ea45bebcce461
 +  if (!monitoring_) return;
 +
 +  VLOG(2) << "[browseros] Focus changed";
++  changes_.focus_changed = true;
 +  OnChangeDetected();
++  OnActivity();
 +}
 +
 +void BrowserOSChangeDetector::DidOpenRequestedURL(
@@ -202,9 +262,64 @@ index 0000000000000..ea45bebcce461
 +    bool started_from_context_menu,
 +    bool renderer_initiated) {
 +  if (!monitoring_) return;
-+  
++
 +  VLOG(2) << "[browseros] New URL opened";
++  if (disposition != WindowOpenDisposition::CURRENT_TAB) {
++    changes_.new_tab_opened = true;
++  }
++  OnChangeDetected();
++  OnActivity();
++}
++
++// Loads count as a change as soon as they start, so that a slow navigation is
++// not mistaken for a click that did nothing
++
++void BrowserOSChangeDetector::DidStartLoading() {
++  if (!monitoring_) return;
++
++  VLOG(2) << "[browseros] Loading started";
++  changes_.load_started = true;
 +  OnChangeDetected();
++  OnActivity();
++}
++
++void BrowserOSChangeDetector::DidStopLoading() {
++  if (!monitoring_) return;
++
++  VLOG(2) << "[browseros] Loading stopped";
++  OnActivity();
++}
++
++void BrowserOSChangeDetector::ResourceLoadComplete(
++    content::RenderFrameHost* render_frame_host,
++    const content::GlobalRequestID& request_id,
++    const blink::mojom::ResourceLoadInfo& resource_load_info) {
++  OnActivity();
++}
++
++void BrowserOSChangeDetector::RenderFrameHostChanged(
++    content::RenderFrameHost* old_host,
++    content::RenderFrameHost* new_host) {
++  // Cross-process navigations swap the main frame's widget
++  if (monitoring_ && new_host && new_host->IsInPrimaryMainFrame()) {
++    ObserveFrames(new_host);
++  }
++}
++
++void BrowserOSChangeDetector::WebContentsDestroyed() {
++  // Nothing left to observe; report what we saw rather than wait for timers
++  ObserveFrames(nullptr);
++  Observe(nullptr);
++  if (result_callback_) {
++    Finish(/*settled=*/false);
++  }
++}
++
++// RenderFrameMetadataProvider::Observer
++
++void BrowserOSChangeDetector::OnRenderFrameMetadataChangedAfterActivation(
++    base::TimeTicks activation_time) {
++  OnActivity();
 +}
 +
 +}  // namespace api
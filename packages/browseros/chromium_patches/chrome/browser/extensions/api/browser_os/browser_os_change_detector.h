@@ -1,9 +1,9 @@
 diff --git a/chrome/browser/extensions/api/browser_os/browser_os_change_detector.h b/chrome/browser/extensions/api/browser_os/browser_os_change_detector.h
 new file mode 100644
-index 0000000000000..a45117498c829
+index 0000000000000..038572e9c8338
 --- /dev/null
 +++ b/chrome/browser/extensions/api/browser_os/browser_os_change_detector.h
-@@ -0,0 +1,108 @@
+@@ -0,0 +1,199 @@
 +// Copyright 2024 The Chromium Authors
 +// Use of this source code is governed by a BSD-style license that can be
 +// found in the LICENSE file.
@@ -14,12 +14,15 @@ index 0000000000000..a45117498c829
 +#include <functional>
 +
 +#include "base/functional/callback.h"
++#include "base/memory/raw_ptr.h"
 +#include "base/memory/weak_ptr.h"
 +#include "base/time/time.h"
 +#include "base/timer/timer.h"
++#include "content/public/browser/render_frame_metadata_provider.h"
 +#include "content/public/browser/web_contents_observer.h"
 +
 +namespace content {
++class RenderFrameHost;
 +class WebContents;
 +}  // namespace content
 +
@@ -30,25 +33,73 @@ index 0000000000000..a45117498c829
 +namespace extensions {
 +namespace api {
 +
-+// Change detector that monitors if any change occurred in the web content
-+// after an action is performed. This is used to verify that actions like
-+// click, type, clear, etc. actually had an effect on the page.
-+class BrowserOSChangeDetector : public content::WebContentsObserver {
++// What an action did to the page, as seen by BrowserOSChangeDetector
++struct PageChanges {
++  // The primary main frame committed a navigation
++  bool navigated = false;
++  // The accessibility tree or document changed
++  bool dom_changed = false;
++  // Focus moved to a different element
++  bool focus_changed = false;
++  // The page opened a new tab or window
++  bool new_tab_opened = false;
++  // A load started in the tab, which may not have committed yet
++  bool load_started = false;
++  // The page went quiet before the wait limit. False means the page was
++  // still busy when the detector gave up.
++  bool settled = false;
++  // Time from the action to the result
++  base::TimeDelta elapsed;
++
++  bool any() const {
++    return navigated || dom_changed || focus_changed || new_tab_opened ||
++           load_started;
++  }
++};
++
++// Timing of a settle wait
++struct SettleOptions {
++  // How long to wait for the first sign of a change. A page that shows none
++  // in this time is reported as unchanged.
++  base::TimeDelta change_timeout = base::Milliseconds(300);
++  // Once something changed, the page is settled when it has not loaded,
++  // updated its accessibility tree or produced a frame for this long
++  base::TimeDelta quiet_period = base::Milliseconds(100);
++  // Upper bound on the whole wait, for pages that never go quiet
++  base::TimeDelta max_wait = base::Seconds(3);
++};
++
++// Quiescence detector that monitors the web content after an action is
++// performed. It verifies that actions like click, type, clear, etc. actually
++// had an effect on the page, then waits for the page to settle: no pending
++// loads, no accessibility update bursts and no new compositor frames. Agents
++// can snapshot right away instead of sleeping for a guessed delay.
++class BrowserOSChangeDetector
++    : public content::WebContentsObserver,
++      public content::RenderFrameMetadataProvider::Observer {
 + public:
-+  // Execute an action and detect if it causes any change in the page
-+  // Returns true if any change was detected within the timeout period
-+  static bool ExecuteWithDetection(
-+      content::WebContents* web_contents,
-+      std::function<void()> action,
-+      base::TimeDelta timeout = base::Milliseconds(300));
++  using ResultCallback = base::OnceCallback<void(const PageChanges&)>;
 +
-+  // Alternative async version that doesn't block
++  // Execute an action and report via |callback| what it changed once the
++  // page has settled. Never blocks the calling thread.
 +  static void ExecuteWithDetectionAsync(
 +      content::WebContents* web_contents,
 +      std::function<void()> action,
-+      base::OnceCallback<void(bool)> callback,
++      ResultCallback callback,
 +      base::TimeDelta timeout = base::Milliseconds(300));
 +
++  // Same as above with full control over the settle timing
++  static void ExecuteWithDetectionAsync(content::WebContents* web_contents,
++                                        std::function<void()> action,
++                                        ResultCallback callback,
++                                        const SettleOptions& options);
++
++  // Waits for |web_contents| to settle without performing an action. A page
++  // that is loading counts as changing.
++  static void WaitForSettle(content::WebContents* web_contents,
++                            const SettleOptions& options,
++                            ResultCallback callback);
++
 +  // Constructor and destructor are public for use by factory methods
 +  explicit BrowserOSChangeDetector(content::WebContents* web_contents);
 +  ~BrowserOSChangeDetector() override;
@@ -60,13 +111,10 @@ index 0000000000000..a45117498c829
 +  // Start monitoring for changes
 +  void StartMonitoring();
 +
-+  // Execute the action and wait for changes
-+  bool ExecuteAndWait(std::function<void()> action, base::TimeDelta timeout);
-+
 +  // Execute the action and notify via callback
 +  void ExecuteAndNotify(std::function<void()> action,
-+                        base::OnceCallback<void(bool)> callback,
-+                        base::TimeDelta timeout);
++                        ResultCallback callback,
++                        const SettleOptions& options);
 +
 +  // WebContentsObserver overrides - we monitor any of these as "changes"
 +  void AccessibilityEventReceived(
@@ -86,24 +134,67 @@ index 0000000000000..a45117498c829
 +      ui::PageTransition transition,
 +      bool started_from_context_menu,
 +      bool renderer_initiated) override;
++  // ...and these as activity that delays settling
++  void DidStartLoading() override;
++  void DidStopLoading() override;
++  void ResourceLoadComplete(
++      content::RenderFrameHost* render_frame_host,
++      const content::GlobalRequestID& request_id,
++      const blink::mojom::ResourceLoadInfo& resource_load_info) override;
++  void RenderFrameHostChanged(content::RenderFrameHost* old_host,
++                              content::RenderFrameHost* new_host) override;
++  void WebContentsDestroyed() override;
++
++  // RenderFrameMetadataProvider::Observer - compositor frames of the main
++  // widget, which keep coming while the page animates or scrolls
++  void OnRenderFrameMetadataChangedBeforeActivation(
++      const cc::RenderFrameMetadata& metadata) override {}
++  void OnRenderFrameMetadataChangedAfterActivation(
++      base::TimeTicks activation_time) override;
++  void OnRenderFrameSubmission() override {}
++  void OnLocalSurfaceIdChanged(
++      const cc::RenderFrameMetadata& metadata) override {}
++
++  // Moves frame observation to the widget of |render_frame_host|, or stops
++  // it if null
++  void ObserveFrames(content::RenderFrameHost* render_frame_host);
 +
 +  // Called when any change is detected
 +  void OnChangeDetected();
 +
++  // Called on any page activity; (re)starts the quiet period once settling
++  void OnActivity();
++
++  // Called when the page has been quiet for the quiet period
++  void OnQuiet();
++
 +  // Called when timeout expires
 +  void OnTimeout();
 +
++  // Runs the result callback and deletes the detector
++  void Finish(bool settled);
++
 +  // Simple state tracking
 +  bool monitoring_ = false;
 +  bool change_detected_ = false;
-+  
-+  // Callbacks
-+  base::OnceClosure wait_callback_;
-+  base::OnceCallback<void(bool)> result_callback_;
-+  
-+  // Timer for timeout
++  PageChanges changes_;
++  SettleOptions options_;
++  base::TimeTicks start_time_;
++
++  // Set once the action has run; a change seen during the action itself is
++  // picked up by ExecuteAndNotify
++  ResultCallback result_callback_;
++
++  // Timer for timeout: first the change timeout, then the max wait
 +  base::OneShotTimer timeout_timer_;
-+  
++
++  // Restarted by every activity while settling
++  base::RetainingOneShotTimer quiet_timer_;
++
++  // Frame metadata source of the primary main frame's widget
++  raw_ptr<content::RenderFrameMetadataProvider> frame_metadata_provider_ =
++      nullptr;
++
 +  // Weak pointer factory
 +  base::WeakPtrFactory<BrowserOSChangeDetector> weak_factory_{this};
 +};
@@ -112,4 +203,3 @@ index 0000000000000..a45117498c829
 +}  // namespace extensions
 +
 +#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_CHANGE_DETECTOR_H_
-\ No newline at end of file
@@ -0,0 +1,124 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_change_detector_unittest.cc b/chrome/browser/extensions/api/browser_os/browser_os_change_detector_unittest.cc
+new file mode 100644
+index 0000000000000..bd24be8098bb4
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_change_detector_unittest.cc
+@@ -0,0 +1,118 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_change_detector.h"
++
++#include "base/test/test_future.h"
++#include "content/public/test/test_renderer_host.h"
++#include "content/public/test/web_contents_tester.h"
++#include "testing/gtest/include/gtest/gtest.h"
++#include "url/gurl.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++class BrowserOSChangeDetectorTest : public content::RenderViewHostTestHarness {
++ protected:
++  BrowserOSChangeDetectorTest()
++      : content::RenderViewHostTestHarness(
++            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
++
++  void SetUp() override {
++    content::RenderViewHostTestHarness::SetUp();
++    NavigateAndCommit(GURL("https://example.test/form"));
++  }
++
++  void SetLoading(bool loading) {
++    content::WebContentsTester::For(web_contents())->TestSetIsLoading(loading);
++  }
++
++  SettleOptions options_;
++  base::test::TestFuture<const PageChanges&> result_;
++};
++
++// =============================================================================
++// Settle Tests
++// =============================================================================
++
++TEST_F(BrowserOSChangeDetectorTest, QuietPageSettlesAfterQuietPeriod) {
++  BrowserOSChangeDetector::WaitForSettle(web_contents(), options_,
++                                         result_.GetCallback());
++  EXPECT_FALSE(result_.IsReady());
++
++  task_environment()->FastForwardBy(options_.quiet_period);
++  ASSERT_TRUE(result_.IsReady());
++  EXPECT_TRUE(result_.Get().settled);
++  EXPECT_EQ(options_.quiet_period, result_.Get().elapsed);
++}
++
++TEST_F(BrowserOSChangeDetectorTest, SettlesOnceLoadStops) {
++  SetLoading(true);
++  BrowserOSChangeDetector::WaitForSettle(web_contents(), options_,
++                                         result_.GetCallback());
++
++  // The quiet period lapses during the load without settling the page
++  task_environment()->FastForwardBy(options_.quiet_period * 3);
++  EXPECT_FALSE(result_.IsReady());
++
++  SetLoading(false);
++  task_environment()->FastForwardBy(options_.quiet_period);
++  ASSERT_TRUE(result_.IsReady());
++  EXPECT_TRUE(result_.Get().settled);
++  EXPECT_EQ(options_.quiet_period * 4, result_.Get().elapsed);
++}
++
++TEST_F(BrowserOSChangeDetectorTest, EndlessLoadHitsMaxWait) {
++  SetLoading(true);
++  BrowserOSChangeDetector::WaitForSettle(web_contents(), options_,
++                                         result_.GetCallback());
++
++  task_environment()->FastForwardBy(options_.max_wait);
++  ASSERT_TRUE(result_.IsReady());
++  EXPECT_FALSE(result_.Get().settled);
++  EXPECT_EQ(options_.max_wait, result_.Get().elapsed);
++}
++
++// =============================================================================
++// Change Detection Tests
++// =============================================================================
++
++TEST_F(BrowserOSChangeDetectorTest, ActionWithoutEffectReportsNoChange) {
++  BrowserOSChangeDetector::ExecuteWithDetectionAsync(
++      web_contents(), [] {}, result_.GetCallback(), options_);
++
++  task_environment()->FastForwardBy(options_.change_timeout);
++  ASSERT_TRUE(result_.IsReady());
++  EXPECT_FALSE(result_.Get().any());
++  EXPECT_TRUE(result_.Get().settled);
++}
++
++TEST_F(BrowserOSChangeDetectorTest, LoadStartedByActionIsAChange) {
++  BrowserOSChangeDetector::ExecuteWithDetectionAsync(
++      web_contents(), [this] { SetLoading(true); }, result_.GetCallback(),
++      options_);
++  task_environment()->FastForwardBy(options_.change_timeout);
++  EXPECT_FALSE(result_.IsReady());
++
++  SetLoading(false);
++  task_environment()->FastForwardBy(options_.quiet_period);
++  ASSERT_TRUE(result_.IsReady());
++  EXPECT_TRUE(result_.Get().load_started);
++  EXPECT_TRUE(result_.Get().settled);
++}
++
++TEST_F(BrowserOSChangeDetectorTest, DestroyedTabFinishesUnsettled) {
++  SetLoading(true);
++  BrowserOSChangeDetector::WaitForSettle(web_contents(), options_,
++                                         result_.GetCallback());
++
++  DeleteContents();
++  ASSERT_TRUE(result_.IsReady());
++  EXPECT_FALSE(result_.Get().settled);
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
@@ -1,9 +1,9 @@
 diff --git a/chrome/browser/extensions/api/browser_os/browser_os_content_processor.cc b/chrome/browser/extensions/api/browser_os/browser_os_content_processor.cc
 new file mode 100644
-index 0000000000000..4166f1a38737c
+index 0000000000000..2c08175328abc
 --- /dev/null
 +++ b/chrome/browser/extensions/api/browser_os/browser_os_content_processor.cc
-@@ -0,0 +1,247 @@
+@@ -0,0 +1,651 @@
 +// Copyright 2024 The Chromium Authors
 +// Use of this source code is governed by a BSD-style license that can be
 +// found in the LICENSE file.
@@ -11,9 +11,21 @@ index 0000000000000..4166f1a38737c
 +#include "chrome/browser/extensions/api/browser_os/browser_os_content_processor.h"
 +
 +#include <algorithm>
++#include <iterator>
++#include <string_view>
++#include <utility>
 +
++#include "base/check_op.h"
++#include "base/functional/bind.h"
 +#include "base/logging.h"
++#include "base/notreached.h"
++#include "base/memory/ref_counted.h"
 +#include "base/strings/string_util.h"
++#include "base/task/task_traits.h"
++#include "base/time/time.h"
++#include "chrome/browser/browseros/core/browseros_text_util.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_index.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_parallel_for.h"
 +#include "ui/accessibility/ax_enum_util.h"
 +#include "ui/accessibility/ax_enums.mojom.h"
 +#include "ui/accessibility/ax_node_data.h"
@@ -27,29 +39,182 @@ index 0000000000000..4166f1a38737c
 +namespace {
 +
 +// Clean whitespace from text
-+std::string CleanText(const std::string& text) {
-+  std::string cleaned = std::string(base::TrimWhitespaceASCII(text, base::TRIM_ALL));
-+
-+  // Replace multiple spaces with single space
-+  std::string result;
-+  bool prev_space = false;
-+  for (char c : cleaned) {
-+    if (std::isspace(c)) {
-+      if (!prev_space) {
-+        result += ' ';
-+        prev_space = true;
-+      }
-+    } else {
-+      result += c;
-+      prev_space = false;
-+    }
++std::string CleanText(std::string text) {
++  browseros::CollapseWhitespace(text);
++  return text;
++}
++
++// Heading level from the hierarchical level attribute, 2 if not specified
++int HeadingLevel(const ui::AXNodeData& node) {
++  if (node.HasIntAttribute(ax::mojom::IntAttribute::kHierarchicalLevel)) {
++    int level =
++        node.GetIntAttribute(ax::mojom::IntAttribute::kHierarchicalLevel);
++    return std::clamp(level, 1, 6);
 +  }
++  return 2;
++}
++
++// Separators between rendered pieces of text, weakest first. Breaks that are
++// requested back to back collapse into the strongest one.
++enum class Break { kNone, kSpace, kLine, kParagraph };
++
++std::string_view BreakText(Break separator) {
++  switch (separator) {
++    case Break::kNone:
++      return "";
++    case Break::kSpace:
++      return " ";
++    case Break::kLine:
++      return "\n";
++    case Break::kParagraph:
++      return "\n\n";
++  }
++  NOTREACHED();
++}
++
++// Break around a container, on entering and on leaving it
++Break BlockBreak(const ui::AXNodeData& node) {
++  if (node.IsIgnored()) {
++    return Break::kNone;
++  }
++  switch (node.role) {
++    case ax::mojom::Role::kArticle:
++    case ax::mojom::Role::kBanner:
++    case ax::mojom::Role::kBlockquote:
++    case ax::mojom::Role::kComplementary:
++    case ax::mojom::Role::kContentInfo:
++    case ax::mojom::Role::kFigure:
++    case ax::mojom::Role::kForm:
++    case ax::mojom::Role::kList:
++    case ax::mojom::Role::kMain:
++    case ax::mojom::Role::kNavigation:
++    case ax::mojom::Role::kParagraph:
++    case ax::mojom::Role::kRegion:
++    case ax::mojom::Role::kSection:
++    case ax::mojom::Role::kTable:
++      return Break::kParagraph;
++    case ax::mojom::Role::kListItem:
++    case ax::mojom::Role::kRow:
++      return Break::kLine;
++    default:
++      return Break::kNone;
++  }
++}
 +
-+  return result;
++bool IsListItem(const ui::AXNodeData& node) {
++  return !node.IsIgnored() && node.role == ax::mojom::Role::kListItem;
++}
++
++// List nesting depth of the children of |node|
++int ChildListDepth(const ui::AXNodeData& node, int list_depth) {
++  return !node.IsIgnored() && node.role == ax::mojom::Role::kList
++             ? list_depth + 1
++             : list_depth;
 +}
 +
 +}  // namespace
 +
++ContentResult::ContentResult() = default;
++ContentResult::ContentResult(ContentResult&&) = default;
++ContentResult& ContentResult::operator=(ContentResult&&) = default;
++ContentResult::~ContentResult() = default;
++
++// Root of a part of the tree that is extracted on its own, with the breaks
++// its split ancestors request around it.
++struct ContentProcessor::Subtree {
++  int32_t root_id = ui::kInvalidAXNodeID;
++  int list_depth = 0;
++  Break before = Break::kNone;
++  Break after = Break::kNone;
++};
++
++// Accumulates markdown or plain text up to a character budget. Breaks are
++// only written once text follows them, so output never starts or ends with
++// separators. A writer that holds one subtree's output keeps its leading
++// and trailing breaks for the writer it is appended to.
++class ContentProcessor::TextWriter {
++ public:
++  TextWriter(ContentFormat format, size_t max_chars)
++      : format_(format), max_chars_(max_chars) {}
++
++  ContentFormat format() const { return format_; }
++
++  // True once text was cut at the budget
++  bool full() const { return full_; }
++
++  void RequestBreak(Break separator) {
++    pending_ = std::max(pending_, separator);
++  }
++
++  // Writes the pending break, then |text|
++  void Write(std::string_view text) {
++    if (full_ || text.empty()) {
++      return;
++    }
++    if (out_.empty()) {
++      leading_ = std::max(leading_, pending_);
++    } else {
++      AppendWithinBudget(BreakText(pending_));
++    }
++    pending_ = Break::kNone;
++    AppendWithinBudget(text);
++  }
++
++  // Appends the output of a writer that covered the following subtree
++  void Append(TextWriter&& other) {
++    RequestBreak(other.leading_);
++    Write(other.out_);
++    RequestBreak(other.pending_);
++    full_ = full_ || other.full_;
++  }
++
++  std::string Take() { return std::move(out_); }
++
++ private:
++  // Appends as much of |text| as fits, never splitting a UTF-8 sequence
++  void AppendWithinBudget(std::string_view text) {
++    size_t end = 0;
++    for (; end < text.size(); ++end) {
++      if ((static_cast<unsigned char>(text[end]) & 0xC0) == 0x80) {
++        continue;
++      }
++      if (chars_ == max_chars_) {
++        full_ = true;
++        break;
++      }
++      ++chars_;
++    }
++    out_.append(text.substr(0, end));
++  }
++
++  const ContentFormat format_;
++  const size_t max_chars_;
++  std::string out_;
++  size_t chars_ = 0;
++  Break leading_ = Break::kNone;
++  Break pending_ = Break::kNone;
++  bool full_ = false;
++};
++
++// Shared by the workers of one ExtractPageContentAsync call. Worker ranges
++// only write the slots of their own subtrees.
++struct ContentProcessor::ExtractionWork
++    : public base::RefCountedThreadSafe<ExtractionWork> {
++  scoped_refptr<const SnapshotNodeIndex> node_index;
++  ContentOptions options;
++  // Subtrees in document order, and the output of each: items or text
++  // depending on the format
++  std::vector<Subtree> subtrees;
++  std::vector<std::vector<browser_os::ContentItem>> item_slots;
++  std::vector<TextWriter> text_slots;
++  base::TimeTicks start_time;
++  ContentCallback callback;
++
++ private:
++  friend class base::RefCountedThreadSafe<ExtractionWork>;
++  ~ExtractionWork() = default;
++};
++
 +// static
 +std::vector<browser_os::ContentItem> ContentProcessor::ExtractPageContent(
 +    const ui::AXTreeUpdate& tree_update) {
@@ -63,14 +228,9 @@ index 0000000000000..4166f1a38737c
 +
 +  LOG(INFO) << "browseros: ExtractPageContent - processing " << tree_update.nodes.size() << " nodes";
 +
-+  // Build node map for O(1) lookup
-+  std::unordered_map<int32_t, ui::AXNodeData> node_map;
-+  for (const auto& node : tree_update.nodes) {
-+    node_map[node.id] = node;
-+  }
-+
-+  // Start DFS from root
-+  TraverseDFS(tree_update.root_id, node_map, items);
++  scoped_refptr<const SnapshotNodeIndex> index =
++      SnapshotNodeIndex::Create(tree_update);
++  ExtractSubtree(*index, index->root_id(), items);
 +
 +  LOG(INFO) << "browseros: ExtractPageContent - extracted " << items.size() << " items";
 +
@@ -78,29 +238,239 @@ index 0000000000000..4166f1a38737c
 +}
 +
 +// static
-+void ContentProcessor::TraverseDFS(
-+    int32_t node_id,
-+    const std::unordered_map<int32_t, ui::AXNodeData>& node_map,
-+    std::vector<browser_os::ContentItem>& items) {
++std::string ContentProcessor::ExtractPageText(
++    const ui::AXTreeUpdate& tree_update,
++    ContentFormat format,
++    size_t max_chars,
++    bool* truncated) {
++  DCHECK_NE(format, ContentFormat::kItems);
++  *truncated = false;
++  if (tree_update.nodes.empty()) {
++    return std::string();
++  }
 +
-+  auto it = node_map.find(node_id);
-+  if (it == node_map.end()) {
++  scoped_refptr<const SnapshotNodeIndex> index =
++      SnapshotNodeIndex::Create(tree_update);
++  TextWriter writer(format, max_chars);
++  Subtree root;
++  root.root_id = index->root_id();
++  RenderSubtree(*index, root, writer);
++  *truncated = writer.full();
++  return writer.Take();
++}
++
++// static
++void ContentProcessor::ExtractPageContentAsync(ui::AXTreeUpdate tree_update,
++                                               const ContentOptions& options,
++                                               ContentCallback callback) {
++  if (tree_update.nodes.empty()) {
++    LOG(INFO) << "browseros: ExtractPageContent - tree is empty";
++    std::move(callback).Run(ContentResult());
 +    return;
 +  }
 +
-+  const ui::AXNodeData& node = it->second;
++  auto work = base::MakeRefCounted<ExtractionWork>();
++  work->start_time = base::TimeTicks::Now();
++  work->options = options;
++  work->node_index = SnapshotNodeIndex::Create(std::move(tree_update));
++  work->subtrees = SplitIntoSubtrees(*work->node_index);
++  if (options.format == ContentFormat::kItems) {
++    work->item_slots.resize(work->subtrees.size());
++  } else {
++    // Each slot gets the whole budget: any one subtree may come first
++    work->text_slots.reserve(work->subtrees.size());
++    for (size_t i = 0; i < work->subtrees.size(); ++i) {
++      work->text_slots.emplace_back(options.format, options.max_chars);
++    }
++  }
++  work->callback = std::move(callback);
++
++  // One subtree per range: subtrees differ a lot in size, so workers should
++  // claim them one at a time
++  const size_t subtree_count = work->subtrees.size();
++  ParallelFor(subtree_count, /*min_range=*/1,
++              base::TaskPriority::USER_VISIBLE,
++              base::BindRepeating(&ContentProcessor::ExtractRange, work),
++              base::RepeatingCallback<void(size_t, size_t)>(),
++              base::BindOnce(&ContentProcessor::OnAllExtracted, work));
++}
++
++// static
++std::vector<ContentProcessor::Subtree> ContentProcessor::SplitIntoSubtrees(
++    const SnapshotNodeIndex& index) {
++  Subtree root;
++  root.root_id = index.root_id();
++  std::vector<Subtree> subtrees = {root};
++  // Each pass replaces the containers of the previous level by their
++  // children, keeping everything in document order. Stops at a level that
++  // would exceed kMaxSubtrees or has nothing left to split.
++  while (subtrees.size() < kMaxSubtrees) {
++    std::vector<Subtree> next;
++    bool split = false;
++    for (const Subtree& subtree : subtrees) {
++      const ui::AXNodeData* node = index.Find(subtree.root_id);
++      if (!node || !IsContainer(*node) || node->child_ids.empty() ||
++          IsListItem(*node)) {
++        next.push_back(subtree);
++        continue;
++      }
++      const Break block = BlockBreak(*node);
++      const size_t first = next.size();
++      for (int32_t child_id : node->child_ids) {
++        Subtree child;
++        child.root_id = child_id;
++        child.list_depth = ChildListDepth(*node, subtree.list_depth);
++        next.push_back(child);
++      }
++      next[first].before = std::max(subtree.before, block);
++      next.back().after = std::max(subtree.after, block);
++      split = true;
++    }
++    if (!split || next.size() > kMaxSubtrees) {
++      break;
++    }
++    subtrees = std::move(next);
++  }
++  return subtrees;
++}
 +
-+  // Skip extracting from ignored nodes, but still recurse to children
-+  if (node.IsIgnored()) {
-+    for (int32_t child_id : node.child_ids) {
-+      TraverseDFS(child_id, node_map, items);
++// static
++void ContentProcessor::ExtractSubtree(
++    const SnapshotNodeIndex& index,
++    int32_t root_id,
++    std::vector<browser_os::ContentItem>& items) {
++  // Children are pushed in reverse so they pop in document order. An
++  // explicit stack keeps deeply nested pages from overflowing a worker's
++  // stack.
++  std::vector<int32_t> stack = {root_id};
++  while (!stack.empty()) {
++    const ui::AXNodeData* node = index.Find(stack.back());
++    stack.pop_back();
++    if (!node) {
++      continue;
 +    }
-+    return;
++    if (!IsContainer(*node)) {
++      ExtractNode(*node, items);
++      continue;
++    }
++    stack.insert(stack.end(), node->child_ids.rbegin(),
++                 node->child_ids.rend());
 +  }
++}
++
++// static
++void ContentProcessor::RenderSubtree(const SnapshotNodeIndex& index,
++                                     const Subtree& subtree,
++                                     TextWriter& writer) {
++  // As in ExtractSubtree, plus an exit entry for containers that request a
++  // break after their content
++  struct Entry {
++    int32_t id;
++    int list_depth;
++    bool exit;
++  };
++  std::vector<Entry> stack = {{subtree.root_id, subtree.list_depth, false}};
++  writer.RequestBreak(subtree.before);
++  while (!stack.empty() && !writer.full()) {
++    const Entry entry = stack.back();
++    stack.pop_back();
++    const ui::AXNodeData* node = index.Find(entry.id);
++    if (!node) {
++      continue;
++    }
++    if (entry.exit) {
++      writer.RequestBreak(BlockBreak(*node));
++      continue;
++    }
++    if (!IsContainer(*node)) {
++      RenderNode(*node, writer);
++      continue;
++    }
++
++    const Break block = BlockBreak(*node);
++    writer.RequestBreak(block);
++    if (IsListItem(*node) && writer.format() == ContentFormat::kMarkdown) {
++      writer.Write(std::string(2 * std::max(entry.list_depth - 1, 0), ' ') +
++                   "-");
++    }
++    if (block != Break::kNone) {
++      stack.push_back({entry.id, entry.list_depth, true});
++    }
++    const int child_depth = ChildListDepth(*node, entry.list_depth);
++    for (auto it = node->child_ids.rbegin(); it != node->child_ids.rend();
++         ++it) {
++      stack.push_back({*it, child_depth, false});
++    }
++  }
++  writer.RequestBreak(subtree.after);
++}
++
++// static
++void ContentProcessor::ExtractRange(scoped_refptr<ExtractionWork> work,
++                                    size_t begin,
++                                    size_t end) {
++  for (size_t i = begin; i < end; ++i) {
++    if (work->options.format == ContentFormat::kItems) {
++      ExtractSubtree(*work->node_index, work->subtrees[i].root_id,
++                     work->item_slots[i]);
++    } else {
++      RenderSubtree(*work->node_index, work->subtrees[i],
++                    work->text_slots[i]);
++    }
++  }
++}
 +
-+  // Extract content at semantic boundaries
-+  // Don't recurse into these - their children are just formatting
++// static
++void ContentProcessor::OnAllExtracted(scoped_refptr<ExtractionWork> work) {
++  ContentResult result;
++  if (work->options.format == ContentFormat::kItems) {
++    size_t total = 0;
++    for (const auto& slot : work->item_slots) {
++      total += slot.size();
++    }
++    result.items.reserve(total);
++    for (auto& slot : work->item_slots) {
++      std::move(slot.begin(), slot.end(), std::back_inserter(result.items));
++    }
++  } else {
++    TextWriter writer(work->options.format, work->options.max_chars);
++    for (TextWriter& slot : work->text_slots) {
++      writer.Append(std::move(slot));
++      if (writer.full()) {
++        break;
++      }
++    }
++    result.truncated = writer.full();
++    result.content = writer.Take();
++  }
++
++  LOG(INFO) << "browseros: ExtractPageContent - extracted "
++            << result.items.size() << " items, " << result.content.size()
++            << " bytes of text from " << work->node_index->size()
++            << " nodes in " << work->subtrees.size() << " subtrees in "
++            << (base::TimeTicks::Now() - work->start_time).InMilliseconds()
++            << " ms";
++
++  std::move(work->callback).Run(std::move(result));
++}
++
++// static
++bool ContentProcessor::IsContainer(const ui::AXNodeData& node) {
++  // Ignored nodes are not extracted but their children still are. Headings,
++  // links, images, videos and text are semantic boundaries whose children
++  // are just formatting.
++  if (node.IsIgnored()) {
++    return true;
++  }
++  return !ui::IsHeading(node.role) && !ui::IsLink(node.role) &&
++         !ui::IsImage(node.role) && node.role != ax::mojom::Role::kVideo &&
++         !ui::IsText(node.role);
++}
 +
++// static
++void ContentProcessor::ExtractNode(
++    const ui::AXNodeData& node,
++    std::vector<browser_os::ContentItem>& items) {
 +  if (ui::IsHeading(node.role)) {
 +    items.push_back(ExtractHeading(node));
 +    return;
@@ -127,12 +497,53 @@ index 0000000000000..4166f1a38737c
 +    if (item.text.has_value() && !item.text->empty()) {
 +      items.push_back(std::move(item));
 +    }
++  }
++}
++
++// static
++void ContentProcessor::RenderNode(const ui::AXNodeData& node,
++                                  TextWriter& writer) {
++  const bool markdown = writer.format() == ContentFormat::kMarkdown;
++  const std::string name = CleanText(GetAccessibleName(node));
++  if (name.empty()) {
++    return;
++  }
++  const std::string& url =
++      node.GetStringAttribute(ax::mojom::StringAttribute::kUrl);
++
++  if (ui::IsHeading(node.role)) {
++    writer.RequestBreak(Break::kParagraph);
++    writer.Write(markdown ? std::string(HeadingLevel(node), '#') + " " + name
++                          : name);
++    writer.RequestBreak(Break::kParagraph);
++    return;
++  }
++
++  writer.RequestBreak(Break::kSpace);
++
++  if (ui::IsLink(node.role)) {
++    writer.Write(markdown && !url.empty() ? "[" + name + "](" + url + ")"
++                                          : name);
 +    return;
 +  }
 +
-+  // For container nodes (divs, sections, etc.), recurse to children
-+  for (int32_t child_id : node.child_ids) {
-+    TraverseDFS(child_id, node_map, items);
++  // Data URLs are left out: they can be megabytes of base64
++  const bool has_url = markdown && !url.empty() &&
++                       !base::StartsWith(url, "data:");
++  if (ui::IsImage(node.role)) {
++    writer.Write(has_url ? "![" + name + "](" + url + ")"
++                         : "[Image: " + name + "]");
++    return;
++  }
++
++  if (node.role == ax::mojom::Role::kVideo) {
++    writer.Write(has_url ? "[Video: " + name + "](" + url + ")"
++                         : "[Video: " + name + "]");
++    return;
++  }
++
++  if (ui::IsText(node.role)) {
++    writer.Write(name);
 +  }
 +}
 +
@@ -144,17 +555,10 @@ index 0000000000000..4166f1a38737c
 +
 +  std::string name = GetAccessibleName(node);
 +  if (!name.empty()) {
-+    item.text = CleanText(name);
++    item.text = CleanText(std::move(name));
 +  }
 +
-+  // Get heading level from hierarchical level attribute
-+  if (node.HasIntAttribute(ax::mojom::IntAttribute::kHierarchicalLevel)) {
-+    int level = node.GetIntAttribute(ax::mojom::IntAttribute::kHierarchicalLevel);
-+    item.level = std::clamp(level, 1, 6);
-+  } else {
-+    // Default to level 2 if not specified
-+    item.level = 2;
-+  }
++  item.level = HeadingLevel(node);
 +
 +  return item;
 +}
@@ -167,7 +571,7 @@ index 0000000000000..4166f1a38737c
 +
 +  std::string name = GetAccessibleName(node);
 +  if (!name.empty()) {
-+    item.text = CleanText(name);
++    item.text = CleanText(std::move(name));
 +  }
 +
 +  return item;
@@ -181,7 +585,7 @@ index 0000000000000..4166f1a38737c
 +
 +  std::string name = GetAccessibleName(node);
 +  if (!name.empty()) {
-+    item.text = CleanText(name);
++    item.text = CleanText(std::move(name));
 +  }
 +
 +  // Get URL from url attribute
@@ -201,7 +605,7 @@ index 0000000000000..4166f1a38737c
 +  // Get alt text from name
 +  std::string name = GetAccessibleName(node);
 +  if (!name.empty()) {
-+    item.alt = CleanText(name);
++    item.alt = CleanText(std::move(name));
 +  }
 +
 +  // Get image URL
@@ -223,7 +627,7 @@ index 0000000000000..4166f1a38737c
 +  // Get video title from name
 +  std::string name = GetAccessibleName(node);
 +  if (!name.empty()) {
-+    item.alt = CleanText(name);
++    item.alt = CleanText(std::move(name));
 +  }
 +
 +  // Get video URL
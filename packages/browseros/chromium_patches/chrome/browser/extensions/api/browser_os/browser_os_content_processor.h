@@ -1,9 +1,9 @@
 diff --git a/chrome/browser/extensions/api/browser_os/browser_os_content_processor.h b/chrome/browser/extensions/api/browser_os/browser_os_content_processor.h
 new file mode 100644
-index 0000000000000..472c7b114fe97
+index 0000000000000..e4320aa8750fd
 --- /dev/null
 +++ b/chrome/browser/extensions/api/browser_os/browser_os_content_processor.h
-@@ -0,0 +1,57 @@
+@@ -0,0 +1,148 @@
 +// Copyright 2024 The Chromium Authors
 +// Use of this source code is governed by a BSD-style license that can be
 +// found in the LICENSE file.
@@ -11,10 +11,14 @@ index 0000000000000..472c7b114fe97
 +#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_CONTENT_PROCESSOR_H_
 +#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_CONTENT_PROCESSOR_H_
 +
++#include <cstddef>
++#include <cstdint>
++#include <limits>
 +#include <string>
-+#include <unordered_map>
 +#include <vector>
 +
++#include "base/functional/callback.h"
++#include "base/memory/scoped_refptr.h"
 +#include "chrome/common/extensions/api/browser_os.h"
 +#include "ui/accessibility/ax_tree_update.h"
 +#include "ui/gfx/geometry/size.h"
@@ -26,10 +30,48 @@ index 0000000000000..472c7b114fe97
 +namespace extensions {
 +namespace api {
 +
++class SnapshotNodeIndex;
++
++// Output of getSnapshot
++enum class ContentFormat {
++  // One ContentItem per heading, text run, link, image and video
++  kItems,
++  // A single markdown string
++  kMarkdown,
++  // A single plain-text string
++  kText,
++};
++
++struct ContentOptions {
++  ContentFormat format = ContentFormat::kItems;
++  // Maximum length of the markdown or text output in characters (Unicode
++  // code points). Extraction stops once it is reached.
++  size_t max_chars = std::numeric_limits<size_t>::max();
++};
++
++struct ContentResult {
++  ContentResult();
++  ContentResult(ContentResult&&);
++  ContentResult& operator=(ContentResult&&);
++  ~ContentResult();
++
++  // Filled for ContentFormat::kItems
++  std::vector<browser_os::ContentItem> items;
++  // Filled for the string formats
++  std::string content;
++  // True if |content| was cut at max_chars
++  bool truncated = false;
++};
++
 +// Extracts page content (headings, text, links, images, videos) from
 +// accessibility tree in document order using depth-first traversal.
 +class ContentProcessor {
 + public:
++  using ContentCallback = base::OnceCallback<void(ContentResult)>;
++
++  // Upper bound on the subtrees extracted in parallel
++  static constexpr size_t kMaxSubtrees = 64;
++
 +  ContentProcessor() = delete;
 +  ContentProcessor(const ContentProcessor&) = delete;
 +  ContentProcessor& operator=(const ContentProcessor&) = delete;
@@ -39,12 +81,61 @@ index 0000000000000..472c7b114fe97
 +  static std::vector<browser_os::ContentItem> ExtractPageContent(
 +      const ui::AXTreeUpdate& tree_update);
 +
++  // Renders page content straight into a markdown or plain-text string in
++  // one pass, without building items. Sets |truncated| if the output was
++  // cut at |max_chars|.
++  static std::string ExtractPageText(const ui::AXTreeUpdate& tree_update,
++                                     ContentFormat format,
++                                     size_t max_chars,
++                                     bool* truncated);
++
++  // Same as above off the calling thread, in any format. The nodes are moved
++  // out of |tree_update| into a shared index, disjoint subtrees (main,
++  // article, aside...) are extracted in parallel on the thread pool, and
++  // |callback| gets their output concatenated in document order on the
++  // calling sequence.
++  static void ExtractPageContentAsync(ui::AXTreeUpdate tree_update,
++                                      const ContentOptions& options,
++                                      ContentCallback callback);
++
 + private:
-+  // DFS traversal to extract content in document order
-+  static void TraverseDFS(
-+      int32_t node_id,
-+      const std::unordered_map<int32_t, ui::AXNodeData>& node_map,
-+      std::vector<browser_os::ContentItem>& items);
++  struct ExtractionWork;
++  struct Subtree;
++  class TextWriter;
++
++  // Splits the tree below |index|'s root into at most kMaxSubtrees disjoint
++  // subtrees whose roots are in document order, by expanding containers
++  // breadth-first. Nodes that produce output of their own (items, list
++  // markers) are never split; the block breaks of split containers move to
++  // their first and last subtree.
++  static std::vector<Subtree> SplitIntoSubtrees(const SnapshotNodeIndex& index);
++
++  // Iterative DFS over the subtree at |root_id|, appending its content in
++  // document order
++  static void ExtractSubtree(const SnapshotNodeIndex& index,
++                             int32_t root_id,
++                             std::vector<browser_os::ContentItem>& items);
++
++  // Same as above, rendering into |writer| until it is full
++  static void RenderSubtree(const SnapshotNodeIndex& index,
++                            const Subtree& subtree,
++                            TextWriter& writer);
++
++  // Worker body and completion of ExtractPageContentAsync
++  static void ExtractRange(scoped_refptr<ExtractionWork> work,
++                           size_t begin,
++                           size_t end);
++  static void OnAllExtracted(scoped_refptr<ExtractionWork> work);
++
++  // Whether DFS descends into |node| rather than extracting it
++  static bool IsContainer(const ui::AXNodeData& node);
++
++  // Appends the item |node| produces, if any
++  static void ExtractNode(const ui::AXNodeData& node,
++                          std::vector<browser_os::ContentItem>& items);
++
++  // Renders the item |node| produces, if any
++  static void RenderNode(const ui::AXNodeData& node, TextWriter& writer);
 +
 +  // Content extraction helpers
 +  static browser_os::ContentItem ExtractHeading(const ui::AXNodeData& node);
@@ -0,0 +1,326 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_content_processor_unittest.cc b/chrome/browser/extensions/api/browser_os/browser_os_content_processor_unittest.cc
+new file mode 100644
+index 0000000000000..ace01d29366d9
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_content_processor_unittest.cc
+@@ -0,0 +1,320 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_content_processor.h"
++
++#include <limits>
++#include <optional>
++#include <string>
++#include <string_view>
++#include <utility>
++#include <vector>
++
++#include "base/functional/bind.h"
++#include "base/run_loop.h"
++#include "base/test/task_environment.h"
++#include "chrome/browser/extensions/api/browser_os/test/ax_tree_fixture.h"
++#include "testing/gtest/include/gtest/gtest.h"
++#include "ui/accessibility/ax_enums.mojom.h"
++#include "ui/accessibility/ax_node_data.h"
++#include "ui/accessibility/ax_tree_update.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++ui::AXNodeData MakeNode(int32_t id,
++                        ax::mojom::Role role,
++                        std::vector<int32_t> child_ids = {},
++                        const std::string& name = std::string()) {
++  ui::AXNodeData node;
++  node.id = id;
++  node.role = role;
++  node.child_ids = std::move(child_ids);
++  if (!name.empty()) {
++    node.AddStringAttribute(ax::mojom::StringAttribute::kName, name);
++  }
++  return node;
++}
++
++ContentResult ExtractAsync(ui::AXTreeUpdate update,
++                           const ContentOptions& options) {
++  ContentResult result;
++  base::RunLoop run_loop;
++  ContentProcessor::ExtractPageContentAsync(
++      std::move(update), options,
++      base::BindOnce(
++          [](ContentResult* out, base::OnceClosure quit,
++             ContentResult result) {
++            *out = std::move(result);
++            std::move(quit).Run();
++          },
++          &result, run_loop.QuitClosure()));
++  run_loop.Run();
++  return result;
++}
++
++std::vector<browser_os::ContentItem> ExtractAsync(ui::AXTreeUpdate update) {
++  return ExtractAsync(std::move(update), ContentOptions()).items;
++}
++
++ContentOptions TextOptions(
++    ContentFormat format,
++    size_t max_chars = std::numeric_limits<size_t>::max()) {
++  ContentOptions options;
++  options.format = format;
++  options.max_chars = max_chars;
++  return options;
++}
++
++// A main region with a heading, a paragraph with a link, a list and an image
++ui::AXTreeUpdate BuildArticleTreeUpdate() {
++  ui::AXTreeUpdate update;
++  update.root_id = 1;
++  update.nodes = {
++      MakeNode(1, ax::mojom::Role::kRootWebArea, {2}),
++      MakeNode(2, ax::mojom::Role::kMain, {3, 4, 7, 12}),
++      MakeNode(3, ax::mojom::Role::kHeading, {}, "Title"),
++      MakeNode(4, ax::mojom::Role::kParagraph, {5, 6}),
++      MakeNode(5, ax::mojom::Role::kStaticText, {}, "Hello  world"),
++      MakeNode(6, ax::mojom::Role::kLink, {}, "docs"),
++      MakeNode(7, ax::mojom::Role::kList, {8, 10}),
++      MakeNode(8, ax::mojom::Role::kListItem, {9}),
++      MakeNode(9, ax::mojom::Role::kStaticText, {}, "One"),
++      MakeNode(10, ax::mojom::Role::kListItem, {11}),
++      MakeNode(11, ax::mojom::Role::kStaticText, {}, "Two"),
++      MakeNode(12, ax::mojom::Role::kImage, {}, "Logo"),
++  };
++  update.nodes[2].AddIntAttribute(ax::mojom::IntAttribute::kHierarchicalLevel,
++                                  1);
++  update.nodes[5].AddStringAttribute(ax::mojom::StringAttribute::kUrl,
++                                     "https://example.test/docs");
++  update.nodes[11].AddStringAttribute(ax::mojom::StringAttribute::kUrl,
++                                      "https://example.test/logo.png");
++  return update;
++}
++
++std::vector<std::string> Texts(
++    const std::vector<browser_os::ContentItem>& items) {
++  std::vector<std::string> texts;
++  for (const auto& item : items) {
++    texts.push_back(item.text.value_or(item.alt.value_or(std::string())));
++  }
++  return texts;
++}
++
++class ContentProcessorTest : public testing::Test {
++ protected:
++  base::test::TaskEnvironment task_environment_;
++};
++
++// =============================================================================
++// Document Order Tests
++// =============================================================================
++
++TEST_F(ContentProcessorTest, ConcatenatesSubtreesInDocumentOrder) {
++  ui::AXTreeUpdate update;
++  update.root_id = 1;
++  update.nodes = {
++      MakeNode(1, ax::mojom::Role::kRootWebArea, {2, 3, 4}),
++      MakeNode(2, ax::mojom::Role::kMain, {5, 6}),
++      MakeNode(3, ax::mojom::Role::kArticle, {7}),
++      MakeNode(4, ax::mojom::Role::kComplementary, {8}),
++      MakeNode(5, ax::mojom::Role::kHeading, {9}, "Title"),
++      MakeNode(6, ax::mojom::Role::kStaticText, {}, "Intro"),
++      MakeNode(7, ax::mojom::Role::kLink, {}, "Read more"),
++      MakeNode(8, ax::mojom::Role::kStaticText, {}, "Aside"),
++      // Formatting inside the heading is not extracted on its own
++      MakeNode(9, ax::mojom::Role::kStaticText, {}, "Title"),
++  };
++
++  const std::vector<std::string> expected = {"Title", "Intro", "Read more",
++                                             "Aside"};
++  EXPECT_EQ(expected, Texts(ContentProcessor::ExtractPageContent(update)));
++  EXPECT_EQ(expected, Texts(ExtractAsync(update)));
++}
++
++TEST_F(ContentProcessorTest, ExtractsRootThatIsNotAContainer) {
++  ui::AXTreeUpdate update;
++  update.root_id = 1;
++  update.nodes = {MakeNode(1, ax::mojom::Role::kStaticText, {}, "Only")};
++
++  EXPECT_EQ(std::vector<std::string>{"Only"}, Texts(ExtractAsync(update)));
++  EXPECT_TRUE(ExtractAsync(ui::AXTreeUpdate()).empty());
++  EXPECT_EQ("Only",
++            ExtractAsync(update, TextOptions(ContentFormat::kText)).content);
++}
++
++// Nesting far deeper than a recursive traversal could handle on a worker
++// thread's stack
++TEST_F(ContentProcessorTest, HandlesDeeplyNestedTree) {
++  constexpr int32_t kDepth = 100000;
++  ui::AXTreeUpdate update;
++  update.root_id = 1;
++  for (int32_t id = 1; id < kDepth; ++id) {
++    update.nodes.push_back(
++        MakeNode(id, ax::mojom::Role::kGenericContainer, {id + 1}));
++  }
++  update.nodes.push_back(
++      MakeNode(kDepth, ax::mojom::Role::kStaticText, {}, "Deep"));
++
++  EXPECT_EQ(std::vector<std::string>{"Deep"},
++            Texts(ContentProcessor::ExtractPageContent(update)));
++  EXPECT_EQ(std::vector<std::string>{"Deep"}, Texts(ExtractAsync(update)));
++}
++
++// A wide page is split into many subtrees, which must not reorder it
++TEST_F(ContentProcessorTest, KeepsOrderOfManySubtrees) {
++  constexpr int32_t kSections = 500;
++  ui::AXTreeUpdate update;
++  update.root_id = 1;
++  ui::AXNodeData root = MakeNode(1, ax::mojom::Role::kRootWebArea);
++  std::vector<std::string> expected;
++  for (int32_t i = 0; i < kSections; ++i) {
++    const int32_t section_id = 2 + 2 * i;
++    root.child_ids.push_back(section_id);
++    update.nodes.push_back(
++        MakeNode(section_id, ax::mojom::Role::kSection, {section_id + 1}));
++    expected.push_back("Section " + std::to_string(i));
++    update.nodes.push_back(MakeNode(
++        section_id + 1, ax::mojom::Role::kStaticText, {}, expected.back()));
++  }
++  update.nodes.insert(update.nodes.begin(), std::move(root));
++
++  EXPECT_EQ(expected, Texts(ExtractAsync(update)));
++}
++
++// =============================================================================
++// Text Output Tests
++// =============================================================================
++
++TEST_F(ContentProcessorTest, RendersMarkdown) {
++  const std::string expected =
++      "# Title\n\n"
++      "Hello world [docs](https://example.test/docs)\n\n"
++      "- One\n"
++      "- Two\n\n"
++      "![Logo](https://example.test/logo.png)";
++  bool truncated = true;
++  EXPECT_EQ(expected, ContentProcessor::ExtractPageText(
++                          BuildArticleTreeUpdate(), ContentFormat::kMarkdown,
++                          std::numeric_limits<size_t>::max(), &truncated));
++  EXPECT_FALSE(truncated);
++
++  ContentResult result = ExtractAsync(BuildArticleTreeUpdate(),
++                                      TextOptions(ContentFormat::kMarkdown));
++  EXPECT_EQ(expected, result.content);
++  EXPECT_FALSE(result.truncated);
++  EXPECT_TRUE(result.items.empty());
++}
++
++TEST_F(ContentProcessorTest, RendersPlainText) {
++  EXPECT_EQ("Title\n\nHello world docs\n\nOne\nTwo\n\n[Image: Logo]",
++            ExtractAsync(BuildArticleTreeUpdate(),
++                         TextOptions(ContentFormat::kText))
++                .content);
++}
++
++TEST_F(ContentProcessorTest, IndentsNestedListItems) {
++  ui::AXTreeUpdate update;
++  update.root_id = 1;
++  update.nodes = {
++      MakeNode(1, ax::mojom::Role::kList, {2}),
++      MakeNode(2, ax::mojom::Role::kListItem, {3, 4}),
++      MakeNode(3, ax::mojom::Role::kStaticText, {}, "Outer"),
++      MakeNode(4, ax::mojom::Role::kList, {5}),
++      MakeNode(5, ax::mojom::Role::kListItem, {6}),
++      MakeNode(6, ax::mojom::Role::kStaticText, {}, "Inner"),
++  };
++
++  EXPECT_EQ("- Outer\n\n  - Inner",
++            ExtractAsync(update, TextOptions(ContentFormat::kMarkdown))
++                .content);
++}
++
++TEST_F(ContentProcessorTest, StopsAtCharacterBudget) {
++  ContentResult result = ExtractAsync(
++      BuildArticleTreeUpdate(), TextOptions(ContentFormat::kMarkdown, 10));
++  EXPECT_EQ("# Title\n\nH", result.content);
++  EXPECT_TRUE(result.truncated);
++
++  // Text that ends right at the budget is still cut if more follows
++  result = ExtractAsync(BuildArticleTreeUpdate(),
++                        TextOptions(ContentFormat::kText, 5));
++  EXPECT_EQ("Title", result.content);
++  EXPECT_TRUE(result.truncated);
++}
++
++TEST_F(ContentProcessorTest, BudgetCountsCharactersNotBytes) {
++  ui::AXTreeUpdate update;
++  update.root_id = 1;
++  update.nodes = {
++      MakeNode(1, ax::mojom::Role::kStaticText, {}, "h\u00e9llo w\u00f6rld")};
++
++  ContentResult result =
++      ExtractAsync(update, TextOptions(ContentFormat::kText, 2));
++  EXPECT_EQ("h\u00e9", result.content);
++  EXPECT_TRUE(result.truncated);
++
++  result = ExtractAsync(update, TextOptions(ContentFormat::kText, 11));
++  EXPECT_EQ("h\u00e9llo w\u00f6rld", result.content);
++  EXPECT_FALSE(result.truncated);
++}
++
++// =============================================================================
++// Fixture Tests
++// =============================================================================
++
++class ContentProcessorFixtureTest
++    : public testing::TestWithParam<std::string_view> {
++ protected:
++  base::test::TaskEnvironment task_environment_;
++};
++
++TEST_P(ContentProcessorFixtureTest, ParallelMatchesSequential) {
++  std::optional<ui::AXTreeUpdate> update = test::LoadAXTreeFixture(GetParam());
++  ASSERT_TRUE(update) << GetParam();
++
++  std::vector<browser_os::ContentItem> sequential =
++      ContentProcessor::ExtractPageContent(*update);
++  std::vector<browser_os::ContentItem> parallel =
++      ExtractAsync(std::move(*update));
++
++  ASSERT_FALSE(sequential.empty());
++  ASSERT_EQ(sequential.size(), parallel.size());
++  for (size_t i = 0; i < sequential.size(); ++i) {
++    EXPECT_EQ(sequential[i].ToValue(), parallel[i].ToValue()) << i;
++  }
++}
++
++TEST_P(ContentProcessorFixtureTest, ParallelTextMatchesSequential) {
++  std::optional<ui::AXTreeUpdate> update = test::LoadAXTreeFixture(GetParam());
++  ASSERT_TRUE(update) << GetParam();
++
++  for (ContentFormat format : {ContentFormat::kMarkdown, ContentFormat::kText}) {
++    for (size_t max_chars : {size_t{500}, std::numeric_limits<size_t>::max()}) {
++      bool truncated = false;
++      std::string sequential = ContentProcessor::ExtractPageText(
++          *update, format, max_chars, &truncated);
++      ContentResult parallel =
++          ExtractAsync(*update, TextOptions(format, max_chars));
++
++      EXPECT_FALSE(sequential.empty());
++      EXPECT_EQ(sequential, parallel.content);
++      EXPECT_EQ(truncated, parallel.truncated);
++    }
++  }
++}
++
++INSTANTIATE_TEST_SUITE_P(All,
++                         ContentProcessorFixtureTest,
++                         testing::ValuesIn(std::begin(test::kAXTreeFixtures),
++                                           std::end(test::kAXTreeFixtures)),
++                         [](const auto& info) {
++                           return std::string(info.param);
++                         });
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
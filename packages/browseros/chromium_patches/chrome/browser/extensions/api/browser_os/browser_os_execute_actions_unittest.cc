@@ -0,0 +1,168 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_execute_actions_unittest.cc b/chrome/browser/extensions/api/browser_os/browser_os_execute_actions_unittest.cc
+new file mode 100644
+index 0000000000000..d756662c80c77
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_execute_actions_unittest.cc
+@@ -0,0 +1,162 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include <optional>
++#include <string>
++
++#include "base/memory/scoped_refptr.h"
++#include "base/strings/stringprintf.h"
++#include "base/values.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_api.h"
++#include "chrome/browser/extensions/extension_tab_util.h"
++#include "chrome/browser/ui/tabs/tab_strip_model.h"
++#include "chrome/test/base/browser_with_test_window_test.h"
++#include "extensions/browser/api_test_utils.h"
++#include "extensions/common/extension_builder.h"
++#include "testing/gtest/include/gtest/gtest.h"
++#include "url/gurl.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++class BrowserOSExecuteActionsTest : public BrowserWithTestWindowTest {
++ protected:
++  void SetUp() override {
++    BrowserWithTestWindowTest::SetUp();
++    AddTab(browser(), GURL("https://example.test/form"));
++    tab_id_ = ExtensionTabUtil::GetTabId(
++        browser()->tab_strip_model()->GetActiveWebContents());
++  }
++
++  // Runs executeActions on the test tab and returns its results list
++  base::Value::List Run(const std::string& actions,
++                        const std::string& options = "{}") {
++    auto function = base::MakeRefCounted<BrowserOSExecuteActionsFunction>();
++    function->set_extension(ExtensionBuilder("Test").Build());
++    std::optional<base::Value> result =
++        api_test_utils::RunFunctionAndReturnSingleResult(
++            function.get(),
++            base::StringPrintf("[%d, %s, %s]", tab_id_, actions.c_str(),
++                               options.c_str()),
++            profile());
++    if (!result || !result->is_dict()) {
++      ADD_FAILURE() << "executeActions returned no result";
++      return base::Value::List();
++    }
++    const base::Value::List* results = result->GetDict().FindList("results");
++    return results ? results->Clone() : base::Value::List();
++  }
++
++  static std::string ErrorOf(const base::Value& result) {
++    const std::string* error = result.GetDict().FindString("error");
++    return error ? *error : std::string();
++  }
++
++  static bool SucceededAt(const base::Value::List& results, size_t index) {
++    return results[index].GetDict().FindBool("success").value_or(false);
++  }
++
++  int tab_id_ = -1;
++};
++
++// =============================================================================
++// Ordering Tests
++// =============================================================================
++
++TEST_F(BrowserOSExecuteActionsTest, ReportsOneResultPerActionInOrder) {
++  base::Value::List results = Run(
++      R"([{"type": "sendKeys", "key": "Enter"},
++          {"type": "clear"},
++          {"type": "sendKeys", "key": "Bogus"},
++          {"type": "click", "nodeId": 999}])",
++      R"({"changeDetection": "final", "stopOnError": false})");
++
++  ASSERT_EQ(4u, results.size());
++  EXPECT_TRUE(SucceededAt(results, 0));
++  EXPECT_FALSE(SucceededAt(results, 1));
++  EXPECT_EQ("nodeId is required", ErrorOf(results[1]));
++  EXPECT_FALSE(SucceededAt(results, 2));
++  EXPECT_EQ("Unsupported key: Bogus", ErrorOf(results[2]));
++  EXPECT_FALSE(SucceededAt(results, 3));
++  EXPECT_FALSE(ErrorOf(results[3]).empty());
++}
++
++TEST_F(BrowserOSExecuteActionsTest, RejectsEmptyBatch) {
++  auto function = base::MakeRefCounted<BrowserOSExecuteActionsFunction>();
++  function->set_extension(ExtensionBuilder("Test").Build());
++  EXPECT_EQ("No actions given",
++            api_test_utils::RunFunctionAndReturnError(
++                function.get(), base::StringPrintf("[%d, []]", tab_id_),
++                profile()));
++}
++
++TEST_F(BrowserOSExecuteActionsTest, RejectsOversizedBatch) {
++  std::string actions = "[";
++  for (size_t i = 0; i <= BrowserOSExecuteActionsFunction::kMaxActions; ++i) {
++    actions += i ? R"(, {"type": "sendKeys", "key": "Tab"})"
++                 : R"({"type": "sendKeys", "key": "Tab"})";
++  }
++  actions += "]";
++
++  auto function = base::MakeRefCounted<BrowserOSExecuteActionsFunction>();
++  function->set_extension(ExtensionBuilder("Test").Build());
++  EXPECT_EQ(base::StringPrintf("At most %zu actions can be given, got %zu",
++                               BrowserOSExecuteActionsFunction::kMaxActions,
++                               BrowserOSExecuteActionsFunction::kMaxActions + 1),
++            api_test_utils::RunFunctionAndReturnError(
++                function.get(),
++                base::StringPrintf("[%d, %s]", tab_id_, actions.c_str()),
++                profile()));
++}
++
++// =============================================================================
++// Stop-On-Error Tests
++// =============================================================================
++
++TEST_F(BrowserOSExecuteActionsTest, StopsAtFirstFailureByDefault) {
++  base::Value::List results = Run(
++      R"([{"type": "sendKeys", "key": "Enter"},
++          {"type": "sendKeys", "key": "Bogus"},
++          {"type": "sendKeys", "key": "Tab"}])",
++      R"({"changeDetection": "final"})");
++
++  // The third action never runs
++  ASSERT_EQ(2u, results.size());
++  EXPECT_TRUE(SucceededAt(results, 0));
++  EXPECT_EQ("Unsupported key: Bogus", ErrorOf(results[1]));
++}
++
++TEST_F(BrowserOSExecuteActionsTest, ContinuesPastFailureWhenAsked) {
++  base::Value::List results = Run(
++      R"([{"type": "clear"},
++          {"type": "sendKeys", "key": "Enter"},
++          {"type": "clear"}])",
++      R"({"changeDetection": "final", "stopOnError": false})");
++
++  ASSERT_EQ(3u, results.size());
++  EXPECT_EQ("nodeId is required", ErrorOf(results[0]));
++  EXPECT_TRUE(SucceededAt(results, 1));
++  EXPECT_EQ("nodeId is required", ErrorOf(results[2]));
++}
++
++// Failing actions complete synchronously; a full batch of them must not
++// nest one stack frame per action
++TEST_F(BrowserOSExecuteActionsTest, RunsFullBatchOfSynchronousFailures) {
++  std::string actions = "[";
++  for (size_t i = 0; i < BrowserOSExecuteActionsFunction::kMaxActions; ++i) {
++    actions += i ? R"(, {"type": "clear"})" : R"({"type": "clear"})";
++  }
++  actions += "]";
++
++  base::Value::List results =
++      Run(actions, R"({"changeDetection": "final", "stopOnError": false})");
++
++  ASSERT_EQ(BrowserOSExecuteActionsFunction::kMaxActions, results.size());
++  EXPECT_EQ("nodeId is required", ErrorOf(results.back()));
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,251 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_fixture_perftest.cc b/chrome/browser/extensions/api/browser_os/browser_os_fixture_perftest.cc
+new file mode 100644
+index 0000000000000..45d167c9e2750
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_fixture_perftest.cc
+@@ -0,0 +1,245 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++// Latency and memory of each browser_os API path over the AX tree fixtures.
++// Reports p50/p99 wall time and peak heap growth per fixture, so regressions
++// show up in the perf dashboard before they reach the agents.
++
++#include <algorithm>
++#include <optional>
++#include <string>
++#include <string_view>
++#include <utility>
++#include <vector>
++
++#include "base/functional/bind.h"
++#include "base/functional/callback.h"
++#include "base/process/process_metrics.h"
++#include "base/run_loop.h"
++#include "base/test/task_environment.h"
++#include "base/time/time.h"
++#include "base/timer/elapsed_timer.h"
++#include "base/values.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_ax_serialization.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_content_processor.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor.h"
++#include "chrome/browser/extensions/api/browser_os/test/ax_tree_fixture.h"
++#include "testing/gtest/include/gtest/gtest.h"
++#include "testing/perf/perf_result_reporter.h"
++#include "ui/accessibility/ax_tree_update.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++constexpr int kWarmupRuns = 2;
++constexpr int kMeasuredRuns = 30;
++
++struct PathResult {
++  std::vector<base::TimeDelta> samples;
++  // Largest heap growth observed while a run's output was still alive
++  size_t peak_heap_bytes = 0;
++};
++
++size_t CurrentHeapBytes() {
++  return base::ProcessMetrics::CreateCurrentProcessMetrics()->GetMallocUsage();
++}
++
++// Runs |run| kWarmupRuns + kMeasuredRuns times. |run| returns once its output
++// is complete and hands it to the caller-side |keep_alive| so the heap is
++// sampled before the output is freed.
++PathResult Measure(
++    base::RepeatingCallback<void(base::OnceClosure keep_alive)> run) {
++  PathResult result;
++  for (int i = 0; i < kWarmupRuns + kMeasuredRuns; ++i) {
++    const size_t heap_before = CurrentHeapBytes();
++    size_t heap_after = heap_before;
++    base::ElapsedTimer timer;
++    run.Run(base::BindOnce(
++        [](size_t* heap_after) { *heap_after = CurrentHeapBytes(); },
++        &heap_after));
++    base::TimeDelta elapsed = timer.Elapsed();
++    if (i < kWarmupRuns) {
++      continue;
++    }
++    result.samples.push_back(elapsed);
++    if (heap_after > heap_before) {
++      result.peak_heap_bytes =
++          std::max(result.peak_heap_bytes, heap_after - heap_before);
++    }
++  }
++  return result;
++}
++
++// Nearest-rank percentile of |samples|, which is sorted in place.
++base::TimeDelta Percentile(std::vector<base::TimeDelta>& samples, int p) {
++  std::sort(samples.begin(), samples.end());
++  size_t rank = (samples.size() * p + 99) / 100;
++  return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
++}
++
++void Report(const std::string& fixture,
++            const std::string& path,
++            PathResult result) {
++  perf_test::PerfResultReporter reporter("BrowserOSApi." + path + ".",
++                                         fixture);
++  reporter.RegisterImportantMetric("p50", "ms");
++  reporter.RegisterImportantMetric("p99", "ms");
++  reporter.RegisterImportantMetric("peak_heap", "kb");
++  reporter.AddResult("p50", Percentile(result.samples, 50));
++  reporter.AddResult("p99", Percentile(result.samples, 99));
++  reporter.AddResult("peak_heap",
++                     static_cast<size_t>(result.peak_heap_bytes / 1024));
++}
++
++class BrowserOSFixturePerfTest
++    : public testing::TestWithParam<std::string_view> {
++ protected:
++  void SetUp() override {
++    std::optional<ui::AXTreeUpdate> update =
++        test::LoadAXTreeFixture(GetParam());
++    ASSERT_TRUE(update) << GetParam();
++    update_ = std::move(*update);
++  }
++
++  base::test::TaskEnvironment task_environment_;
++  ui::AXTreeUpdate update_;
++};
++
++TEST_P(BrowserOSFixturePerfTest, InteractiveSnapshot) {
++  Report(std::string(GetParam()), "InteractiveSnapshot",
++         Measure(base::BindRepeating(
++             [](const ui::AXTreeUpdate* update, base::OnceClosure keep_alive) {
++               base::RunLoop run_loop;
++               SnapshotProcessor::ProcessAccessibilityTree(
++                   *update, /*tab_id=*/1, /*snapshot_id=*/1,
++                   /*web_contents=*/nullptr, SnapshotOptions(),
++                   base::BindOnce(
++                       [](base::OnceClosure keep_alive, base::OnceClosure quit,
++                          SnapshotProcessingResult result) {
++                         std::move(keep_alive).Run();
++                         std::move(quit).Run();
++                       },
++                       std::move(keep_alive), run_loop.QuitClosure()));
++               run_loop.Run();
++             },
++             &update_)));
++}
++
++TEST_P(BrowserOSFixturePerfTest, ViewportSnapshot) {
++  Report(std::string(GetParam()), "ViewportSnapshot",
++         Measure(base::BindRepeating(
++             [](const ui::AXTreeUpdate* update, base::OnceClosure keep_alive) {
++               SnapshotOptions options;
++               options.viewport_only = true;
++               base::RunLoop run_loop;
++               SnapshotProcessor::ProcessAccessibilityTree(
++                   *update, /*tab_id=*/1, /*snapshot_id=*/1,
++                   /*web_contents=*/nullptr, options,
++                   base::BindOnce(
++                       [](base::OnceClosure keep_alive, base::OnceClosure quit,
++                          SnapshotProcessingResult result) {
++                         std::move(keep_alive).Run();
++                         std::move(quit).Run();
++                       },
++                       std::move(keep_alive), run_loop.QuitClosure()));
++               run_loop.Run();
++             },
++             &update_)));
++}
++
++TEST_P(BrowserOSFixturePerfTest, PageContent) {
++  Report(std::string(GetParam()), "PageContent",
++         Measure(base::BindRepeating(
++             [](const ui::AXTreeUpdate* update, base::OnceClosure keep_alive) {
++               auto items = ContentProcessor::ExtractPageContent(*update);
++               std::move(keep_alive).Run();
++             },
++             &update_)));
++}
++
++TEST_P(BrowserOSFixturePerfTest, PageContentParallel) {
++  Report(std::string(GetParam()), "PageContentParallel",
++         Measure(base::BindRepeating(
++             [](const ui::AXTreeUpdate* update, base::OnceClosure keep_alive) {
++               base::RunLoop run_loop;
++               ContentProcessor::ExtractPageContentAsync(
++                   *update, ContentOptions(),
++                   base::BindOnce(
++                       [](base::OnceClosure keep_alive, base::OnceClosure quit,
++                          ContentResult result) {
++                         std::move(keep_alive).Run();
++                         std::move(quit).Run();
++                       },
++                       std::move(keep_alive), run_loop.QuitClosure()));
++               run_loop.Run();
++             },
++             &update_)));
++}
++
++TEST_P(BrowserOSFixturePerfTest, PageContentMarkdown) {
++  Report(std::string(GetParam()), "PageContentMarkdown",
++         Measure(base::BindRepeating(
++             [](const ui::AXTreeUpdate* update, base::OnceClosure keep_alive) {
++               ContentOptions options;
++               options.format = ContentFormat::kMarkdown;
++               base::RunLoop run_loop;
++               ContentProcessor::ExtractPageContentAsync(
++                   *update, options,
++                   base::BindOnce(
++                       [](base::OnceClosure keep_alive, base::OnceClosure quit,
++                          ContentResult result) {
++                         std::move(keep_alive).Run();
++                         std::move(quit).Run();
++                       },
++                       std::move(keep_alive), run_loop.QuitClosure()));
++               run_loop.Run();
++             },
++             &update_)));
++}
++
++TEST_P(BrowserOSFixturePerfTest, AccessibilityTree) {
++  Report(std::string(GetParam()), "AccessibilityTree",
++         Measure(base::BindRepeating(
++             [](const ui::AXTreeUpdate* update, base::OnceClosure keep_alive) {
++               SerializedAXTree tree = SerializeAXTree(
++                   update->nodes, AXTreeFormat::kObject, base::TimeTicks());
++               std::move(keep_alive).Run();
++             },
++             &update_)));
++}
++
++TEST_P(BrowserOSFixturePerfTest, AccessibilityTreeJson) {
++  Report(std::string(GetParam()), "AccessibilityTreeJson",
++         Measure(base::BindRepeating(
++             [](const ui::AXTreeUpdate* update, base::OnceClosure keep_alive) {
++               SerializedAXTree tree = SerializeAXTree(
++                   update->nodes, AXTreeFormat::kJson, base::TimeTicks());
++               std::move(keep_alive).Run();
++             },
++             &update_)));
++}
++
++TEST_P(BrowserOSFixturePerfTest, AccessibilityTreeCompact) {
++  Report(std::string(GetParam()), "AccessibilityTreeCompact",
++         Measure(base::BindRepeating(
++             [](const ui::AXTreeUpdate* update, base::OnceClosure keep_alive) {
++               SerializedAXTree tree = SerializeAXTree(
++                   update->nodes, AXTreeFormat::kCompact, base::TimeTicks());
++               std::move(keep_alive).Run();
++             },
++             &update_)));
++}
++
++INSTANTIATE_TEST_SUITE_P(All,
++                         BrowserOSFixturePerfTest,
++                         testing::ValuesIn(std::begin(test::kAXTreeFixtures),
++                                           std::end(test::kAXTreeFixtures)),
++                         [](const auto& info) {
++                           return std::string(info.param);
++                         });
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,128 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_node_attributes.cc b/chrome/browser/extensions/api/browser_os/browser_os_node_attributes.cc
+new file mode 100644
+index 0000000000000..3d67300108136
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_node_attributes.cc
+@@ -0,0 +1,122 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_attributes.h"
++
++#include <algorithm>
++
++#include "base/notreached.h"
++#include "base/strings/string_number_conversions.h"
++#include "base/trace_event/memory_usage_estimator.h"
++#include "ui/accessibility/ax_enum_util.h"
++#include "ui/accessibility/ax_enums.mojom.h"
++
++namespace extensions {
++namespace api {
++
++namespace {
++
++auto FindSlot(const std::vector<std::pair<NodeAttribute, std::string>>& values,
++              NodeAttribute attribute) {
++  return std::lower_bound(
++      values.begin(), values.end(), attribute,
++      [](const auto& entry, NodeAttribute key) { return entry.first < key; });
++}
++
++}  // namespace
++
++const char* NodeAttributeName(NodeAttribute attribute) {
++  switch (attribute) {
++    case NodeAttribute::kValue:
++      return "value";
++    case NodeAttribute::kHtmlTag:
++      return "html-tag";
++    case NodeAttribute::kRoleDescription:
++      return "role-description";
++    case NodeAttribute::kInputType:
++      return "input-type";
++    case NodeAttribute::kTooltip:
++      return "tooltip";
++    case NodeAttribute::kPlaceholder:
++      return "placeholder";
++    case NodeAttribute::kDescription:
++      return "description";
++    case NodeAttribute::kCheckedState:
++      return "checked-state";
++    case NodeAttribute::kAutocomplete:
++      return "autocomplete";
++    case NodeAttribute::kId:
++      return "id";
++    case NodeAttribute::kClass:
++      return "class";
++    case NodeAttribute::kContext:
++      return "context";
++    case NodeAttribute::kPath:
++      return "path";
++  }
++  NOTREACHED();
++}
++
++NodeAttributes::NodeAttributes() = default;
++NodeAttributes::NodeAttributes(const NodeAttributes&) = default;
++NodeAttributes::NodeAttributes(NodeAttributes&&) = default;
++NodeAttributes& NodeAttributes::operator=(const NodeAttributes&) = default;
++NodeAttributes& NodeAttributes::operator=(NodeAttributes&&) = default;
++NodeAttributes::~NodeAttributes() = default;
++
++bool NodeAttributes::operator==(const NodeAttributes& other) const = default;
++
++void NodeAttributes::Set(NodeAttribute attribute, std::string value) {
++  auto it = FindSlot(values_, attribute);
++  if (it != values_.end() && it->first == attribute) {
++    values_[it - values_.begin()].second = std::move(value);
++    return;
++  }
++  values_.emplace(it, attribute, std::move(value));
++}
++
++const std::string* NodeAttributes::Find(NodeAttribute attribute) const {
++  auto it = FindSlot(values_, attribute);
++  if (it == values_.end() || it->first != attribute) {
++    return nullptr;
++  }
++  return &it->second;
++}
++
++std::optional<std::string_view> NodeAttributes::FindNonEmpty(
++    NodeAttribute attribute) const {
++  const std::string* value = Find(attribute);
++  if (!value || value->empty()) {
++    return std::nullopt;
++  }
++  return *value;
++}
++
++bool NodeAttributes::empty() const {
++  return !role_ && !depth_ && !in_viewport_ && values_.empty();
++}
++
++base::Value::Dict NodeAttributes::ToDict() const {
++  base::Value::Dict dict;
++  if (role_) {
++    dict.Set("role", ui::ToString(*role_));
++  }
++  for (const auto& [attribute, value] : values_) {
++    dict.Set(NodeAttributeName(attribute), value);
++  }
++  if (depth_) {
++    dict.Set("depth", base::NumberToString(*depth_));
++  }
++  if (in_viewport_) {
++    dict.Set("in_viewport", *in_viewport_ ? "true" : "false");
++  }
++  return dict;
++}
++
++size_t NodeAttributes::EstimateMemoryUsage() const {
++  return base::trace_event::EstimateMemoryUsage(values_);
++}
++
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,105 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_node_attributes.h b/chrome/browser/extensions/api/browser_os/browser_os_node_attributes.h
+new file mode 100644
+index 0000000000000..6042f4d5bb260
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_node_attributes.h
+@@ -0,0 +1,99 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_NODE_ATTRIBUTES_H_
++#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_NODE_ATTRIBUTES_H_
++
++#include <cstddef>
++#include <cstdint>
++#include <optional>
++#include <string>
++#include <string_view>
++#include <utility>
++#include <vector>
++
++#include "base/values.h"
++#include "ui/accessibility/ax_enums.mojom-forward.h"
++
++namespace extensions {
++namespace api {
++
++// String-valued attributes computed for an interactive node. The values are
++// the API keys returned by NodeAttributeName().
++enum class NodeAttribute : uint8_t {
++  kValue,
++  kHtmlTag,
++  kRoleDescription,
++  kInputType,
++  kTooltip,
++  kPlaceholder,
++  kDescription,
++  kCheckedState,
++  kAutocomplete,
++  kId,
++  kClass,
++  kContext,
++  kPath,
++  kMaxValue = kPath,
++};
++
++// API key of |attribute|, e.g. "html-tag".
++const char* NodeAttributeName(NodeAttribute attribute);
++
++// Fixed-schema attribute storage for ProcessedNode and NodeInfo.
++//
++// Role, depth and viewport state are stored typed. The remaining attributes
++// live in a small vector sorted by key that only holds the keys that are
++// actually set, and values short enough for the small-string buffer need no
++// heap allocation. Converted to a dictionary only at the API boundary.
++class NodeAttributes {
++ public:
++  NodeAttributes();
++  NodeAttributes(const NodeAttributes&);
++  NodeAttributes(NodeAttributes&&);
++  NodeAttributes& operator=(const NodeAttributes&);
++  NodeAttributes& operator=(NodeAttributes&&);
++  ~NodeAttributes();
++
++  bool operator==(const NodeAttributes& other) const;
++
++  // Replaces the value of |attribute|.
++  void Set(NodeAttribute attribute, std::string value);
++
++  // Returns the value of |attribute|, or nullptr if it is not set.
++  const std::string* Find(NodeAttribute attribute) const;
++
++  // Returns the value of |attribute| if set and non-empty.
++  std::optional<std::string_view> FindNonEmpty(NodeAttribute attribute) const;
++
++  void set_role(ax::mojom::Role role) { role_ = role; }
++  std::optional<ax::mojom::Role> role() const { return role_; }
++
++  void set_depth(int depth) { depth_ = depth; }
++  std::optional<int> depth() const { return depth_; }
++
++  void set_in_viewport(bool in_viewport) { in_viewport_ = in_viewport; }
++  std::optional<bool> in_viewport() const { return in_viewport_; }
++
++  bool empty() const;
++
++  // API representation. Every value is a string, matching the historical
++  // output ("depth": "3", "in_viewport": "true").
++  base::Value::Dict ToDict() const;
++
++  // Heap bytes owned by this object, excluding sizeof(*this).
++  size_t EstimateMemoryUsage() const;
++
++ private:
++  std::optional<ax::mojom::Role> role_;
++  std::optional<int> depth_;
++  std::optional<bool> in_viewport_;
++  // Sorted by key
++  std::vector<std::pair<NodeAttribute, std::string>> values_;
++};
++
++}  // namespace api
++}  // namespace extensions
++
++#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_NODE_ATTRIBUTES_H_
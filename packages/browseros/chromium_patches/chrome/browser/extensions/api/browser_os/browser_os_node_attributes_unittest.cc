@@ -0,0 +1,65 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_node_attributes_unittest.cc b/chrome/browser/extensions/api/browser_os/browser_os_node_attributes_unittest.cc
+new file mode 100644
+index 0000000000000..f84d1e280ff87
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_node_attributes_unittest.cc
+@@ -0,0 +1,59 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_attributes.h"
++
++#include "testing/gtest/include/gtest/gtest.h"
++#include "ui/accessibility/ax_enums.mojom.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++TEST(NodeAttributesTest, EmptyByDefault) {
++  NodeAttributes attributes;
++  EXPECT_TRUE(attributes.empty());
++  EXPECT_EQ(nullptr, attributes.Find(NodeAttribute::kId));
++  EXPECT_FALSE(attributes.role());
++  EXPECT_TRUE(attributes.ToDict().empty());
++}
++
++TEST(NodeAttributesTest, SetReplacesExistingValue) {
++  NodeAttributes attributes;
++  attributes.Set(NodeAttribute::kPath, "a > b");
++  attributes.Set(NodeAttribute::kId, "submit");
++  attributes.Set(NodeAttribute::kPath, "a > c");
++
++  ASSERT_TRUE(attributes.Find(NodeAttribute::kPath));
++  EXPECT_EQ("a > c", *attributes.Find(NodeAttribute::kPath));
++  EXPECT_EQ("submit", *attributes.Find(NodeAttribute::kId));
++  EXPECT_EQ(2u, attributes.ToDict().size());
++}
++
++TEST(NodeAttributesTest, FindNonEmptySkipsEmptyValues) {
++  NodeAttributes attributes;
++  attributes.Set(NodeAttribute::kClass, "");
++  EXPECT_TRUE(attributes.Find(NodeAttribute::kClass));
++  EXPECT_FALSE(attributes.FindNonEmpty(NodeAttribute::kClass));
++}
++
++// The API output must stay byte-compatible with the old string map.
++TEST(NodeAttributesTest, ToDictUsesStringValues) {
++  NodeAttributes attributes;
++  attributes.set_role(ax::mojom::Role::kButton);
++  attributes.set_depth(3);
++  attributes.set_in_viewport(false);
++  attributes.Set(NodeAttribute::kHtmlTag, "button");
++
++  base::Value::Dict dict = attributes.ToDict();
++  EXPECT_EQ(4u, dict.size());
++  EXPECT_EQ("button", *dict.FindString("role"));
++  EXPECT_EQ("3", *dict.FindString("depth"));
++  EXPECT_EQ("false", *dict.FindString("in_viewport"));
++  EXPECT_EQ("button", *dict.FindString("html-tag"));
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
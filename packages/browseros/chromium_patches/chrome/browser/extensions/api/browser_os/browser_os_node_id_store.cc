@@ -0,0 +1,338 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_node_id_store.cc b/chrome/browser/extensions/api/browser_os/browser_os_node_id_store.cc
+new file mode 100644
+index 0000000000000..2f9c1465a5193
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_node_id_store.cc
+@@ -0,0 +1,332 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_id_store.h"
++
++#include <algorithm>
++#include <iterator>
++#include <utility>
++
++#include "base/check_op.h"
++#include "base/logging.h"
++#include "base/strings/string_number_conversions.h"
++#include "content/public/browser/navigation_handle.h"
++#include "content/public/browser/web_contents.h"
++
++namespace extensions {
++namespace api {
++
++namespace {
++
++// Totals over all tabs. Stores are only used on the UI thread.
++size_t g_total_memory_usage = 0;
++size_t g_store_count = 0;
++
++// Heap bytes of one map entry: the entry itself, the hash node's links and
++// the computed attributes. Bucket arrays are left out.
++size_t EstimateNodeMemoryUsage(const NodeInfo& info) {
++  return sizeof(BrowserOSNodeIdStore::NodeMap::value_type) +
++         2 * sizeof(void*) + info.attributes.EstimateMemoryUsage();
++}
++
++}  // namespace
++
++uint32_t MakeNodeHandle(uint32_t tag, uint32_t index) {
++  DCHECK_LE(index, kMaxNodeIndex);
++  return ((tag & kMaxHandleTag) << kNodeIndexBits) | index;
++}
++
++BrowserOSNodeIdStore::Snapshot::Snapshot() = default;
++BrowserOSNodeIdStore::Snapshot::Snapshot(Snapshot&&) = default;
++BrowserOSNodeIdStore::Snapshot& BrowserOSNodeIdStore::Snapshot::operator=(
++    Snapshot&&) = default;
++BrowserOSNodeIdStore::Snapshot::~Snapshot() = default;
++
++BrowserOSNodeIdStore::BrowserOSNodeIdStore(content::WebContents* web_contents)
++    : content::WebContentsObserver(web_contents),
++      content::WebContentsUserData<BrowserOSNodeIdStore>(*web_contents) {
++  g_store_count++;
++}
++
++BrowserOSNodeIdStore::~BrowserOSNodeIdStore() {
++  Clear();
++  g_store_count--;
++}
++
++// static
++size_t BrowserOSNodeIdStore::GetTotalMemoryUsage() {
++  return g_total_memory_usage;
++}
++
++// static
++size_t BrowserOSNodeIdStore::GetStoreCount() {
++  return g_store_count;
++}
++
++uint32_t BrowserOSNodeIdStore::StartSnapshot(uint32_t snapshot_id) {
++  if (Snapshot* existing = FindAndTouch(snapshot_id)) {
++    RemoveMemory(existing->memory_usage);
++    existing->memory_usage = 0;
++    existing->nodes.clear();
++    existing->by_ax_node_id.clear();
++  } else {
++    Snapshot snapshot;
++    snapshot.id = snapshot_id;
++    snapshot.tag = next_tag_;
++    next_tag_ = next_tag_ == kMaxHandleTag ? 1 : next_tag_ + 1;
++
++    // The sequence wrapped: IDs of an older snapshot with this tag would
++    // name elements of the new one
++    auto stale = std::find_if(
++        snapshots_.begin(), snapshots_.end(),
++        [&snapshot](const Snapshot& s) { return s.tag == snapshot.tag; });
++    if (stale != snapshots_.end()) {
++      VLOG(1) << "[browseros] Evicting node mappings of snapshot "
++              << stale->id << ", whose handle tag " << stale->tag
++              << " is reused";
++      RemoveMemory(stale->memory_usage);
++      snapshots_.erase(stale);
++    }
++    snapshots_.push_front(std::move(snapshot));
++  }
++  current_snapshot_id_ = snapshot_id;
++  has_current_ = true;
++  Trim();
++  return snapshots_.front().tag;
++}
++
++uint32_t BrowserOSNodeIdStore::GetHandleTag(uint32_t snapshot_id) const {
++  for (const Snapshot& snapshot : snapshots_) {
++    if (snapshot.id == snapshot_id) {
++      return snapshot.tag;
++    }
++  }
++  return 0;
++}
++
++void BrowserOSNodeIdStore::AddNode(uint32_t snapshot_id,
++                                   uint32_t node_id,
++                                   NodeInfo info) {
++  auto it = std::find_if(
++      snapshots_.begin(), snapshots_.end(),
++      [snapshot_id](const Snapshot& s) { return s.id == snapshot_id; });
++  if (it == snapshots_.end()) {
++    return;
++  }
++  auto node_it = it->nodes.find(node_id);
++  if (node_it != it->nodes.end()) {
++    const size_t old_bytes = EstimateNodeMemoryUsage(node_it->second);
++    it->memory_usage -= old_bytes;
++    RemoveMemory(old_bytes);
++    it->nodes.erase(node_it);
++  }
++  const size_t bytes = EstimateNodeMemoryUsage(info);
++  it->nodes.emplace(node_id, std::move(info));
++  it->by_ax_node_id.clear();
++  it->memory_usage += bytes;
++  AddMemory(bytes);
++  if (memory_usage_ > kMaxMemoryBytes) {
++    Trim();
++  }
++}
++
++BrowserOSNodeIdStore::NodeMap BrowserOSNodeIdStore::TakeNodes(
++    uint32_t snapshot_id) {
++  Snapshot* snapshot = FindAndTouch(snapshot_id);
++  if (!snapshot) {
++    return NodeMap();
++  }
++  RemoveMemory(snapshot->memory_usage);
++  snapshot->memory_usage = 0;
++  snapshot->by_ax_node_id.clear();
++  return std::exchange(snapshot->nodes, NodeMap());
++}
++
++void BrowserOSNodeIdStore::ReplaceNodes(uint32_t snapshot_id, NodeMap nodes) {
++  Snapshot* snapshot = FindAndTouch(snapshot_id);
++  if (!snapshot) {
++    return;
++  }
++  RemoveMemory(snapshot->memory_usage);
++  snapshot->by_ax_node_id.clear();
++  snapshot->nodes = std::move(nodes);
++  snapshot->memory_usage = 0;
++  for (const auto& [id, node] : snapshot->nodes) {
++    snapshot->memory_usage += EstimateNodeMemoryUsage(node);
++  }
++  AddMemory(snapshot->memory_usage);
++  Trim();
++}
++
++const BrowserOSNodeIdStore::NodeMap* BrowserOSNodeIdStore::current_nodes()
++    const {
++  if (!has_current_) {
++    return nullptr;
++  }
++  for (const Snapshot& snapshot : snapshots_) {
++    if (snapshot.id == current_snapshot_id_) {
++      return &snapshot.nodes;
++    }
++  }
++  return nullptr;
++}
++
++const NodeInfo* BrowserOSNodeIdStore::Find(uint32_t node_id) {
++  if (!has_current_) {
++    return nullptr;
++  }
++  Snapshot* current = FindAndTouch(current_snapshot_id_);
++  if (!current) {
++    return nullptr;
++  }
++  auto it = current->nodes.find(node_id);
++  return it == current->nodes.end() ? nullptr : &it->second;
++}
++
++BrowserOSNodeIdStore::Resolution BrowserOSNodeIdStore::Resolve(
++    uint32_t node_id,
++    std::string* error) {
++  Resolution resolution;
++  Snapshot* current =
++      has_current_ ? FindAndTouch(current_snapshot_id_) : nullptr;
++  if (!current) {
++    *error = "No snapshot data for this tab";
++    return resolution;
++  }
++  auto it = current->nodes.find(node_id);
++  if (it != current->nodes.end()) {
++    resolution.node = &it->second;
++    resolution.node_id = node_id;
++    return resolution;
++  }
++
++  // Handles are unique across snapshots, so the newest older snapshot that
++  // knows the ID describes the element the agent meant
++  for (Snapshot& snapshot : snapshots_) {
++    if (&snapshot == current) {
++      continue;
++    }
++    auto old_it = snapshot.nodes.find(node_id);
++    if (old_it == snapshot.nodes.end()) {
++      continue;
++    }
++    const uint32_t current_id = FindByAXNode(*current, old_it->second);
++    if (!current_id) {
++      *error = "Node ID " + base::NumberToString(node_id) +
++               " is stale: the element is no longer on the page";
++      return resolution;
++    }
++    VLOG(1) << "[browseros] Remapped stale node ID " << node_id << " from "
++            << "snapshot " << snapshot.id << " to " << current_id;
++    resolution.node = &current->nodes.find(current_id)->second;
++    resolution.node_id = current_id;
++    resolution.remapped = true;
++    return resolution;
++  }
++
++  if (node_id >> kNodeIndexBits == current->tag) {
++    *error = "Node ID not found";
++  } else {
++    *error = "Node ID " + base::NumberToString(node_id) +
++             " is from a snapshot that is no longer retained; take a new "
++             "snapshot";
++  }
++  return resolution;
++}
++
++const BrowserOSNodeIdStore::NodeMap* BrowserOSNodeIdStore::FindSnapshot(
++    uint32_t snapshot_id) {
++  Snapshot* snapshot = FindAndTouch(snapshot_id);
++  return snapshot ? &snapshot->nodes : nullptr;
++}
++
++void BrowserOSNodeIdStore::Clear() {
++  RemoveMemory(memory_usage_);
++  snapshots_.clear();
++  has_current_ = false;
++}
++
++size_t BrowserOSNodeIdStore::node_count() const {
++  size_t count = 0;
++  for (const Snapshot& snapshot : snapshots_) {
++    count += snapshot.nodes.size();
++  }
++  return count;
++}
++
++void BrowserOSNodeIdStore::DidFinishNavigation(
++    content::NavigationHandle* navigation_handle) {
++  // Node IDs refer to elements of the old document
++  if (navigation_handle->HasCommitted() &&
++      navigation_handle->IsInPrimaryMainFrame() &&
++      !navigation_handle->IsSameDocument()) {
++    Clear();
++  }
++}
++
++BrowserOSNodeIdStore::Snapshot* BrowserOSNodeIdStore::FindAndTouch(
++    uint32_t snapshot_id) {
++  auto it = std::find_if(
++      snapshots_.begin(), snapshots_.end(),
++      [snapshot_id](const Snapshot& s) { return s.id == snapshot_id; });
++  if (it == snapshots_.end()) {
++    return nullptr;
++  }
++  snapshots_.splice(snapshots_.begin(), snapshots_, it);
++  return &snapshots_.front();
++}
++
++// static
++uint32_t BrowserOSNodeIdStore::FindByAXNode(Snapshot& snapshot,
++                                            const NodeInfo& info) {
++  if (snapshot.by_ax_node_id.empty()) {
++    snapshot.by_ax_node_id.reserve(snapshot.nodes.size());
++    for (const auto& [id, node] : snapshot.nodes) {
++      snapshot.by_ax_node_id.emplace(node.ax_node_id, id);
++    }
++  }
++  // AX node IDs are unique within a tree for the document's lifetime, and
++  // the store is cleared when the document changes
++  auto [begin, end] = snapshot.by_ax_node_id.equal_range(info.ax_node_id);
++  for (auto it = begin; it != end; ++it) {
++    if (snapshot.nodes.at(it->second).ax_tree_id == info.ax_tree_id) {
++      return it->second;
++    }
++  }
++  return 0;
++}
++
++void BrowserOSNodeIdStore::Trim() {
++  while (snapshots_.size() > kMaxSnapshots ||
++         (memory_usage_ > kMaxMemoryBytes && snapshots_.size() > 1)) {
++    auto victim = std::prev(snapshots_.end());
++    if (has_current_ && victim->id == current_snapshot_id_) {
++      if (victim == snapshots_.begin()) {
++        return;
++      }
++      victim = std::prev(victim);
++    }
++    VLOG(1) << "[browseros] Evicting node mappings of snapshot "
++            << victim->id << " (" << victim->nodes.size() << " nodes, "
++            << victim->memory_usage / 1024 << " KB)";
++    RemoveMemory(victim->memory_usage);
++    snapshots_.erase(victim);
++  }
++}
++
++void BrowserOSNodeIdStore::AddMemory(size_t bytes) {
++  memory_usage_ += bytes;
++  g_total_memory_usage += bytes;
++}
++
++void BrowserOSNodeIdStore::RemoveMemory(size_t bytes) {
++  DCHECK_GE(memory_usage_, bytes);
++  memory_usage_ -= bytes;
++  g_total_memory_usage -= bytes;
++}
++
++WEB_CONTENTS_USER_DATA_KEY_IMPL(BrowserOSNodeIdStore);
++
++}  // namespace api
++}  // namespace extensions
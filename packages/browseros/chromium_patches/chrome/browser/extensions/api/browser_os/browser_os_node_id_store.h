@@ -0,0 +1,176 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_node_id_store.h b/chrome/browser/extensions/api/browser_os/browser_os_node_id_store.h
+new file mode 100644
+index 0000000000000..5a4636e6ceab5
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_node_id_store.h
+@@ -0,0 +1,170 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_NODE_ID_STORE_H_
++#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_NODE_ID_STORE_H_
++
++#include <cstddef>
++#include <cstdint>
++#include <list>
++#include <string>
++#include <unordered_map>
++
++#include "base/memory/weak_ptr.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_api_utils.h"
++#include "content/public/browser/web_contents_observer.h"
++#include "content/public/browser/web_contents_user_data.h"
++
++namespace content {
++class NavigationHandle;
++class WebContents;
++}  // namespace content
++
++namespace extensions {
++namespace api {
++
++// Node IDs handed to agents are handles. The low kNodeIndexBits bits number
++// the node within the snapshot that first reported it, and the bits above
++// hold that snapshot's tag. Tags come from a per-tab sequence, so an ID from
++// one of the tab's last kMaxHandleTag snapshots never names a different
++// element of a newer one. Handles fit in the IDL's 32-bit signed long.
++inline constexpr int kNodeIndexBits = 20;
++inline constexpr uint32_t kMaxNodeIndex = (1u << kNodeIndexBits) - 1;
++inline constexpr uint32_t kMaxHandleTag = (1u << (31 - kNodeIndexBits)) - 1;
++
++uint32_t MakeNodeHandle(uint32_t tag, uint32_t index);
++
++// Per-tab nodeId -> NodeInfo mappings of interactive snapshots.
++//
++// The mappings live as long as the tab and are dropped when it navigates to
++// a new document, so closed or navigated tabs no longer hold on to them.
++// The last few snapshots are retained, least recently used first out, and
++// older snapshots are also evicted once the tab's mappings exceed a memory
++// cap. The current snapshot is never evicted. IDs from a retained older
++// snapshot are remapped to the current one through their AX node.
++class BrowserOSNodeIdStore
++    : public content::WebContentsObserver,
++      public content::WebContentsUserData<BrowserOSNodeIdStore> {
++ public:
++  using NodeMap = std::unordered_map<uint32_t, NodeInfo>;
++
++  // Snapshots retained per tab, including the current one
++  static constexpr size_t kMaxSnapshots = 4;
++  // Memory of a tab's mappings above which older snapshots are evicted
++  static constexpr size_t kMaxMemoryBytes = 16 * 1024 * 1024;
++
++  BrowserOSNodeIdStore(const BrowserOSNodeIdStore&) = delete;
++  BrowserOSNodeIdStore& operator=(const BrowserOSNodeIdStore&) = delete;
++  ~BrowserOSNodeIdStore() override;
++
++  // Memory of the mappings of all tabs, for monitoring.
++  static size_t GetTotalMemoryUsage();
++  // Number of tabs that hold mappings.
++  static size_t GetStoreCount();
++
++  // Starts an empty snapshot, which becomes the current one, and evicts the
++  // least recently used snapshots beyond kMaxSnapshots. Returns the tag for
++  // the snapshot's node handles. Once the tag sequence wraps, a retained
++  // snapshot holding the same tag is evicted so no handle is ambiguous.
++  uint32_t StartSnapshot(uint32_t snapshot_id);
++
++  // Handle tag of snapshot |snapshot_id|, or 0 if it is not retained.
++  uint32_t GetHandleTag(uint32_t snapshot_id) const;
++
++  // Adds a node to snapshot |snapshot_id|. Ignored if the snapshot was
++  // evicted or the store cleared while it was being processed.
++  void AddNode(uint32_t snapshot_id, uint32_t node_id, NodeInfo info);
++
++  // Moves the nodes out of snapshot |snapshot_id| for renumbering, to be put
++  // back with ReplaceNodes. Empty if the snapshot is gone.
++  NodeMap TakeNodes(uint32_t snapshot_id);
++  void ReplaceNodes(uint32_t snapshot_id, NodeMap nodes);
++
++  // Nodes of the current snapshot, or null if there is none.
++  const NodeMap* current_nodes() const;
++
++  // Looks up |node_id| in the current snapshot, or returns null.
++  const NodeInfo* Find(uint32_t node_id);
++
++  struct Resolution {
++    const NodeInfo* node = nullptr;
++    // ID of |node| in the current snapshot
++    uint32_t node_id = 0;
++    // True if the given ID came from an older snapshot
++    bool remapped = false;
++  };
++
++  // Finds |node_id| in the current snapshot. An ID that only a retained
++  // older snapshot knows is remapped to the current node with the same AX
++  // tree and node ID. Returns a null node and sets |error| if the element is
++  // gone from the page or no retained snapshot knows the ID.
++  Resolution Resolve(uint32_t node_id, std::string* error);
++
++  // Nodes of snapshot |snapshot_id| if still retained, which marks it used.
++  const NodeMap* FindSnapshot(uint32_t snapshot_id);
++
++  // Drops all snapshots.
++  void Clear();
++
++  size_t snapshot_count() const { return snapshots_.size(); }
++  size_t node_count() const;
++  size_t memory_usage() const { return memory_usage_; }
++
++  base::WeakPtr<BrowserOSNodeIdStore> GetWeakPtr() {
++    return weak_factory_.GetWeakPtr();
++  }
++
++ private:
++  friend class content::WebContentsUserData<BrowserOSNodeIdStore>;
++
++  struct Snapshot {
++    Snapshot();
++    Snapshot(Snapshot&&);
++    Snapshot& operator=(Snapshot&&);
++    ~Snapshot();
++
++    uint32_t id = 0;
++    uint32_t tag = 0;
++    NodeMap nodes;
++    size_t memory_usage = 0;
++    // AX node ID -> node ID, built on the first remap into this snapshot
++    std::unordered_multimap<int32_t, uint32_t> by_ax_node_id;
++  };
++
++  explicit BrowserOSNodeIdStore(content::WebContents* web_contents);
++
++  // content::WebContentsObserver:
++  void DidFinishNavigation(
++      content::NavigationHandle* navigation_handle) override;
++
++  Snapshot* FindAndTouch(uint32_t snapshot_id);
++
++  // Node ID in |snapshot| of the element |info| describes, or 0.
++  static uint32_t FindByAXNode(Snapshot& snapshot, const NodeInfo& info);
++
++  // Evicts least recently used snapshots other than the current one while
++  // over either cap.
++  void Trim();
++
++  void AddMemory(size_t bytes);
++  void RemoveMemory(size_t bytes);
++
++  // Most recently used first
++  std::list<Snapshot> snapshots_;
++  uint32_t current_snapshot_id_ = 0;
++  bool has_current_ = false;
++  // Tag of the next new snapshot, 1 to kMaxHandleTag. Not reset by Clear(),
++  // so IDs from before a navigation do not resolve in the new document.
++  uint32_t next_tag_ = 1;
++  size_t memory_usage_ = 0;
++
++  base::WeakPtrFactory<BrowserOSNodeIdStore> weak_factory_{this};
++
++  WEB_CONTENTS_USER_DATA_KEY_DECL();
++};
++
++}  // namespace api
++}  // namespace extensions
++
++#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_NODE_ID_STORE_H_
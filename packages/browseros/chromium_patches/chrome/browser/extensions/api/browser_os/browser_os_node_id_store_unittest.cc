@@ -0,0 +1,250 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_node_id_store_unittest.cc b/chrome/browser/extensions/api/browser_os/browser_os_node_id_store_unittest.cc
+new file mode 100644
+index 0000000000000..c521e1172e79c
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_node_id_store_unittest.cc
+@@ -0,0 +1,244 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_id_store.h"
++
++#include <string>
++
++#include "content/public/test/navigation_simulator.h"
++#include "content/public/test/test_renderer_host.h"
++#include "testing/gtest/include/gtest/gtest.h"
++#include "url/gurl.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++NodeInfo MakeNode(int32_t ax_node_id) {
++  NodeInfo info;
++  info.ax_node_id = ax_node_id;
++  info.attributes.Set(NodeAttribute::kPath,
++                      "main > form > input#field" + std::to_string(ax_node_id));
++  return info;
++}
++
++class BrowserOSNodeIdStoreTest : public content::RenderViewHostTestHarness {
++ protected:
++  void SetUp() override {
++    content::RenderViewHostTestHarness::SetUp();
++    NavigateAndCommit(GURL("https://example.test/form"));
++    BrowserOSNodeIdStore::CreateForWebContents(web_contents());
++  }
++
++  BrowserOSNodeIdStore* store() {
++    return BrowserOSNodeIdStore::FromWebContents(web_contents());
++  }
++};
++
++// =============================================================================
++// Lookup Tests
++// =============================================================================
++
++TEST_F(BrowserOSNodeIdStoreTest, FindsNodesOfCurrentSnapshotOnly) {
++  store()->StartSnapshot(1);
++  store()->AddNode(1, 1, MakeNode(10));
++  store()->AddNode(1, 2, MakeNode(20));
++  store()->StartSnapshot(2);
++  store()->AddNode(2, 1, MakeNode(30));
++
++  ASSERT_TRUE(store()->Find(1));
++  EXPECT_EQ(30, store()->Find(1)->ax_node_id);
++  EXPECT_FALSE(store()->Find(2));
++
++  // The older snapshot is still retained
++  const BrowserOSNodeIdStore::NodeMap* first = store()->FindSnapshot(1);
++  ASSERT_TRUE(first);
++  EXPECT_EQ(2u, first->size());
++}
++
++TEST_F(BrowserOSNodeIdStoreTest, NoCurrentSnapshotBeforeFirstOne) {
++  EXPECT_FALSE(store()->current_nodes());
++  EXPECT_FALSE(store()->Find(1));
++}
++
++// =============================================================================
++// Handle Tests
++// =============================================================================
++
++TEST(NodeHandleTest, SameIndexDiffersAcrossSnapshots) {
++  EXPECT_NE(MakeNodeHandle(1, 5), MakeNodeHandle(2, 5));
++  EXPECT_EQ(5u, MakeNodeHandle(1, 5) & kMaxNodeIndex);
++  // Handles stay positive in the IDL's signed long
++  EXPECT_GT(static_cast<int32_t>(MakeNodeHandle(0xFFFFFFFF, kMaxNodeIndex)),
++            0);
++}
++
++TEST_F(BrowserOSNodeIdStoreTest, SnapshotsOfOtherTabsDoNotWrapTags) {
++  // Snapshot IDs are shared by all tabs; these two share their low bits
++  const uint32_t first = 1;
++  const uint32_t second = first + kMaxHandleTag + 1;
++  const uint32_t old_id = MakeNodeHandle(store()->StartSnapshot(first), 1);
++  store()->AddNode(first, old_id, MakeNode(10));
++  const uint32_t new_id = MakeNodeHandle(store()->StartSnapshot(second), 1);
++  store()->AddNode(second, new_id, MakeNode(20));
++
++  EXPECT_NE(old_id, new_id);
++  std::string error;
++  EXPECT_FALSE(store()->Resolve(old_id, &error).node);
++  EXPECT_NE(std::string::npos, error.find("stale"));
++}
++
++TEST_F(BrowserOSNodeIdStoreTest, WrappedTagEvictsSnapshotHoldingIt) {
++  const uint32_t tag = store()->StartSnapshot(1);
++  store()->AddNode(1, MakeNodeHandle(tag, 1), MakeNode(10));
++  // Snapshot 1 stays in use while the tag sequence goes all the way round
++  for (uint32_t id = 2; id <= kMaxHandleTag; ++id) {
++    store()->StartSnapshot(id);
++    ASSERT_TRUE(store()->FindSnapshot(1));
++  }
++
++  const uint32_t wrapped = kMaxHandleTag + 1;
++  EXPECT_EQ(tag, store()->StartSnapshot(wrapped));
++  EXPECT_FALSE(store()->FindSnapshot(1));
++  EXPECT_EQ(0u, store()->GetHandleTag(1));
++  EXPECT_EQ(tag, store()->GetHandleTag(wrapped));
++}
++
++TEST_F(BrowserOSNodeIdStoreTest, RemapsIdFromOlderSnapshot) {
++  const uint32_t old_id = MakeNodeHandle(1, 1);
++  const uint32_t new_id = MakeNodeHandle(2, 3);
++  store()->StartSnapshot(1);
++  store()->AddNode(1, old_id, MakeNode(10));
++  store()->StartSnapshot(2);
++  store()->AddNode(2, MakeNodeHandle(2, 1), MakeNode(5));
++  store()->AddNode(2, new_id, MakeNode(10));
++
++  std::string error;
++  BrowserOSNodeIdStore::Resolution resolution =
++      store()->Resolve(old_id, &error);
++  ASSERT_TRUE(resolution.node) << error;
++  EXPECT_TRUE(resolution.remapped);
++  EXPECT_EQ(new_id, resolution.node_id);
++  EXPECT_EQ(10, resolution.node->ax_node_id);
++}
++
++TEST_F(BrowserOSNodeIdStoreTest, StaleIdOfRemovedElementFails) {
++  const uint32_t old_id = MakeNodeHandle(1, 1);
++  store()->StartSnapshot(1);
++  store()->AddNode(1, old_id, MakeNode(10));
++  store()->StartSnapshot(2);
++  store()->AddNode(2, MakeNodeHandle(2, 1), MakeNode(20));
++
++  std::string error;
++  EXPECT_FALSE(store()->Resolve(old_id, &error).node);
++  EXPECT_NE(std::string::npos, error.find("stale"));
++}
++
++TEST_F(BrowserOSNodeIdStoreTest, IdOfEvictedSnapshotFails) {
++  store()->StartSnapshot(1);
++  store()->AddNode(1, MakeNodeHandle(1, 1), MakeNode(10));
++  for (uint32_t id = 2; id <= BrowserOSNodeIdStore::kMaxSnapshots + 1; ++id) {
++    store()->StartSnapshot(id);
++    store()->AddNode(id, MakeNodeHandle(id, 1), MakeNode(10));
++  }
++
++  std::string error;
++  EXPECT_FALSE(store()->Resolve(MakeNodeHandle(1, 1), &error).node);
++  EXPECT_NE(std::string::npos, error.find("no longer retained"));
++}
++
++// =============================================================================
++// Eviction Tests
++// =============================================================================
++
++TEST_F(BrowserOSNodeIdStoreTest, EvictsLeastRecentlyUsedSnapshot) {
++  for (uint32_t id = 1; id <= BrowserOSNodeIdStore::kMaxSnapshots; ++id) {
++    store()->StartSnapshot(id);
++    store()->AddNode(id, 1, MakeNode(id));
++  }
++  // Using snapshot 1 makes snapshot 2 the least recently used
++  ASSERT_TRUE(store()->FindSnapshot(1));
++
++  store()->StartSnapshot(BrowserOSNodeIdStore::kMaxSnapshots + 1);
++
++  EXPECT_EQ(BrowserOSNodeIdStore::kMaxSnapshots, store()->snapshot_count());
++  EXPECT_TRUE(store()->FindSnapshot(1));
++  EXPECT_FALSE(store()->FindSnapshot(2));
++}
++
++TEST_F(BrowserOSNodeIdStoreTest, IgnoresNodesOfEvictedSnapshot) {
++  store()->StartSnapshot(1);
++  store()->Clear();
++  store()->AddNode(1, 1, MakeNode(10));
++
++  EXPECT_EQ(0u, store()->node_count());
++  EXPECT_EQ(0u, store()->memory_usage());
++}
++
++// =============================================================================
++// Memory Tests
++// =============================================================================
++
++TEST_F(BrowserOSNodeIdStoreTest, TracksMemoryPerTabAndInTotal) {
++  const size_t total_before = BrowserOSNodeIdStore::GetTotalMemoryUsage();
++  store()->StartSnapshot(1);
++  store()->AddNode(1, 1, MakeNode(10));
++  const size_t one_node = store()->memory_usage();
++  EXPECT_GT(one_node, 0u);
++
++  // Replacing a node does not count it twice
++  store()->AddNode(1, 1, MakeNode(10));
++  EXPECT_EQ(one_node, store()->memory_usage());
++  EXPECT_EQ(total_before + one_node,
++            BrowserOSNodeIdStore::GetTotalMemoryUsage());
++
++  store()->ReplaceNodes(1, store()->TakeNodes(1));
++  EXPECT_EQ(one_node, store()->memory_usage());
++
++  store()->Clear();
++  EXPECT_EQ(0u, store()->memory_usage());
++  EXPECT_EQ(total_before, BrowserOSNodeIdStore::GetTotalMemoryUsage());
++}
++
++// =============================================================================
++// Lifecycle Tests
++// =============================================================================
++
++TEST_F(BrowserOSNodeIdStoreTest, ClearedOnCrossDocumentNavigation) {
++  store()->StartSnapshot(1);
++  store()->AddNode(1, 1, MakeNode(10));
++
++  NavigateAndCommit(GURL("https://example.test/other"));
++
++  EXPECT_EQ(0u, store()->snapshot_count());
++  EXPECT_FALSE(store()->Find(1));
++}
++
++TEST_F(BrowserOSNodeIdStoreTest, KeptOnSameDocumentNavigation) {
++  store()->StartSnapshot(1);
++  store()->AddNode(1, 1, MakeNode(10));
++
++  content::NavigationSimulator::CreateRendererInitiated(
++      GURL("https://example.test/form#details"), main_rfh())
++      ->CommitSameDocument();
++
++  EXPECT_TRUE(store()->Find(1));
++}
++
++TEST_F(BrowserOSNodeIdStoreTest, ReleasesMemoryWhenTabCloses) {
++  const size_t total_before = BrowserOSNodeIdStore::GetTotalMemoryUsage();
++  const size_t stores_before = BrowserOSNodeIdStore::GetStoreCount();
++  store()->StartSnapshot(1);
++  store()->AddNode(1, 1, MakeNode(10));
++  EXPECT_GT(BrowserOSNodeIdStore::GetTotalMemoryUsage(), total_before);
++
++  DeleteContents();
++
++  EXPECT_EQ(total_before, BrowserOSNodeIdStore::GetTotalMemoryUsage());
++  EXPECT_EQ(stores_before - 1, BrowserOSNodeIdStore::GetStoreCount());
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,98 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_node_index.cc b/chrome/browser/extensions/api/browser_os/browser_os_node_index.cc
+new file mode 100644
+index 0000000000000..29ee340d171ff
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_node_index.cc
+@@ -0,0 +1,92 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_index.h"
++
++#include <algorithm>
++#include <utility>
++
++#include "base/memory/scoped_refptr.h"
++#include "ui/accessibility/ax_tree_update.h"
++
++namespace extensions {
++namespace api {
++
++SnapshotNodeIndex::SnapshotNodeIndex() = default;
++SnapshotNodeIndex::~SnapshotNodeIndex() = default;
++
++// static
++scoped_refptr<const SnapshotNodeIndex> SnapshotNodeIndex::Create(
++    const ui::AXTreeUpdate& tree_update) {
++  auto index = base::WrapRefCounted(new SnapshotNodeIndex());
++  index->root_id_ = tree_update.root_id;
++  index->nodes_ = tree_update.nodes;
++  index->BuildOffsets();
++  return index;
++}
++
++// static
++scoped_refptr<const SnapshotNodeIndex> SnapshotNodeIndex::Create(
++    ui::AXTreeUpdate&& tree_update) {
++  auto index = base::WrapRefCounted(new SnapshotNodeIndex());
++  index->root_id_ = tree_update.root_id;
++  index->nodes_ = std::move(tree_update.nodes);
++  index->BuildOffsets();
++  return index;
++}
++
++void SnapshotNodeIndex::BuildOffsets() {
++  offsets_.reserve(nodes_.size());
++  for (size_t i = 0; i < nodes_.size(); ++i) {
++    offsets_.emplace_back(nodes_[i].id, static_cast<uint32_t>(i));
++  }
++  // Stable sort so that, as with the old map insertion, the last occurrence
++  // of a duplicated id wins in OffsetOf().
++  std::stable_sort(offsets_.begin(), offsets_.end(),
++                   [](const auto& a, const auto& b) { return a.first < b.first; });
++}
++
++int64_t SnapshotNodeIndex::OffsetOf(int32_t ax_id) const {
++  auto it = std::upper_bound(
++      offsets_.begin(), offsets_.end(), ax_id,
++      [](int32_t id, const auto& entry) { return id < entry.first; });
++  if (it == offsets_.begin()) {
++    return -1;
++  }
++  --it;
++  if (it->first != ax_id) {
++    return -1;
++  }
++  return it->second;
++}
++
++const ui::AXNodeData* SnapshotNodeIndex::Find(int32_t ax_id) const {
++  int64_t offset = OffsetOf(ax_id);
++  if (offset < 0) {
++    return nullptr;
++  }
++  return &nodes_[offset];
++}
++
++size_t SnapshotNodeIndex::EstimateMemoryUsage() const {
++  size_t bytes = nodes_.capacity() * sizeof(ui::AXNodeData) +
++                 offsets_.capacity() * sizeof(offsets_[0]);
++  for (const auto& node : nodes_) {
++    bytes += node.child_ids.capacity() * sizeof(int32_t);
++    for (const auto& [key, value] : node.string_attributes) {
++      bytes += sizeof(key) + sizeof(value) + value.capacity();
++    }
++    for (const auto& [name, value] : node.html_attributes) {
++      bytes += sizeof(name) + name.capacity() + sizeof(value) +
++               value.capacity();
++    }
++    // Int and float attributes are stored as (enum, 4-byte value) pairs.
++    bytes += (node.int_attributes.size() + node.float_attributes.size()) *
++             2 * sizeof(int32_t);
++  }
++  return bytes;
++}
++
++}  // namespace api
++}  // namespace extensions
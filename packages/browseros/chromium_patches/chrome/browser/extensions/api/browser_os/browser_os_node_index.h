@@ -0,0 +1,82 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_node_index.h b/chrome/browser/extensions/api/browser_os/browser_os_node_index.h
+new file mode 100644
+index 0000000000000..63f1c16513983
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_node_index.h
+@@ -0,0 +1,76 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_NODE_INDEX_H_
++#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_NODE_INDEX_H_
++
++#include <cstddef>
++#include <cstdint>
++#include <utility>
++#include <vector>
++
++#include "base/memory/ref_counted.h"
++#include "ui/accessibility/ax_node_data.h"
++
++namespace ui {
++struct AXTreeUpdate;
++}  // namespace ui
++
++namespace extensions {
++namespace api {
++
++// Immutable, flat lookup table over the nodes of one AXTreeUpdate.
++//
++// Built once per snapshot on the UI thread and then shared read-only by every
++// worker task through a scoped_refptr, so batches no longer need their own
++// copy of the node map. Lookups are a binary search over a sorted
++// (ax id -> offset) table that points into a single contiguous node vector.
++class SnapshotNodeIndex
++    : public base::RefCountedThreadSafe<SnapshotNodeIndex> {
++ public:
++  // Copies the nodes out of |tree_update| exactly once.
++  static scoped_refptr<const SnapshotNodeIndex> Create(
++      const ui::AXTreeUpdate& tree_update);
++  // Takes the nodes of |tree_update| without copying them, for callers that
++  // are done with the update.
++  static scoped_refptr<const SnapshotNodeIndex> Create(
++      ui::AXTreeUpdate&& tree_update);
++
++  SnapshotNodeIndex(const SnapshotNodeIndex&) = delete;
++  SnapshotNodeIndex& operator=(const SnapshotNodeIndex&) = delete;
++
++  // Returns the node with the given AX id, or nullptr if it is not present.
++  const ui::AXNodeData* Find(int32_t ax_id) const;
++
++  // Returns the offset of |ax_id| in nodes(), or -1 if it is not present.
++  int64_t OffsetOf(int32_t ax_id) const;
++
++  // Nodes in tree-update order.
++  const std::vector<ui::AXNodeData>& nodes() const { return nodes_; }
++  size_t size() const { return nodes_.size(); }
++  int32_t root_id() const { return root_id_; }
++
++  // Approximate heap footprint of the index, including attribute storage.
++  // Used for the snapshot memory counters.
++  size_t EstimateMemoryUsage() const;
++
++ private:
++  friend class base::RefCountedThreadSafe<SnapshotNodeIndex>;
++
++  SnapshotNodeIndex();
++  ~SnapshotNodeIndex();
++
++  // Builds |offsets_| once |nodes_| is filled.
++  void BuildOffsets();
++
++  std::vector<ui::AXNodeData> nodes_;
++  // Sorted by AX id.
++  std::vector<std::pair<int32_t, uint32_t>> offsets_;
++  int32_t root_id_ = ui::kInvalidAXNodeID;
++};
++
++}  // namespace api
++}  // namespace extensions
++
++#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_NODE_INDEX_H_
@@ -0,0 +1,137 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_parallel_for.cc b/chrome/browser/extensions/api/browser_os/browser_os_parallel_for.cc
+new file mode 100644
+index 0000000000000..d022014a2d195
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_parallel_for.cc
+@@ -0,0 +1,131 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_parallel_for.h"
++
++#include <algorithm>
++#include <atomic>
++#include <utility>
++
++#include "base/functional/bind.h"
++#include "base/location.h"
++#include "base/memory/ref_counted.h"
++#include "base/memory/scoped_refptr.h"
++#include "base/system/sys_info.h"
++#include "base/task/post_job.h"
++#include "base/task/sequenced_task_runner.h"
++
++namespace extensions {
++namespace api {
++
++namespace {
++
++class ParallelForState : public base::RefCountedThreadSafe<ParallelForState> {
++ public:
++  ParallelForState(
++      size_t size,
++      size_t min_range,
++      base::RepeatingCallback<void(size_t, size_t)> body,
++      base::RepeatingCallback<void(size_t, size_t)> on_range_done,
++      base::OnceClosure on_done)
++      : size_(size),
++        min_range_(std::max<size_t>(min_range, 1)),
++        max_workers_(
++            static_cast<size_t>(std::max(base::SysInfo::NumberOfProcessors(),
++                                         1))),
++        body_(std::move(body)),
++        on_range_done_(std::move(on_range_done)),
++        on_done_(std::move(on_done)),
++        reply_runner_(base::SequencedTaskRunner::GetCurrentDefault()) {}
++
++  ParallelForState(const ParallelForState&) = delete;
++  ParallelForState& operator=(const ParallelForState&) = delete;
++
++  void Run(base::JobDelegate* delegate) {
++    size_t begin = 0;
++    size_t end = 0;
++    while (!delegate->ShouldYield() && ClaimRange(&begin, &end)) {
++      body_.Run(begin, end);
++      if (on_range_done_) {
++        reply_runner_->PostTask(FROM_HERE,
++                                base::BindOnce(on_range_done_, begin, end));
++      }
++      // Only the worker that completes the last index sees the total, and
++      // its range reply above is already queued ahead of |on_done_|.
++      const size_t count = end - begin;
++      if (completed_.fetch_add(count, std::memory_order_acq_rel) + count ==
++          size_) {
++        reply_runner_->PostTask(FROM_HERE, std::move(on_done_));
++      }
++    }
++  }
++
++  size_t GetMaxConcurrency(size_t worker_count) const {
++    const size_t claimed = cursor_.load(std::memory_order_relaxed);
++    const size_t remaining = claimed < size_ ? size_ - claimed : 0;
++    const size_t ranges = (remaining + min_range_ - 1) / min_range_;
++    return std::min(worker_count + ranges, max_workers_);
++  }
++
++ private:
++  friend class base::RefCountedThreadSafe<ParallelForState>;
++  ~ParallelForState() = default;
++
++  bool ClaimRange(size_t* out_begin, size_t* out_end) {
++    size_t begin = cursor_.load(std::memory_order_relaxed);
++    while (begin < size_) {
++      const size_t remaining = size_ - begin;
++      const size_t length = std::min(
++          std::max(remaining / (2 * max_workers_), min_range_), remaining);
++      if (cursor_.compare_exchange_weak(begin, begin + length,
++                                        std::memory_order_relaxed)) {
++        *out_begin = begin;
++        *out_end = begin + length;
++        return true;
++      }
++    }
++    return false;
++  }
++
++  const size_t size_;
++  const size_t min_range_;
++  const size_t max_workers_;
++  const base::RepeatingCallback<void(size_t, size_t)> body_;
++  const base::RepeatingCallback<void(size_t, size_t)> on_range_done_;
++  // Moved out by the worker that completes the last range
++  base::OnceClosure on_done_;
++  const scoped_refptr<base::SequencedTaskRunner> reply_runner_;
++
++  // First index not yet claimed by any worker
++  std::atomic<size_t> cursor_{0};
++  // Number of indices whose range has finished running
++  std::atomic<size_t> completed_{0};
++};
++
++}  // namespace
++
++void ParallelFor(
++    size_t size,
++    size_t min_range,
++    base::TaskPriority priority,
++    base::RepeatingCallback<void(size_t begin, size_t end)> body,
++    base::RepeatingCallback<void(size_t begin, size_t end)> on_range_done,
++    base::OnceClosure on_done) {
++  if (size == 0) {
++    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
++        FROM_HERE, std::move(on_done));
++    return;
++  }
++  auto state = base::MakeRefCounted<ParallelForState>(
++      size, min_range, std::move(body), std::move(on_range_done),
++      std::move(on_done));
++  base::PostJob(
++      FROM_HERE, {priority},
++      base::BindRepeating(&ParallelForState::Run, state),
++      base::BindRepeating(&ParallelForState::GetMaxConcurrency, state))
++      .Detach();
++}
++
++}  // namespace api
++}  // namespace extensions
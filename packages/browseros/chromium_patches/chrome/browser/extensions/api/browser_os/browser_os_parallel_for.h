@@ -0,0 +1,47 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_parallel_for.h b/chrome/browser/extensions/api/browser_os/browser_os_parallel_for.h
+new file mode 100644
+index 0000000000000..a917cc9ea5951
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_parallel_for.h
+@@ -0,0 +1,41 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_PARALLEL_FOR_H_
++#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_PARALLEL_FOR_H_
++
++#include <cstddef>
++
++#include "base/functional/callback.h"
++#include "base/task/task_traits.h"
++
++namespace extensions {
++namespace api {
++
++// Runs |body| over index ranges that together cover [0, |size|), on the
++// thread pool.
++//
++// Workers claim ranges from a shared atomic cursor, so a worker that finishes
++// early takes the next range instead of idling behind a fixed partition.
++// Ranges start large and shrink towards |min_range| as the cursor advances
++// (guided scheduling): few claims on big inputs, no long tail at the end.
++// Concurrency is driven by base::PostJob and scales with the remaining work.
++//
++// |body| runs concurrently with itself and must only write state owned by
++// its range, e.g. preallocated result slots indexed by position.
++// |on_range_done|, if non-null, runs on the calling sequence after each
++// range; |on_done| runs there once after every range has run. Nothing else
++// is posted back, however large |size| is.
++void ParallelFor(
++    size_t size,
++    size_t min_range,
++    base::TaskPriority priority,
++    base::RepeatingCallback<void(size_t begin, size_t end)> body,
++    base::RepeatingCallback<void(size_t begin, size_t end)> on_range_done,
++    base::OnceClosure on_done);
++
++}  // namespace api
++}  // namespace extensions
++
++#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_PARALLEL_FOR_H_
@@ -0,0 +1,86 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_parallel_for_unittest.cc b/chrome/browser/extensions/api/browser_os/browser_os_parallel_for_unittest.cc
+new file mode 100644
+index 0000000000000..9f5837648d5fc
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_parallel_for_unittest.cc
+@@ -0,0 +1,80 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_parallel_for.h"
++
++#include <atomic>
++#include <memory>
++#include <vector>
++
++#include "base/functional/bind.h"
++#include "base/run_loop.h"
++#include "base/test/task_environment.h"
++#include "testing/gtest/include/gtest/gtest.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++// =============================================================================
++// ParallelFor Tests
++// =============================================================================
++
++TEST(ParallelForTest, VisitsEveryIndexOnce) {
++  base::test::TaskEnvironment task_environment;
++  constexpr size_t kSize = 10000;
++  auto visits = std::make_unique<std::atomic<int>[]>(kSize);
++  std::vector<bool> reported(kSize, false);
++  size_t ranges = 0;
++
++  base::RunLoop run_loop;
++  ParallelFor(
++      kSize, 16, base::TaskPriority::USER_VISIBLE,
++      base::BindRepeating(
++          [](std::atomic<int>* visits, size_t begin, size_t end) {
++            for (size_t i = begin; i < end; ++i) {
++              visits[i].fetch_add(1);
++            }
++          },
++          visits.get()),
++      base::BindRepeating(
++          [](std::vector<bool>* reported, size_t* ranges, size_t begin,
++             size_t end) {
++            ++*ranges;
++            for (size_t i = begin; i < end; ++i) {
++              EXPECT_FALSE((*reported)[i]);
++              (*reported)[i] = true;
++            }
++          },
++          &reported, &ranges),
++      run_loop.QuitClosure());
++  run_loop.Run();
++
++  for (size_t i = 0; i < kSize; ++i) {
++    EXPECT_EQ(1, visits[i].load()) << i;
++    EXPECT_TRUE(reported[i]) << i;
++  }
++  // Guided ranges: far fewer claims than fixed minimum-size chunks
++  EXPECT_LT(ranges, kSize / 16);
++}
++
++TEST(ParallelForTest, EmptyRangeStillCompletes) {
++  base::test::TaskEnvironment task_environment;
++  bool body_ran = false;
++
++  base::RunLoop run_loop;
++  ParallelFor(0, 16, base::TaskPriority::USER_VISIBLE,
++              base::BindRepeating(
++                  [](bool* body_ran, size_t, size_t) { *body_ran = true; },
++                  &body_ran),
++              base::RepeatingCallback<void(size_t, size_t)>(),
++              run_loop.QuitClosure());
++  run_loop.Run();
++
++  EXPECT_FALSE(body_ran);
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
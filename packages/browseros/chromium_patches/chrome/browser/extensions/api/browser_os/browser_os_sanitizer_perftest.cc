@@ -0,0 +1,93 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_sanitizer_perftest.cc b/chrome/browser/extensions/api/browser_os/browser_os_sanitizer_perftest.cc
+new file mode 100644
+index 0000000000000..4cd72141eeec3
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_sanitizer_perftest.cc
+@@ -0,0 +1,87 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include <string>
++#include <string_view>
++#include <vector>
++
++#include "base/timer/elapsed_timer.h"
++#include "chrome/browser/browseros/core/browseros_text_util.h"
++#include "testing/gtest/include/gtest/gtest.h"
++#include "testing/perf/perf_result_reporter.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++constexpr int kNames = 200000;
++
++// The byte-wise sanitizer names used to go through: every byte outside
++// printable ASCII became a space, which erased non-English names.
++std::string AsciiOnlySanitize(const std::string& input) {
++  std::string output = input;
++  for (char& c : output) {
++    if (c < 32 || c > 126) {
++      c = ' ';
++    }
++  }
++  browseros::CollapseWhitespace(output);
++  return output;
++}
++
++// Accessible names as they appear on a page in |script|, with every tenth
++// one carrying markup whitespace.
++std::vector<std::string> BuildNames(const std::vector<std::string>& script) {
++  std::vector<std::string> names;
++  names.reserve(kNames);
++  for (int i = 0; i < kNames; ++i) {
++    std::string name = script[i % script.size()];
++    if (i % 10 == 0) {
++      name = "\n  " + name + "  \t";
++    }
++    names.push_back(std::move(name));
++  }
++  return names;
++}
++
++void RunSanitizerBenchmark(const std::string& story,
++                           const std::vector<std::string>& names) {
++  size_t ascii_only_bytes = 0;
++  base::ElapsedTimer ascii_only_timer;
++  for (const std::string& name : names) {
++    ascii_only_bytes += AsciiOnlySanitize(name).size();
++  }
++  base::TimeDelta ascii_only_time = ascii_only_timer.Elapsed();
++
++  size_t sanitized_bytes = 0;
++  std::string storage;
++  base::ElapsedTimer sanitized_timer;
++  for (const std::string& name : names) {
++    sanitized_bytes += browseros::SanitizeForOutput(name, &storage).size();
++  }
++  base::TimeDelta sanitized_time = sanitized_timer.Elapsed();
++
++  EXPECT_GT(sanitized_bytes, ascii_only_bytes);
++
++  perf_test::PerfResultReporter reporter("BrowserOSSanitizer.", story);
++  reporter.RegisterImportantMetric(".ascii_only", "ms");
++  reporter.RegisterImportantMetric(".utf8", "ms");
++  reporter.AddResult(".ascii_only", ascii_only_time);
++  reporter.AddResult(".utf8", sanitized_time);
++}
++
++TEST(SanitizerPerfTest, Cyrillic) {
++  RunSanitizerBenchmark("Cyrillic",
++                        BuildNames({"Отправить", "Купить сейчас",
++                                    "Поиск по сайту", "Sign in"}));
++}
++
++TEST(SanitizerPerfTest, CJK) {
++  RunSanitizerBenchmark("CJK", BuildNames({"注文を確定する", "カートに入れる",
++                                           "搜索", "登录 / Login"}));
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
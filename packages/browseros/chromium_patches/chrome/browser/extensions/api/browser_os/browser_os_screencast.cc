@@ -0,0 +1,242 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_screencast.cc b/chrome/browser/extensions/api/browser_os/browser_os_screencast.cc
+new file mode 100644
+index 0000000000000..2ac0824b13e6d
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_screencast.cc
+@@ -0,0 +1,236 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_screencast.h"
++
++#include <map>
++#include <utility>
++
++#include "base/functional/bind.h"
++#include "base/logging.h"
++#include "base/no_destructor.h"
++#include "base/task/thread_pool.h"
++#include "content/browser/devtools/devtools_video_consumer.h"
++#include "content/browser/renderer_host/render_widget_host_view_base.h"
++#include "content/public/browser/render_widget_host_view.h"
++#include "content/public/browser/web_contents.h"
++#include "media/base/video_frame.h"
++
++namespace extensions {
++namespace api {
++
++namespace {
++
++std::map<int, std::unique_ptr<BrowserOSScreencast>>& GetScreencasts() {
++  static base::NoDestructor<std::map<int, std::unique_ptr<BrowserOSScreencast>>>
++      screencasts;
++  return *screencasts;
++}
++
++int g_next_screencast_id = 1;
++
++}  // namespace
++
++// static
++BrowserOSScreencast* BrowserOSScreencast::Start(
++    content::WebContents* web_contents,
++    content::BrowserContext* browser_context,
++    const ExtensionId& extension_id,
++    const Options& options,
++    std::string* error) {
++  BrowserOSScreencast* screencast = Register(web_contents, browser_context,
++                                             extension_id, options, error);
++  if (!screencast) {
++    return nullptr;
++  }
++  screencast->video_consumer_->StartCapture();
++  VLOG(1) << "[browseros] Screencast " << screencast->id()
++          << " started at up to " << options.max_fps << " fps";
++  return screencast;
++}
++
++// static
++BrowserOSScreencast* BrowserOSScreencast::StartForTesting(
++    content::WebContents* web_contents,
++    content::BrowserContext* browser_context,
++    const ExtensionId& extension_id,
++    const Options& options) {
++  std::string error;
++  return Register(web_contents, browser_context, extension_id, options,
++                  &error);
++}
++
++// static
++BrowserOSScreencast* BrowserOSScreencast::Register(
++    content::WebContents* web_contents,
++    content::BrowserContext* browser_context,
++    const ExtensionId& extension_id,
++    const Options& options,
++    std::string* error) {
++  const int id = g_next_screencast_id++;
++  std::unique_ptr<BrowserOSScreencast> screencast(new BrowserOSScreencast(
++      id, web_contents, browser_context, extension_id, options));
++  if (!screencast->AttachToView()) {
++    *error = "No render widget host view";
++    return nullptr;
++  }
++  screencast->idle_timer_.Reset();
++  BrowserOSScreencast* raw = screencast.get();
++  GetScreencasts()[id] = std::move(screencast);
++  return raw;
++}
++
++// static
++BrowserOSScreencast* BrowserOSScreencast::Find(
++    int screencast_id,
++    content::BrowserContext* browser_context,
++    const ExtensionId& extension_id) {
++  auto it = GetScreencasts().find(screencast_id);
++  if (it == GetScreencasts().end()) {
++    return nullptr;
++  }
++  // Ids are sequential, so they must not let other extensions or profiles,
++  // incognito ones included, read or stop the capture
++  BrowserOSScreencast* screencast = it->second.get();
++  if (screencast->browser_context_ != browser_context ||
++      screencast->extension_id_ != extension_id) {
++    return nullptr;
++  }
++  return screencast;
++}
++
++BrowserOSScreencast::BrowserOSScreencast(
++    int id,
++    content::WebContents* web_contents,
++    content::BrowserContext* browser_context,
++    const ExtensionId& extension_id,
++    const Options& options)
++    : content::WebContentsObserver(web_contents),
++      id_(id),
++      browser_context_(browser_context),
++      extension_id_(extension_id),
++      options_(options),
++      video_consumer_(std::make_unique<content::DevToolsVideoConsumer>(
++          base::BindRepeating(&BrowserOSScreencast::OnFrameCaptured,
++                              base::Unretained(this)))),
++      // Unretained is safe: the timer is owned by the screencast.
++      idle_timer_(FROM_HERE,
++                  kIdleTimeout,
++                  base::BindRepeating(&BrowserOSScreencast::Stop,
++                                      base::Unretained(this))) {
++  video_consumer_->SetMinCapturePeriod(base::Seconds(1) / options_.max_fps);
++  video_consumer_->SetMinAndMaxFrameSize(gfx::Size(1, 1), options_.max_size);
++}
++
++BrowserOSScreencast::~BrowserOSScreencast() {
++  video_consumer_->StopCapture();
++}
++
++bool BrowserOSScreencast::ReadNextFrame(FrameCallback callback) {
++  if (pending_read_) {
++    return false;
++  }
++  pending_read_ = std::move(callback);
++  // A waiting reader keeps the screencast alive however static the page is
++  idle_timer_.Stop();
++  MaybeEncode();
++  return true;
++}
++
++void BrowserOSScreencast::Stop() {
++  VLOG(1) << "[browseros] Screencast " << id_ << " stopped after "
++          << captured_frames_ << " frames";
++  FrameCallback pending_read = std::move(pending_read_);
++  browser_os::ScreencastFrame ended;
++  ended.screencast_id = id_;
++  ended.sequence = last_read_sequence_;
++  ended.ended = true;
++  // Deletes |this|
++  GetScreencasts().erase(id_);
++  if (pending_read) {
++    std::move(pending_read).Run(std::move(ended));
++  }
++}
++
++bool BrowserOSScreencast::AttachToView() {
++  auto* view = static_cast<content::RenderWidgetHostViewBase*>(
++      web_contents()->GetRenderWidgetHostView());
++  if (!view) {
++    return false;
++  }
++  video_consumer_->SetFrameSinkId(view->GetFrameSinkId());
++  return true;
++}
++
++void BrowserOSScreencast::OnFrameCaptured(
++    scoped_refptr<media::VideoFrame> frame) {
++  OnFrame(
++      content::DevToolsVideoConsumer::GetSkBitmapFromFrame(std::move(frame)));
++}
++
++void BrowserOSScreencast::OnFrame(SkBitmap bitmap) {
++  if (bitmap.drawsNothing()) {
++    return;
++  }
++  // Replaces a frame nobody asked for yet; it counts as dropped
++  latest_frame_ = std::move(bitmap);
++  latest_frame_time_ = base::Time::Now();
++  captured_frames_++;
++  MaybeEncode();
++}
++
++void BrowserOSScreencast::MaybeEncode() {
++  if (!pending_read_ || encoding_ || latest_frame_.drawsNothing()) {
++    return;
++  }
++  encoding_ = true;
++
++  browser_os::ScreencastFrame frame;
++  frame.screencast_id = id_;
++  frame.sequence = captured_frames_;
++  frame.dropped_frames = captured_frames_ - last_read_sequence_ - 1;
++  frame.width = latest_frame_.width();
++  frame.height = latest_frame_.height();
++  frame.timestamp = latest_frame_time_.InMillisecondsFSinceUnixEpoch();
++  frame.ended = false;
++
++  base::ThreadPool::PostTaskAndReplyWithResult(
++      FROM_HERE,
++      {base::TaskPriority::USER_VISIBLE,
++       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
++      base::BindOnce(&EncodeScreenshotValue, std::move(latest_frame_),
++                     options_.encoding),
++      base::BindOnce(&BrowserOSScreencast::OnFrameEncoded,
++                     weak_factory_.GetWeakPtr(), std::move(frame)));
++  latest_frame_.reset();
++}
++
++void BrowserOSScreencast::OnFrameEncoded(browser_os::ScreencastFrame frame,
++                                         std::optional<base::Value> image) {
++  encoding_ = false;
++  if (!image) {
++    LOG(WARNING) << "[browseros] Screencast " << id_
++                 << " failed to encode frame " << frame.sequence;
++    MaybeEncode();
++    return;
++  }
++  frame.image = std::move(*image);
++  last_read_sequence_ = frame.sequence;
++  idle_timer_.Reset();
++  std::move(pending_read_).Run(std::move(frame));
++}
++
++void BrowserOSScreencast::PrimaryPageChanged(content::Page& page) {
++  // A cross-document navigation may swap the view the frames came from
++  if (!AttachToView()) {
++    Stop();
++  }
++}
++
++void BrowserOSScreencast::WebContentsDestroyed() {
++  Stop();
++}
++
++}  // namespace api
++}  // namespace extensions
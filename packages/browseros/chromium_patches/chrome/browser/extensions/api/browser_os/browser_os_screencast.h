@@ -0,0 +1,168 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_screencast.h b/chrome/browser/extensions/api/browser_os/browser_os_screencast.h
+new file mode 100644
+index 0000000000000..27c7dcff47d66
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_screencast.h
+@@ -0,0 +1,162 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SCREENCAST_H_
++#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SCREENCAST_H_
++
++#include <memory>
++#include <optional>
++#include <string>
++
++#include "base/functional/callback.h"
++#include "base/memory/raw_ptr.h"
++#include "base/memory/scoped_refptr.h"
++#include "base/memory/weak_ptr.h"
++#include "base/time/time.h"
++#include "base/timer/timer.h"
++#include "base/values.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder.h"
++#include "chrome/common/extensions/api/browser_os.h"
++#include "content/public/browser/web_contents_observer.h"
++#include "extensions/common/extension_id.h"
++#include "third_party/skia/include/core/SkBitmap.h"
++#include "ui/gfx/geometry/size.h"
++
++namespace content {
++class BrowserContext;
++class DevToolsVideoConsumer;
++class Page;
++class WebContents;
++}  // namespace content
++
++namespace media {
++class VideoFrame;
++}  // namespace media
++
++namespace extensions {
++namespace api {
++
++// A running screencast of one tab, read with readScreencastFrame.
++//
++// Frames come from the compositor's frame sink video capturer, so a frame
++// costs no page work and no per-call setup. Only the newest frame is kept:
++// frames that arrive before the reader asks for the next one replace it and
++// count as dropped, so a lagging reader never builds a backlog and only the
++// frames that are read get encoded. Screencasts live in a global registry
++// keyed by id until stopped, until their tab closes, or after sitting
++// unread for kIdleTimeout. Only the extension and browser context that
++// started a screencast can find it. UI thread only.
++class BrowserOSScreencast : public content::WebContentsObserver {
++ public:
++  using FrameCallback = base::OnceCallback<void(browser_os::ScreencastFrame)>;
++
++  // Screencasts without a pending read are stopped after this long
++  static constexpr base::TimeDelta kIdleTimeout = base::Seconds(60);
++  static constexpr int kDefaultMaxFps = 10;
++  static constexpr int kMaxFps = 60;
++
++  struct Options {
++    int max_fps = kDefaultMaxFps;
++    // Frames are scaled down to fit, keeping their aspect ratio
++    gfx::Size max_size;
++    ScreenshotEncoding encoding;
++  };
++
++  // Starts capturing |web_contents| for |extension_id| in
++  // |browser_context| and registers the screencast under a fresh id. Returns
++  // null and sets |error| if the tab cannot be captured.
++  static BrowserOSScreencast* Start(content::WebContents* web_contents,
++                                    content::BrowserContext* browser_context,
++                                    const ExtensionId& extension_id,
++                                    const Options& options,
++                                    std::string* error);
++
++  // Registers a screencast like Start() without starting the capturer.
++  // Frames are fed in with AddFrameForTesting().
++  static BrowserOSScreencast* StartForTesting(
++      content::WebContents* web_contents,
++      content::BrowserContext* browser_context,
++      const ExtensionId& extension_id,
++      const Options& options);
++
++  // Returns the running screencast with |screencast_id| if |extension_id| in
++  // |browser_context| started it, or null.
++  static BrowserOSScreencast* Find(int screencast_id,
++                                   content::BrowserContext* browser_context,
++                                   const ExtensionId& extension_id);
++
++  BrowserOSScreencast(const BrowserOSScreencast&) = delete;
++  BrowserOSScreencast& operator=(const BrowserOSScreencast&) = delete;
++  ~BrowserOSScreencast() override;
++
++  int id() const { return id_; }
++
++  // Runs |callback| with the first frame captured after the previous read,
++  // waiting for one if needed. Returns false if another read is already
++  // pending.
++  bool ReadNextFrame(FrameCallback callback);
++
++  // Stops capturing and unregisters, which deletes |this|. A pending read
++  // gets an ended frame.
++  void Stop();
++
++  void AddFrameForTesting(SkBitmap bitmap) { OnFrame(std::move(bitmap)); }
++
++ private:
++  BrowserOSScreencast(int id,
++                      content::WebContents* web_contents,
++                      content::BrowserContext* browser_context,
++                      const ExtensionId& extension_id,
++                      const Options& options);
++
++  // Creates a screencast and adds it to the registry. Returns null and sets
++  // |error| if the tab has no view.
++  static BrowserOSScreencast* Register(content::WebContents* web_contents,
++                                       content::BrowserContext* browser_context,
++                                       const ExtensionId& extension_id,
++                                       const Options& options,
++                                       std::string* error);
++
++  // Points the capturer at the tab's current view. Returns false if the tab
++  // has none.
++  bool AttachToView();
++
++  void OnFrameCaptured(scoped_refptr<media::VideoFrame> frame);
++  void OnFrame(SkBitmap bitmap);
++
++  // Encodes the newest frame on a worker if a reader waits for it and no
++  // other frame is being encoded.
++  void MaybeEncode();
++  void OnFrameEncoded(browser_os::ScreencastFrame frame,
++                      std::optional<base::Value> image);
++
++  // content::WebContentsObserver:
++  void PrimaryPageChanged(content::Page& page) override;
++  void WebContentsDestroyed() override;
++
++  const int id_;
++  // Caller that started the screencast; only compared, never dereferenced
++  const raw_ptr<content::BrowserContext> browser_context_;
++  const ExtensionId extension_id_;
++  const Options options_;
++  std::unique_ptr<content::DevToolsVideoConsumer> video_consumer_;
++
++  // Newest frame not yet handed to the encoder
++  SkBitmap latest_frame_;
++  base::Time latest_frame_time_;
++  int captured_frames_ = 0;
++  int last_read_sequence_ = 0;
++  bool encoding_ = false;
++
++  FrameCallback pending_read_;
++  // Retains its task so reads can Stop() and deliveries Reset() it
++  base::RetainingOneShotTimer idle_timer_;
++
++  base::WeakPtrFactory<BrowserOSScreencast> weak_factory_{this};
++};
++
++}  // namespace api
++}  // namespace extensions
++
++#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SCREENCAST_H_
@@ -0,0 +1,150 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_screencast_unittest.cc b/chrome/browser/extensions/api/browser_os/browser_os_screencast_unittest.cc
+new file mode 100644
+index 0000000000000..94d4c28456e33
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_screencast_unittest.cc
+@@ -0,0 +1,144 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_screencast.h"
++
++#include <memory>
++
++#include "base/functional/callback_helpers.h"
++#include "base/test/test_future.h"
++#include "content/public/test/test_browser_context.h"
++#include "content/public/test/test_renderer_host.h"
++#include "testing/gtest/include/gtest/gtest.h"
++#include "third_party/skia/include/core/SkBitmap.h"
++#include "third_party/skia/include/core/SkColor.h"
++#include "url/gurl.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++constexpr char kExtensionId[] = "abcdefghijklmnopabcdefghijklmnop";
++constexpr char kOtherExtensionId[] = "ponmlkjihgfedcbaponmlkjihgfedcba";
++
++SkBitmap MakeFrame(SkColor color = SK_ColorWHITE) {
++  SkBitmap bitmap;
++  bitmap.allocN32Pixels(16, 12);
++  bitmap.eraseColor(color);
++  return bitmap;
++}
++
++class BrowserOSScreencastTest : public content::RenderViewHostTestHarness {
++ protected:
++  BrowserOSScreencastTest()
++      : content::RenderViewHostTestHarness(
++            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
++
++  void SetUp() override {
++    content::RenderViewHostTestHarness::SetUp();
++    NavigateAndCommit(GURL("https://example.test/feed"));
++    BrowserOSScreencast::Options options;
++    options.max_size = gfx::Size(16, 12);
++    screencast_id_ =
++        BrowserOSScreencast::StartForTesting(web_contents(), browser_context(),
++                                             kExtensionId, options)
++            ->id();
++  }
++
++  BrowserOSScreencast* screencast() {
++    return BrowserOSScreencast::Find(screencast_id_, browser_context(),
++                                     kExtensionId);
++  }
++
++  // Reads the next frame, waiting for it to be encoded
++  browser_os::ScreencastFrame ReadFrame() {
++    base::test::TestFuture<browser_os::ScreencastFrame> frame;
++    EXPECT_TRUE(screencast()->ReadNextFrame(frame.GetCallback()));
++    return frame.Take();
++  }
++
++  int screencast_id_ = 0;
++};
++
++// =============================================================================
++// Frame Tests
++// =============================================================================
++
++TEST_F(BrowserOSScreencastTest, CountsFramesReplacedBeforeARead) {
++  screencast()->AddFrameForTesting(MakeFrame(SK_ColorRED));
++  screencast()->AddFrameForTesting(MakeFrame(SK_ColorGREEN));
++  screencast()->AddFrameForTesting(MakeFrame(SK_ColorBLUE));
++
++  browser_os::ScreencastFrame first = ReadFrame();
++  EXPECT_EQ(3, first.sequence);
++  EXPECT_EQ(2, first.dropped_frames);
++  EXPECT_FALSE(first.ended);
++  EXPECT_EQ(16, first.width);
++
++  screencast()->AddFrameForTesting(MakeFrame());
++  browser_os::ScreencastFrame second = ReadFrame();
++  EXPECT_EQ(4, second.sequence);
++  EXPECT_EQ(0, second.dropped_frames);
++}
++
++TEST_F(BrowserOSScreencastTest, ReadWaitsForNextFrame) {
++  base::test::TestFuture<browser_os::ScreencastFrame> frame;
++  ASSERT_TRUE(screencast()->ReadNextFrame(frame.GetCallback()));
++  EXPECT_FALSE(screencast()->ReadNextFrame(base::DoNothing()));
++  EXPECT_FALSE(frame.IsReady());
++
++  screencast()->AddFrameForTesting(MakeFrame());
++  EXPECT_EQ(1, frame.Take().sequence);
++}
++
++// =============================================================================
++// Lifetime Tests
++// =============================================================================
++
++TEST_F(BrowserOSScreencastTest, StopEndsPendingRead) {
++  base::test::TestFuture<browser_os::ScreencastFrame> frame;
++  ASSERT_TRUE(screencast()->ReadNextFrame(frame.GetCallback()));
++
++  screencast()->Stop();
++  ASSERT_TRUE(frame.IsReady());
++  EXPECT_TRUE(frame.Get().ended);
++  EXPECT_FALSE(screencast());
++}
++
++TEST_F(BrowserOSScreencastTest, TabDestructionStopsScreencast) {
++  base::test::TestFuture<browser_os::ScreencastFrame> frame;
++  ASSERT_TRUE(screencast()->ReadNextFrame(frame.GetCallback()));
++
++  DeleteContents();
++  ASSERT_TRUE(frame.IsReady());
++  EXPECT_TRUE(frame.Get().ended);
++  EXPECT_FALSE(screencast());
++}
++
++TEST_F(BrowserOSScreencastTest, StopsWhenUnreadAfterAFrame) {
++  screencast()->AddFrameForTesting(MakeFrame());
++  ReadFrame();
++
++  task_environment()->FastForwardBy(BrowserOSScreencast::kIdleTimeout / 2);
++  EXPECT_TRUE(screencast());
++  task_environment()->FastForwardBy(BrowserOSScreencast::kIdleTimeout / 2);
++  EXPECT_FALSE(screencast());
++}
++
++// =============================================================================
++// Access Tests
++// =============================================================================
++
++TEST_F(BrowserOSScreencastTest, OnlyStarterCanFindScreencast) {
++  content::TestBrowserContext other_context;
++  EXPECT_TRUE(screencast());
++  EXPECT_FALSE(BrowserOSScreencast::Find(screencast_id_, browser_context(),
++                                         kOtherExtensionId));
++  EXPECT_FALSE(BrowserOSScreencast::Find(screencast_id_, &other_context,
++                                         kExtensionId));
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,158 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_screenshot_diff.cc b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_diff.cc
+new file mode 100644
+index 0000000000000..4cc44d97106fc
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_diff.cc
+@@ -0,0 +1,152 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_screenshot_diff.h"
++
++#include <algorithm>
++#include <cstdint>
++#include <cstring>
++#include <utility>
++
++#include "base/check_op.h"
++#include "chrome/common/extensions/api/browser_os.h"
++#include "third_party/skia/include/core/SkRect.h"
++
++namespace extensions {
++namespace api {
++
++std::vector<gfx::Rect> ComputeDirtyTiles(const SkBitmap& previous,
++                                         const SkBitmap& current,
++                                         int tile_size) {
++  DCHECK_EQ(previous.width(), current.width());
++  DCHECK_EQ(previous.height(), current.height());
++  DCHECK_EQ(previous.colorType(), current.colorType());
++  DCHECK_GT(tile_size, 0);
++
++  const int width = current.width();
++  const int height = current.height();
++  const size_t pixel_bytes = current.bytesPerPixel();
++  const int columns = (width + tile_size - 1) / tile_size;
++  std::vector<gfx::Rect> dirty;
++  std::vector<bool> dirty_columns(columns);
++
++  for (int tile_y = 0; tile_y < height; tile_y += tile_size) {
++    const int tile_height = std::min(tile_size, height - tile_y);
++    std::fill(dirty_columns.begin(), dirty_columns.end(), false);
++    int dirty_count = 0;
++    for (int y = tile_y; y < tile_y + tile_height && dirty_count < columns;
++         ++y) {
++      const auto* previous_row =
++          static_cast<const uint8_t*>(previous.getAddr(0, y));
++      const auto* row = static_cast<const uint8_t*>(current.getAddr(0, y));
++      if (!std::memcmp(previous_row, row, width * pixel_bytes)) {
++        continue;
++      }
++      for (int column = 0; column < columns; ++column) {
++        if (dirty_columns[column]) {
++          continue;
++        }
++        const size_t offset = column * tile_size * pixel_bytes;
++        const size_t bytes =
++            std::min(tile_size, width - column * tile_size) * pixel_bytes;
++        if (std::memcmp(previous_row + offset, row + offset, bytes)) {
++          dirty_columns[column] = true;
++          ++dirty_count;
++        }
++      }
++    }
++
++    for (int column = 0; column < columns;) {
++      if (!dirty_columns[column]) {
++        ++column;
++        continue;
++      }
++      int end = column;
++      while (end < columns && dirty_columns[end]) {
++        ++end;
++      }
++      const int x = column * tile_size;
++      dirty.emplace_back(x, tile_y, std::min(end * tile_size, width) - x,
++                         tile_height);
++      column = end;
++    }
++  }
++  return dirty;
++}
++
++ScreenshotDiffOutput::ScreenshotDiffOutput() = default;
++ScreenshotDiffOutput::ScreenshotDiffOutput(ScreenshotDiffOutput&&) = default;
++ScreenshotDiffOutput& ScreenshotDiffOutput::operator=(ScreenshotDiffOutput&&) =
++    default;
++ScreenshotDiffOutput::~ScreenshotDiffOutput() = default;
++
++ScreenshotDiffOutput DiffAndEncodeScreenshot(SkBitmap current,
++                                             SkBitmap previous,
++                                             int sequence,
++                                             int base_sequence,
++                                             ScreenshotEncoding encoding) {
++  browser_os::ScreenshotDiff diff;
++  diff.sequence = sequence;
++  diff.width = current.width();
++  diff.height = current.height();
++  diff.keyframe = previous.drawsNothing() ||
++                  previous.width() != current.width() ||
++                  previous.height() != current.height() ||
++                  previous.colorType() != current.colorType();
++  diff.base_sequence = diff.keyframe ? 0 : base_sequence;
++
++  const std::vector<gfx::Rect> rects =
++      diff.keyframe ? std::vector<gfx::Rect>{gfx::Rect(current.width(),
++                                                       current.height())}
++                    : ComputeDirtyTiles(previous, current);
++
++  ScreenshotDiffOutput output;
++  for (const gfx::Rect& rect : rects) {
++    SkBitmap tile_bitmap;
++    if (!current.extractSubset(&tile_bitmap,
++                               SkIRect::MakeXYWH(rect.x(), rect.y(),
++                                                 rect.width(),
++                                                 rect.height()))) {
++      return output;
++    }
++    std::optional<base::Value> image =
++        EncodeScreenshotValue(std::move(tile_bitmap), encoding);
++    if (!image) {
++      return output;
++    }
++    browser_os::ScreenshotTile tile;
++    tile.x = rect.x();
++    tile.y = rect.y();
++    tile.width = rect.width();
++    tile.height = rect.height();
++    tile.image = std::move(*image);
++    diff.tiles.push_back(std::move(tile));
++  }
++
++  output.value = base::Value(diff.ToValue());
++  output.frame = std::move(current);
++  return output;
++}
++
++BrowserOSScreenshotCache::BrowserOSScreenshotCache(
++    content::WebContents* web_contents)
++    : content::WebContentsUserData<BrowserOSScreenshotCache>(*web_contents) {}
++
++BrowserOSScreenshotCache::~BrowserOSScreenshotCache() = default;
++
++void BrowserOSScreenshotCache::StoreFrame(int sequence,
++                                          const gfx::Rect& region,
++                                          SkBitmap bitmap) {
++  if (sequence < last_frame_.sequence) {
++    return;
++  }
++  last_frame_.sequence = sequence;
++  last_frame_.region = region;
++  last_frame_.bitmap = std::move(bitmap);
++}
++
++WEB_CONTENTS_USER_DATA_KEY_IMPL(BrowserOSScreenshotCache);
++
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,106 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_screenshot_diff.h b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_diff.h
+new file mode 100644
+index 0000000000000..9025c5001a659
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_diff.h
+@@ -0,0 +1,100 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SCREENSHOT_DIFF_H_
++#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SCREENSHOT_DIFF_H_
++
++#include <optional>
++#include <vector>
++
++#include "base/values.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder.h"
++#include "content/public/browser/web_contents_user_data.h"
++#include "third_party/skia/include/core/SkBitmap.h"
++#include "ui/gfx/geometry/rect.h"
++
++namespace content {
++class WebContents;
++}  // namespace content
++
++namespace extensions {
++namespace api {
++
++// Edge of the square tiles diff screenshots are compared and sent in, in
++// bitmap pixels. Tiles at the right and bottom edges may be smaller.
++inline constexpr int kScreenshotTileSize = 64;
++
++// Rects of the tiles that differ between two bitmaps of the same size and
++// color type. Dirty tiles that are adjacent within a tile row are merged
++// into one rect. Rows are first compared whole, since most rows of a
++// mostly-static page are unchanged; memcmp compares them with the
++// platform's vector instructions.
++std::vector<gfx::Rect> ComputeDirtyTiles(const SkBitmap& previous,
++                                         const SkBitmap& current,
++                                         int tile_size = kScreenshotTileSize);
++
++struct ScreenshotDiffOutput {
++  ScreenshotDiffOutput();
++  ScreenshotDiffOutput(ScreenshotDiffOutput&&);
++  ScreenshotDiffOutput& operator=(ScreenshotDiffOutput&&);
++  ~ScreenshotDiffOutput();
++
++  // The ScreenshotDiff dictionary, or nullopt if a tile failed to encode
++  std::optional<base::Value> value;
++  // The frame |value| describes, kept as the base of the next diff
++  SkBitmap frame;
++};
++
++// Compares |current| against |previous|, the frame numbered
++// |base_sequence|, and encodes the tiles that changed. |current| is sent
++// whole, as a keyframe, if |previous| is empty or differs in size. Runs on
++// any thread.
++ScreenshotDiffOutput DiffAndEncodeScreenshot(SkBitmap current,
++                                             SkBitmap previous,
++                                             int sequence,
++                                             int base_sequence,
++                                             ScreenshotEncoding encoding);
++
++// Per-tab frames of diff captures. Only the last frame is kept, so a tab
++// holds at most one bitmap, released when the tab closes.
++class BrowserOSScreenshotCache
++    : public content::WebContentsUserData<BrowserOSScreenshotCache> {
++ public:
++  struct Frame {
++    // 0 if no frame was captured yet
++    int sequence = 0;
++    // Captured region of the view in DIPs, or empty for all of it
++    gfx::Rect region;
++    SkBitmap bitmap;
++  };
++
++  BrowserOSScreenshotCache(const BrowserOSScreenshotCache&) = delete;
++  BrowserOSScreenshotCache& operator=(const BrowserOSScreenshotCache&) =
++      delete;
++  ~BrowserOSScreenshotCache() override;
++
++  // Sequence number for a new diff capture.
++  int NextSequence() { return ++last_sequence_; }
++
++  const Frame& last_frame() const { return last_frame_; }
++
++  // Keeps |bitmap| as frame |sequence| unless a newer frame is kept already,
++  // which happens when captures overlap.
++  void StoreFrame(int sequence, const gfx::Rect& region, SkBitmap bitmap);
++
++ private:
++  friend class content::WebContentsUserData<BrowserOSScreenshotCache>;
++
++  explicit BrowserOSScreenshotCache(content::WebContents* web_contents);
++
++  int last_sequence_ = 0;
++  Frame last_frame_;
++
++  WEB_CONTENTS_USER_DATA_KEY_DECL();
++};
++
++}  // namespace api
++}  // namespace extensions
++
++#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SCREENSHOT_DIFF_H_
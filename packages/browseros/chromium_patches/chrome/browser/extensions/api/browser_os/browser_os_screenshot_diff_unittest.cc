@@ -0,0 +1,137 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_screenshot_diff_unittest.cc b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_diff_unittest.cc
+new file mode 100644
+index 0000000000000..6746c2faf85a1
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_diff_unittest.cc
+@@ -0,0 +1,131 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_screenshot_diff.h"
++
++#include <vector>
++
++#include "testing/gtest/include/gtest/gtest.h"
++#include "third_party/skia/include/core/SkBitmap.h"
++#include "third_party/skia/include/core/SkColor.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++SkBitmap MakeBitmap(int width, int height, SkColor color = SK_ColorWHITE) {
++  SkBitmap bitmap;
++  bitmap.allocN32Pixels(width, height);
++  bitmap.eraseColor(color);
++  return bitmap;
++}
++
++SkBitmap Copy(const SkBitmap& bitmap) {
++  SkBitmap copy;
++  copy.allocPixels(bitmap.info());
++  bitmap.readPixels(copy.pixmap());
++  return copy;
++}
++
++// =============================================================================
++// Dirty Tile Tests
++// =============================================================================
++
++TEST(ScreenshotDiffTest, IdenticalFramesHaveNoDirtyTiles) {
++  SkBitmap previous = MakeBitmap(200, 150);
++  EXPECT_TRUE(ComputeDirtyTiles(previous, Copy(previous), 64).empty());
++}
++
++TEST(ScreenshotDiffTest, FindsTileOfChangedPixel) {
++  SkBitmap previous = MakeBitmap(200, 150);
++  SkBitmap current = Copy(previous);
++  *current.getAddr32(70, 10) = SK_ColorRED;
++
++  std::vector<gfx::Rect> dirty = ComputeDirtyTiles(previous, current, 64);
++  ASSERT_EQ(1u, dirty.size());
++  EXPECT_EQ(gfx::Rect(64, 0, 64, 64), dirty[0]);
++}
++
++TEST(ScreenshotDiffTest, EdgeTilesAreClipped) {
++  SkBitmap previous = MakeBitmap(200, 150);
++  SkBitmap current = Copy(previous);
++  *current.getAddr32(199, 149) = SK_ColorRED;
++
++  std::vector<gfx::Rect> dirty = ComputeDirtyTiles(previous, current, 64);
++  ASSERT_EQ(1u, dirty.size());
++  EXPECT_EQ(gfx::Rect(192, 128, 8, 22), dirty[0]);
++}
++
++TEST(ScreenshotDiffTest, MergesAdjacentTilesOfARow) {
++  SkBitmap previous = MakeBitmap(256, 128);
++  SkBitmap current = Copy(previous);
++  *current.getAddr32(10, 5) = SK_ColorRED;
++  *current.getAddr32(70, 60) = SK_ColorRED;
++  *current.getAddr32(200, 5) = SK_ColorRED;
++  *current.getAddr32(10, 100) = SK_ColorRED;
++
++  std::vector<gfx::Rect> dirty = ComputeDirtyTiles(previous, current, 64);
++  ASSERT_EQ(3u, dirty.size());
++  EXPECT_EQ(gfx::Rect(0, 0, 128, 64), dirty[0]);
++  EXPECT_EQ(gfx::Rect(192, 0, 64, 64), dirty[1]);
++  EXPECT_EQ(gfx::Rect(0, 64, 64, 64), dirty[2]);
++}
++
++// =============================================================================
++// Encoding Tests
++// =============================================================================
++
++TEST(ScreenshotDiffTest, FirstFrameIsKeyframe) {
++  ScreenshotDiffOutput output = DiffAndEncodeScreenshot(
++      MakeBitmap(100, 80), SkBitmap(), 1, 0, ScreenshotEncoding());
++  ASSERT_TRUE(output.value && output.value->is_dict());
++
++  const base::Value::Dict& diff = output.value->GetDict();
++  EXPECT_EQ(1, diff.FindInt("sequence"));
++  EXPECT_EQ(0, diff.FindInt("baseSequence"));
++  EXPECT_EQ(true, diff.FindBool("keyframe"));
++  const base::Value::List* tiles = diff.FindList("tiles");
++  ASSERT_TRUE(tiles);
++  ASSERT_EQ(1u, tiles->size());
++  EXPECT_EQ(100, (*tiles)[0].GetDict().FindInt("width"));
++  EXPECT_EQ(80, (*tiles)[0].GetDict().FindInt("height"));
++  EXPECT_EQ(100, output.frame.width());
++}
++
++TEST(ScreenshotDiffTest, SendsOnlyChangedTiles) {
++  SkBitmap previous = MakeBitmap(256, 256);
++  SkBitmap current = Copy(previous);
++  *current.getAddr32(130, 130) = SK_ColorRED;
++
++  ScreenshotEncoding encoding;
++  encoding.binary = true;
++  ScreenshotDiffOutput output =
++      DiffAndEncodeScreenshot(current, previous, 5, 4, encoding);
++  ASSERT_TRUE(output.value);
++
++  const base::Value::Dict& diff = output.value->GetDict();
++  EXPECT_EQ(4, diff.FindInt("baseSequence"));
++  EXPECT_EQ(false, diff.FindBool("keyframe"));
++  const base::Value::List* tiles = diff.FindList("tiles");
++  ASSERT_TRUE(tiles);
++  ASSERT_EQ(1u, tiles->size());
++  const base::Value::Dict& tile = (*tiles)[0].GetDict();
++  EXPECT_EQ(128, tile.FindInt("x"));
++  EXPECT_EQ(128, tile.FindInt("y"));
++  ASSERT_TRUE(tile.Find("image"));
++  EXPECT_TRUE(tile.Find("image")->is_blob());
++}
++
++TEST(ScreenshotDiffTest, ResizedFrameIsKeyframe) {
++  ScreenshotDiffOutput output =
++      DiffAndEncodeScreenshot(MakeBitmap(100, 80), MakeBitmap(80, 80), 3, 2,
++                              ScreenshotEncoding());
++  ASSERT_TRUE(output.value);
++  EXPECT_EQ(true, output.value->GetDict().FindBool("keyframe"));
++  EXPECT_EQ(0, output.value->GetDict().FindInt("baseSequence"));
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,75 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder.cc b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder.cc
+new file mode 100644
+index 0000000000000..5bcc18d46f366
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder.cc
+@@ -0,0 +1,69 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder.h"
++
++#include <utility>
++
++#include "base/base64.h"
++#include "base/notreached.h"
++#include "base/strings/strcat.h"
++#include "third_party/skia/include/core/SkBitmap.h"
++#include "ui/gfx/codec/jpeg_codec.h"
++#include "ui/gfx/codec/png_codec.h"
++#include "ui/gfx/codec/webp_codec.h"
++
++namespace extensions {
++namespace api {
++
++std::string_view GetScreenshotMimeType(ScreenshotFormat format) {
++  switch (format) {
++    case ScreenshotFormat::kPng:
++      return "image/png";
++    case ScreenshotFormat::kJpeg:
++      return "image/jpeg";
++    case ScreenshotFormat::kWebp:
++      return "image/webp";
++  }
++  NOTREACHED();
++}
++
++std::optional<std::vector<uint8_t>> EncodeScreenshot(const SkBitmap& bitmap,
++                                                     ScreenshotFormat format,
++                                                     int quality) {
++  switch (format) {
++    case ScreenshotFormat::kPng:
++      return gfx::PNGCodec::EncodeBGRASkBitmap(bitmap,
++                                               /*discard_transparency=*/false);
++    case ScreenshotFormat::kJpeg:
++      return gfx::JPEGCodec::Encode(bitmap, quality);
++    case ScreenshotFormat::kWebp:
++      return gfx::WebpCodec::Encode(bitmap, quality);
++  }
++  NOTREACHED();
++}
++
++std::string MakeScreenshotDataUrl(ScreenshotFormat format,
++                                  base::span<const uint8_t> bytes) {
++  std::string url = base::StrCat({"data:", GetScreenshotMimeType(format),
++                                  ";base64,"});
++  base::Base64EncodeAppend(bytes, &url);
++  return url;
++}
++
++std::optional<base::Value> EncodeScreenshotValue(SkBitmap bitmap,
++                                                 ScreenshotEncoding encoding) {
++  std::optional<std::vector<uint8_t>> bytes =
++      EncodeScreenshot(bitmap, encoding.format, encoding.quality);
++  if (!bytes) {
++    return std::nullopt;
++  }
++  if (encoding.binary) {
++    return base::Value(std::move(*bytes));
++  }
++  return base::Value(MakeScreenshotDataUrl(encoding.format, *bytes));
++}
++
++}  // namespace api
++}  // namespace extensions
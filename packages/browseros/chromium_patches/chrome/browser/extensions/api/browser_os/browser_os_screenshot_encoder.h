@@ -0,0 +1,69 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder.h b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder.h
+new file mode 100644
+index 0000000000000..3220286ac499f
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder.h
+@@ -0,0 +1,63 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SCREENSHOT_ENCODER_H_
++#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SCREENSHOT_ENCODER_H_
++
++#include <cstdint>
++#include <optional>
++#include <string>
++#include <string_view>
++#include <vector>
++
++#include "base/containers/span.h"
++#include "base/values.h"
++
++class SkBitmap;
++
++namespace extensions {
++namespace api {
++
++// Image formats of captureScreenshot
++enum class ScreenshotFormat {
++  kPng,
++  kJpeg,
++  kWebp,
++};
++
++// Quality used for JPEG and WebP when the caller gives none
++inline constexpr int kDefaultScreenshotQuality = 80;
++
++struct ScreenshotEncoding {
++  ScreenshotFormat format = ScreenshotFormat::kPng;
++  // 0-100, for JPEG and WebP only
++  int quality = kDefaultScreenshotQuality;
++  // Raw bytes instead of a base64 data URL
++  bool binary = false;
++};
++
++// MIME type of |format|, e.g. "image/png".
++std::string_view GetScreenshotMimeType(ScreenshotFormat format);
++
++// Encodes |bitmap| in |format|. |quality| is ignored for PNG. Returns nullopt
++// if the encoder fails.
++std::optional<std::vector<uint8_t>> EncodeScreenshot(const SkBitmap& bitmap,
++                                                     ScreenshotFormat format,
++                                                     int quality);
++
++// "data:<mime type>;base64,<bytes>", base64-encoded straight into the URL.
++std::string MakeScreenshotDataUrl(ScreenshotFormat format,
++                                  base::span<const uint8_t> bytes);
++
++// Encodes |bitmap| as captureScreenshot returns it: a data URL string, or a
++// binary value that reaches the extension as an ArrayBuffer. Runs on any
++// thread, and is meant for a worker since encoding a full-HD frame takes
++// tens of milliseconds.
++std::optional<base::Value> EncodeScreenshotValue(SkBitmap bitmap,
++                                                 ScreenshotEncoding encoding);
++
++}  // namespace api
++}  // namespace extensions
++
++#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SCREENSHOT_ENCODER_H_
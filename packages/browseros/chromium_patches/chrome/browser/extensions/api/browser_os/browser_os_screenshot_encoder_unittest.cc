@@ -0,0 +1,119 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder_unittest.cc b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder_unittest.cc
+new file mode 100644
+index 0000000000000..dac22e2797778
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder_unittest.cc
+@@ -0,0 +1,113 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_screenshot_encoder.h"
++
++#include <algorithm>
++#include <cstdint>
++#include <optional>
++#include <string>
++#include <string_view>
++#include <vector>
++
++#include "base/base64.h"
++#include "base/strings/string_util.h"
++#include "testing/gtest/include/gtest/gtest.h"
++#include "third_party/skia/include/core/SkBitmap.h"
++#include "third_party/skia/include/core/SkColor.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++SkBitmap MakeBitmap() {
++  SkBitmap bitmap;
++  bitmap.allocN32Pixels(64, 48);
++  bitmap.eraseColor(SK_ColorBLUE);
++  return bitmap;
++}
++
++bool StartsWithBytes(const std::vector<uint8_t>& data,
++                     std::string_view magic,
++                     size_t offset = 0) {
++  return data.size() >= offset + magic.size() &&
++         std::equal(magic.begin(), magic.end(), data.begin() + offset);
++}
++
++// =============================================================================
++// Encoding Tests
++// =============================================================================
++
++TEST(ScreenshotEncoderTest, EncodesEachFormat) {
++  SkBitmap bitmap = MakeBitmap();
++
++  std::optional<std::vector<uint8_t>> png =
++      EncodeScreenshot(bitmap, ScreenshotFormat::kPng, 0);
++  ASSERT_TRUE(png);
++  EXPECT_TRUE(StartsWithBytes(*png, "\x89PNG"));
++
++  std::optional<std::vector<uint8_t>> jpeg =
++      EncodeScreenshot(bitmap, ScreenshotFormat::kJpeg, 80);
++  ASSERT_TRUE(jpeg);
++  EXPECT_TRUE(StartsWithBytes(*jpeg, "\xFF\xD8\xFF"));
++
++  std::optional<std::vector<uint8_t>> webp =
++      EncodeScreenshot(bitmap, ScreenshotFormat::kWebp, 80);
++  ASSERT_TRUE(webp);
++  EXPECT_TRUE(StartsWithBytes(*webp, "RIFF"));
++  EXPECT_TRUE(StartsWithBytes(*webp, "WEBP", 8));
++}
++
++TEST(ScreenshotEncoderTest, LowerQualityIsSmaller) {
++  SkBitmap bitmap;
++  bitmap.allocN32Pixels(256, 256);
++  for (int y = 0; y < bitmap.height(); ++y) {
++    for (int x = 0; x < bitmap.width(); ++x) {
++      *bitmap.getAddr32(x, y) = SkColorSetRGB(x, y, (x * y) & 0xFF);
++    }
++  }
++
++  std::optional<std::vector<uint8_t>> low =
++      EncodeScreenshot(bitmap, ScreenshotFormat::kJpeg, 10);
++  std::optional<std::vector<uint8_t>> high =
++      EncodeScreenshot(bitmap, ScreenshotFormat::kJpeg, 95);
++  ASSERT_TRUE(low && high);
++  EXPECT_LT(low->size(), high->size());
++}
++
++// =============================================================================
++// Result Tests
++// =============================================================================
++
++TEST(ScreenshotEncoderTest, ReturnsDataUrlByDefault) {
++  ScreenshotEncoding encoding;
++  encoding.format = ScreenshotFormat::kJpeg;
++  std::optional<base::Value> value =
++      EncodeScreenshotValue(MakeBitmap(), encoding);
++  ASSERT_TRUE(value && value->is_string());
++
++  const std::string& url = value->GetString();
++  constexpr std::string_view kPrefix = "data:image/jpeg;base64,";
++  ASSERT_TRUE(base::StartsWith(url, kPrefix));
++  std::optional<std::vector<uint8_t>> decoded =
++      base::Base64Decode(url.substr(kPrefix.size()));
++  ASSERT_TRUE(decoded);
++  EXPECT_EQ(*EncodeScreenshot(MakeBitmap(), ScreenshotFormat::kJpeg,
++                              kDefaultScreenshotQuality),
++            *decoded);
++}
++
++TEST(ScreenshotEncoderTest, ReturnsRawBytesWhenBinary) {
++  ScreenshotEncoding encoding;
++  encoding.format = ScreenshotFormat::kWebp;
++  encoding.binary = true;
++  std::optional<base::Value> value =
++      EncodeScreenshotValue(MakeBitmap(), encoding);
++  ASSERT_TRUE(value && value->is_blob());
++  EXPECT_TRUE(StartsWithBytes(value->GetBlob(), "RIFF"));
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,158 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_screenshot_highlights.cc b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_highlights.cc
+new file mode 100644
+index 0000000000000..778333730077c
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_highlights.cc
+@@ -0,0 +1,152 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_screenshot_highlights.h"
++
++#include <algorithm>
++#include <string>
++
++#include "base/strings/string_number_conversions.h"
++#include "cc/paint/paint_flags.h"
++#include "cc/paint/skia_paint_canvas.h"
++#include "third_party/skia/include/core/SkBitmap.h"
++#include "third_party/skia/include/core/SkColor.h"
++#include "ui/gfx/canvas.h"
++#include "ui/gfx/font_list.h"
++#include "ui/gfx/geometry/rect.h"
++#include "ui/gfx/geometry/rect_conversions.h"
++#include "ui/gfx/text_utils.h"
++
++namespace extensions {
++namespace api {
++
++namespace {
++
++// Sizes in DIPs, scaled with the bitmap. They match the look of the
++// in-page boxes this replaced.
++constexpr float kBorderWidth = 2.0f;
++constexpr float kLabelHeight = 20.0f;
++constexpr float kLabelPadding = 7.0f;
++constexpr float kLabelOffset = 22.0f;
++constexpr float kLabelRadius = 3.0f;
++constexpr int kLabelFontSize = 14;
++
++constexpr SkColor kBoxColor = SkColorSetRGB(0x1E, 0x40, 0xAF);
++constexpr SkColor kLabelColor = SkColorSetARGB(0xE6, 0x25, 0x63, 0xEB);
++
++bool ShouldHighlight(const NodeInfo& node) {
++  if (!node.in_viewport) {
++    return false;
++  }
++  return node.node_type == browser_os::InteractiveNodeType::kClickable ||
++         node.node_type == browser_os::InteractiveNodeType::kTypeable ||
++         node.node_type == browser_os::InteractiveNodeType::kSelectable;
++}
++
++void PaintLabel(gfx::Canvas& canvas,
++                const gfx::FontList& font_list,
++                const gfx::RectF& box,
++                uint32_t node_id,
++                float scale) {
++  const std::u16string text = base::NumberToString16(node_id);
++  gfx::RectF label(box.x(), box.y() - kLabelOffset * scale,
++                   gfx::GetStringWidth(text, font_list) +
++                       2 * kLabelPadding * scale,
++                   kLabelHeight * scale);
++  // Labels of boxes at the top edge move inside the box instead of being cut
++  // off
++  if (label.y() < 0) {
++    label.set_y(box.y());
++  }
++
++  cc::PaintFlags flags;
++  flags.setAntiAlias(true);
++  flags.setColor(kLabelColor);
++  canvas.DrawRoundRect(label, kLabelRadius * scale, flags);
++  canvas.DrawStringRectWithFlags(text, font_list, SK_ColorWHITE,
++                                 gfx::ToEnclosingRect(label),
++                                 gfx::Canvas::TEXT_ALIGN_CENTER);
++}
++
++}  // namespace
++
++ScreenshotHighlights::ScreenshotHighlights() = default;
++ScreenshotHighlights::ScreenshotHighlights(const ScreenshotHighlights&) =
++    default;
++ScreenshotHighlights& ScreenshotHighlights::operator=(
++    const ScreenshotHighlights&) = default;
++ScreenshotHighlights::ScreenshotHighlights(ScreenshotHighlights&&) = default;
++ScreenshotHighlights& ScreenshotHighlights::operator=(ScreenshotHighlights&&) =
++    default;
++ScreenshotHighlights::~ScreenshotHighlights() = default;
++
++ScreenshotHighlights CollectScreenshotHighlights(
++    const BrowserOSNodeIdStore::NodeMap& nodes,
++    const gfx::Rect& region) {
++  ScreenshotHighlights highlights;
++  highlights.region_size = gfx::SizeF(region.size());
++  const gfx::RectF region_f(region);
++  for (const auto& [node_id, node] : nodes) {
++    if (!ShouldHighlight(node) || node.bounds.IsEmpty() ||
++        !region_f.Intersects(node.bounds)) {
++      continue;
++    }
++    gfx::RectF bounds = node.bounds;
++    bounds.Offset(-region_f.x(), -region_f.y());
++    highlights.boxes.push_back({node_id, bounds});
++  }
++  std::sort(highlights.boxes.begin(), highlights.boxes.end(),
++            [](const ScreenshotHighlights::Box& a,
++               const ScreenshotHighlights::Box& b) {
++              return a.node_id < b.node_id;
++            });
++  return highlights;
++}
++
++SkBitmap PaintScreenshotHighlights(const SkBitmap& screenshot,
++                                   const ScreenshotHighlights& highlights) {
++  // The captured bitmap may be shared, so draw on a copy
++  SkBitmap bitmap;
++  if (!bitmap.tryAllocPixels(screenshot.info()) ||
++      !screenshot.readPixels(bitmap.pixmap())) {
++    return screenshot;
++  }
++  if (highlights.boxes.empty() || highlights.region_size.IsEmpty()) {
++    return bitmap;
++  }
++
++  // Exact width and height may stretch the region unevenly
++  const float scale_x = bitmap.width() / highlights.region_size.width();
++  const float scale_y = bitmap.height() / highlights.region_size.height();
++  const float scale = std::min(scale_x, scale_y);
++
++  cc::SkiaPaintCanvas paint_canvas(bitmap);
++  gfx::Canvas canvas(&paint_canvas, 1.0f);
++
++  cc::PaintFlags box_flags;
++  box_flags.setAntiAlias(true);
++  box_flags.setStyle(cc::PaintFlags::kStroke_Style);
++  box_flags.setStrokeWidth(kBorderWidth * scale);
++  box_flags.setColor(kBoxColor);
++
++  const gfx::FontList font_list(
++      {"monospace"}, gfx::Font::NORMAL,
++      std::max(1, static_cast<int>(kLabelFontSize * scale + 0.5f)),
++      gfx::Font::Weight::NORMAL);
++
++  for (const ScreenshotHighlights::Box& box : highlights.boxes) {
++    gfx::RectF rect = gfx::ScaleRect(box.bounds, scale_x, scale_y);
++    // The border is drawn inside the element, like box-sizing: border-box
++    gfx::RectF stroke = rect;
++    stroke.Inset(kBorderWidth * scale / 2);
++    canvas.DrawRect(stroke, box_flags);
++    if (highlights.show_labels) {
++      PaintLabel(canvas, font_list, rect, box.node_id, scale);
++    }
++  }
++  return bitmap;
++}
++
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,69 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_screenshot_highlights.h b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_highlights.h
+new file mode 100644
+index 0000000000000..aaf00c0b60048
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_highlights.h
+@@ -0,0 +1,63 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SCREENSHOT_HIGHLIGHTS_H_
++#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SCREENSHOT_HIGHLIGHTS_H_
++
++#include <cstdint>
++#include <vector>
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_id_store.h"
++#include "ui/gfx/geometry/rect_f.h"
++#include "ui/gfx/geometry/size_f.h"
++
++class SkBitmap;
++
++namespace gfx {
++class Rect;
++}  // namespace gfx
++
++namespace extensions {
++namespace api {
++
++// Boxes and node ID labels that captureScreenshot's showHighlights draws onto
++// the captured bitmap. Drawing them browser-side leaves the page untouched:
++// no DOM mutation, style recalc or layout, and no wait for a repaint.
++struct ScreenshotHighlights {
++  struct Box {
++    uint32_t node_id = 0;
++    // Relative to the captured region, in DIPs
++    gfx::RectF bounds;
++  };
++
++  ScreenshotHighlights();
++  ScreenshotHighlights(const ScreenshotHighlights&);
++  ScreenshotHighlights& operator=(const ScreenshotHighlights&);
++  ScreenshotHighlights(ScreenshotHighlights&&);
++  ScreenshotHighlights& operator=(ScreenshotHighlights&&);
++  ~ScreenshotHighlights();
++
++  // In node ID order, so later boxes draw over earlier ones
++  std::vector<Box> boxes;
++  // Size of the captured region in DIPs. The bitmap may be scaled from it.
++  gfx::SizeF region_size;
++  bool show_labels = true;
++};
++
++// Collects the clickable, typeable and selectable nodes of |nodes| that are
++// in the viewport and overlap |region|, the captured part of the view in
++// DIPs.
++ScreenshotHighlights CollectScreenshotHighlights(
++    const BrowserOSNodeIdStore::NodeMap& nodes,
++    const gfx::Rect& region);
++
++// Returns a copy of |screenshot| with |highlights| drawn on it. Runs on any
++// thread, so it can share the encoding worker.
++SkBitmap PaintScreenshotHighlights(const SkBitmap& screenshot,
++                                   const ScreenshotHighlights& highlights);
++
++}  // namespace api
++}  // namespace extensions
++
++#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SCREENSHOT_HIGHLIGHTS_H_
@@ -0,0 +1,112 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_screenshot_highlights_unittest.cc b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_highlights_unittest.cc
+new file mode 100644
+index 0000000000000..7b56ef97dbfa9
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_screenshot_highlights_unittest.cc
+@@ -0,0 +1,106 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_screenshot_highlights.h"
++
++#include "testing/gtest/include/gtest/gtest.h"
++#include "third_party/skia/include/core/SkBitmap.h"
++#include "third_party/skia/include/core/SkColor.h"
++#include "ui/gfx/geometry/rect.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++NodeInfo MakeNode(gfx::RectF bounds,
++                  browser_os::InteractiveNodeType type =
++                      browser_os::InteractiveNodeType::kClickable,
++                  bool in_viewport = true) {
++  NodeInfo info;
++  info.bounds = bounds;
++  info.node_type = type;
++  info.in_viewport = in_viewport;
++  return info;
++}
++
++SkBitmap MakeWhiteBitmap(int width, int height) {
++  SkBitmap bitmap;
++  bitmap.allocN32Pixels(width, height);
++  bitmap.eraseColor(SK_ColorWHITE);
++  return bitmap;
++}
++
++// =============================================================================
++// Collection Tests
++// =============================================================================
++
++TEST(ScreenshotHighlightsTest, CollectsInteractiveNodesInRegion) {
++  BrowserOSNodeIdStore::NodeMap nodes;
++  nodes[3] = MakeNode(gfx::RectF(10, 10, 20, 20));
++  nodes[1] = MakeNode(gfx::RectF(50, 50, 20, 20),
++                      browser_os::InteractiveNodeType::kTypeable);
++  nodes[2] = MakeNode(gfx::RectF(10, 10, 20, 20),
++                      browser_os::InteractiveNodeType::kOther);
++  nodes[4] = MakeNode(gfx::RectF(10, 10, 20, 20),
++                      browser_os::InteractiveNodeType::kClickable,
++                      /*in_viewport=*/false);
++  nodes[5] = MakeNode(gfx::RectF(500, 500, 20, 20));
++
++  ScreenshotHighlights highlights =
++      CollectScreenshotHighlights(nodes, gfx::Rect(5, 5, 100, 100));
++
++  EXPECT_EQ(gfx::SizeF(100, 100), highlights.region_size);
++  ASSERT_EQ(2u, highlights.boxes.size());
++  EXPECT_EQ(1u, highlights.boxes[0].node_id);
++  EXPECT_EQ(gfx::RectF(45, 45, 20, 20), highlights.boxes[0].bounds);
++  EXPECT_EQ(3u, highlights.boxes[1].node_id);
++  EXPECT_EQ(gfx::RectF(5, 5, 20, 20), highlights.boxes[1].bounds);
++}
++
++// =============================================================================
++// Painting Tests
++// =============================================================================
++
++TEST(ScreenshotHighlightsTest, PaintsScaledBoxOnCopy) {
++  ScreenshotHighlights highlights;
++  highlights.region_size = gfx::SizeF(100, 100);
++  highlights.show_labels = false;
++  highlights.boxes.push_back({1, gfx::RectF(20, 20, 40, 40)});
++
++  // The bitmap was captured at twice the region's DIP size
++  SkBitmap screenshot = MakeWhiteBitmap(200, 200);
++  SkBitmap painted = PaintScreenshotHighlights(screenshot, highlights);
++
++  EXPECT_EQ(SK_ColorWHITE, screenshot.getColor(41, 80));
++  EXPECT_NE(SK_ColorWHITE, painted.getColor(41, 80));
++  EXPECT_EQ(SK_ColorWHITE, painted.getColor(80, 80));
++  EXPECT_EQ(SK_ColorWHITE, painted.getColor(30, 80));
++}
++
++TEST(ScreenshotHighlightsTest, PaintsLabelAboveBox) {
++  ScreenshotHighlights highlights;
++  highlights.region_size = gfx::SizeF(100, 100);
++  highlights.boxes.push_back({7, gfx::RectF(20, 40, 40, 40)});
++
++  SkBitmap painted =
++      PaintScreenshotHighlights(MakeWhiteBitmap(100, 100), highlights);
++
++  EXPECT_NE(SK_ColorWHITE, painted.getColor(22, 30));
++  EXPECT_EQ(SK_ColorWHITE, painted.getColor(22, 10));
++}
++
++TEST(ScreenshotHighlightsTest, NoBoxesLeavesPixels) {
++  ScreenshotHighlights highlights;
++  highlights.region_size = gfx::SizeF(10, 10);
++
++  SkBitmap painted =
++      PaintScreenshotHighlights(MakeWhiteBitmap(10, 10), highlights);
++
++  ASSERT_EQ(10, painted.width());
++  EXPECT_EQ(SK_ColorWHITE, painted.getColor(5, 5));
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
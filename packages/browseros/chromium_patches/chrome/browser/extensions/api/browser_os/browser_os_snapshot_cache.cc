@@ -0,0 +1,236 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_snapshot_cache.cc b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_cache.cc
+new file mode 100644
+index 0000000000000..543fdec80e18d
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_cache.cc
+@@ -0,0 +1,230 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_snapshot_cache.h"
++
++#include <deque>
++#include <string>
++#include <string_view>
++#include <unordered_map>
++#include <utility>
++
++#include "base/bit_cast.h"
++#include "base/hash/hash.h"
++#include "base/logging.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_id_store.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor.h"
++#include "content/public/browser/browser_accessibility_state.h"
++#include "content/public/browser/navigation_handle.h"
++#include "content/public/browser/scoped_accessibility_mode.h"
++#include "content/public/browser/web_contents.h"
++#include "ui/accessibility/ax_mode.h"
++
++namespace extensions {
++namespace api {
++
++namespace {
++
++uint64_t HashString(uint64_t seed, std::string_view value) {
++  return base::HashInts64(seed, base::FastHash(value));
++}
++
++uint64_t HashDouble(uint64_t seed, double value) {
++  return base::HashInts64(seed, base::bit_cast<uint64_t>(value));
++}
++
++const std::string* FindAttribute(const browser_os::InteractiveNode& node,
++                                 std::string_view key) {
++  if (!node.attributes) {
++    return nullptr;
++  }
++  return node.attributes->additional_properties.FindString(key);
++}
++
++// Attributes that identify an element independently of its node ID. The
++// context text and value are deliberately left out so that typing into a
++// field or editing nearby text reports a change rather than a new element.
++uint64_t ComputeIdentity(const browser_os::InteractiveNode& node) {
++  uint64_t hash = static_cast<uint64_t>(node.type);
++  hash = HashString(hash, node.name.value_or(std::string()));
++  for (const char* key : {"role", "html-tag", "id", "class", "path"}) {
++    const std::string* value = FindAttribute(node, key);
++    hash = HashString(hash, value ? *value : std::string());
++  }
++  return hash;
++}
++
++uint64_t ComputeFingerprint(const browser_os::InteractiveNode& node,
++                            uint64_t identity) {
++  uint64_t hash = identity;
++  if (node.rect) {
++    hash = HashDouble(hash, node.rect->x);
++    hash = HashDouble(hash, node.rect->y);
++    hash = HashDouble(hash, node.rect->width);
++    hash = HashDouble(hash, node.rect->height);
++  }
++  if (node.attributes) {
++    // Dict iteration is in key order, so the hash is deterministic
++    for (const auto [key, value] : node.attributes->additional_properties) {
++      hash = HashString(hash, key);
++      if (value.is_string()) {
++        hash = HashString(hash, value.GetString());
++      }
++    }
++  }
++  return hash;
++}
++
++}  // namespace
++
++BrowserOSSnapshotCache::BrowserOSSnapshotCache(
++    content::WebContents* web_contents)
++    : content::WebContentsObserver(web_contents),
++      content::WebContentsUserData<BrowserOSSnapshotCache>(*web_contents),
++      scoped_accessibility_mode_(
++          content::BrowserAccessibilityState::GetInstance()
++              ->CreateScopedModeForWebContents(
++                  web_contents, ui::AXMode(ui::AXMode::kWebContents))) {}
++
++BrowserOSSnapshotCache::~BrowserOSSnapshotCache() = default;
++
++browser_os::InteractiveSnapshot BrowserOSSnapshotCache::GetCachedSnapshot()
++    const {
++  DCHECK(snapshot_);
++  browser_os::InteractiveSnapshot snapshot = snapshot_->Clone();
++  snapshot.diff = browser_os::SnapshotDiff();
++  return snapshot;
++}
++
++scoped_refptr<const SnapshotReuseTable> BrowserOSSnapshotCache::reuse_table()
++    const {
++  return reuse_table_;
++}
++
++void BrowserOSSnapshotCache::Update(bool viewport_only,
++                                    SnapshotProcessingResult& result) {
++  // Out of node indices: number this snapshot afresh. Its new handles carry
++  // this snapshot's ID, so they cannot collide with the old ones.
++  if (next_node_id_ + result.snapshot.elements.size() > kMaxNodeIndex) {
++    entries_.clear();
++    next_node_id_ = 1;
++  }
++
++  // Previous elements grouped by identity, in document order, so repeated
++  // identical elements (e.g. "Reply" buttons) keep their relative IDs.
++  std::unordered_map<uint64_t, std::deque<const Entry*>> previous;
++  for (const Entry& entry : entries_) {
++    previous[entry.identity].push_back(&entry);
++  }
++
++  BrowserOSNodeIdStore* node_id_store =
++      BrowserOSNodeIdStore::FromWebContents(web_contents());
++  BrowserOSNodeIdStore::NodeMap mappings;
++  uint32_t handle_tag = result.snapshot.snapshot_id;
++  if (node_id_store) {
++    mappings = node_id_store->TakeNodes(result.snapshot.snapshot_id);
++    handle_tag = node_id_store->GetHandleTag(result.snapshot.snapshot_id);
++  }
++  BrowserOSNodeIdStore::NodeMap stable_mappings;
++  stable_mappings.reserve(mappings.size());
++
++  browser_os::SnapshotDiff diff;
++  std::vector<Entry> entries;
++  entries.reserve(result.snapshot.elements.size());
++
++  for (browser_os::InteractiveNode& node : result.snapshot.elements) {
++    Entry entry;
++    entry.identity = ComputeIdentity(node);
++    entry.fingerprint = ComputeFingerprint(node, entry.identity);
++
++    auto it = previous.find(entry.identity);
++    if (it != previous.end() && !it->second.empty()) {
++      const Entry* match = it->second.front();
++      it->second.pop_front();
++      entry.node_id = match->node_id;
++      if (match->fingerprint != entry.fingerprint) {
++        diff.changed.push_back(entry.node_id);
++      }
++    } else {
++      entry.node_id = MakeNodeHandle(handle_tag, next_node_id_++);
++      diff.added.push_back(entry.node_id);
++    }
++
++    auto mapping_it = mappings.find(node.node_id);
++    if (mapping_it != mappings.end()) {
++      stable_mappings[entry.node_id] = std::move(mapping_it->second);
++    }
++    node.node_id = entry.node_id;
++    entries.push_back(entry);
++  }
++
++  for (const auto& [identity, unmatched] : previous) {
++    for (const Entry* entry : unmatched) {
++      diff.removed.push_back(entry->node_id);
++    }
++  }
++
++  if (node_id_store) {
++    node_id_store->ReplaceNodes(result.snapshot.snapshot_id,
++                                std::move(stable_mappings));
++  }
++
++  if (!snapshot_ || !diff.added.empty() || !diff.removed.empty() ||
++      !diff.changed.empty()) {
++    version_++;
++  }
++
++  VLOG(1) << "[browseros] Incremental snapshot v" << version_ << ": "
++          << diff.added.size() << " added, " << diff.removed.size()
++          << " removed, " << diff.changed.size() << " changed, "
++          << result.nodes_reused << " nodes reused";
++
++  result.snapshot.version = version_;
++  result.snapshot.diff = std::move(diff);
++  viewport_only_ = viewport_only;
++  entries_ = std::move(entries);
++  snapshot_ = result.snapshot.Clone();
++  reuse_table_ = result.reuse_table;
++}
++
++void BrowserOSSnapshotCache::Invalidate() {
++  dirty_ = true;
++  generation_++;
++  version_ = 0;
++  next_node_id_ = 1;
++  entries_.clear();
++  snapshot_.reset();
++  reuse_table_ = nullptr;
++}
++
++void BrowserOSSnapshotCache::AccessibilityEventReceived(
++    const ui::AXUpdatesAndEvents& details) {
++  dirty_ = true;
++}
++
++void BrowserOSSnapshotCache::AccessibilityLocationChangesReceived(
++    const ui::AXTreeID& tree_id,
++    ui::AXLocationAndScrollUpdates& details) {
++  dirty_ = true;
++}
++
++void BrowserOSSnapshotCache::DidFinishNavigation(
++    content::NavigationHandle* navigation_handle) {
++  if (!navigation_handle->HasCommitted()) {
++    return;
++  }
++  // A new document gets fresh node IDs; same-document navigations (history
++  // API, fragments) only invalidate the cached snapshot.
++  if (navigation_handle->IsInPrimaryMainFrame() &&
++      !navigation_handle->IsSameDocument()) {
++    Invalidate();
++    return;
++  }
++  dirty_ = true;
++}
++
++WEB_CONTENTS_USER_DATA_KEY_IMPL(BrowserOSSnapshotCache);
++
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,123 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_snapshot_cache.h b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_cache.h
+new file mode 100644
+index 0000000000000..95ffb04835343
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_cache.h
+@@ -0,0 +1,117 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SNAPSHOT_CACHE_H_
++#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SNAPSHOT_CACHE_H_
++
++#include <cstdint>
++#include <memory>
++#include <optional>
++#include <vector>
++
++#include "base/memory/scoped_refptr.h"
++#include "chrome/common/extensions/api/browser_os.h"
++#include "content/public/browser/web_contents_observer.h"
++#include "content/public/browser/web_contents_user_data.h"
++
++namespace content {
++class ScopedAccessibilityMode;
++class WebContents;
++}  // namespace content
++
++namespace ui {
++class AXTreeID;
++struct AXLocationAndScrollUpdates;
++struct AXUpdatesAndEvents;
++}  // namespace ui
++
++namespace extensions {
++namespace api {
++
++class SnapshotReuseTable;
++struct SnapshotProcessingResult;
++
++// Per-tab state for incremental getInteractiveSnapshot calls.
++//
++// Keeps the last snapshot, the processor's reuse table and a stable nodeId
++// assignment. Accessibility events mark the cache dirty, so a repeated call
++// on an unchanged page is answered without touching the renderer, and a call
++// after a change only re-processes nodes whose content hash changed.
++class BrowserOSSnapshotCache
++    : public content::WebContentsObserver,
++      public content::WebContentsUserData<BrowserOSSnapshotCache> {
++ public:
++  BrowserOSSnapshotCache(const BrowserOSSnapshotCache&) = delete;
++  BrowserOSSnapshotCache& operator=(const BrowserOSSnapshotCache&) = delete;
++  ~BrowserOSSnapshotCache() override;
++
++  // True if a snapshot taken with the same |viewport_only| setting is cached
++  // and nothing changed since it was taken.
++  bool IsClean(bool viewport_only) const {
++    return snapshot_.has_value() && !dirty_ && viewport_only_ == viewport_only;
++  }
++
++  // Copy of the cached snapshot with an empty diff.
++  browser_os::InteractiveSnapshot GetCachedSnapshot() const;
++
++  // Reuse table of the last processed snapshot, or null.
++  scoped_refptr<const SnapshotReuseTable> reuse_table() const;
++
++  // Called right before a new tree is requested. Events that arrive while the
++  // snapshot is in flight mark the cache dirty again.
++  void MarkSnapshotRequested() { dirty_ = false; }
++
++  // Assigns stable node IDs to |result|, fills in its version and diff, and
++  // rekeys the tab's node ID mappings to match.
++  void Update(bool viewport_only, SnapshotProcessingResult& result);
++
++  // Drops all cached state; the next snapshot starts from version 1.
++  void Invalidate();
++
++  // Changes on every Invalidate(). A snapshot requested under an older
++  // generation describes a document or numbering the cache no longer holds,
++  // so it must not be passed to Update().
++  uint64_t generation() const { return generation_; }
++
++ private:
++  friend class content::WebContentsUserData<BrowserOSSnapshotCache>;
++
++  struct Entry {
++    uint32_t node_id;
++    // Hash of what makes an element "the same element" across snapshots
++    uint64_t identity;
++    // Hash of everything reported for the element
++    uint64_t fingerprint;
++  };
++
++  explicit BrowserOSSnapshotCache(content::WebContents* web_contents);
++
++  // content::WebContentsObserver:
++  void AccessibilityEventReceived(
++      const ui::AXUpdatesAndEvents& details) override;
++  void AccessibilityLocationChangesReceived(
++      const ui::AXTreeID& tree_id,
++      ui::AXLocationAndScrollUpdates& details) override;
++  void DidFinishNavigation(
++      content::NavigationHandle* navigation_handle) override;
++
++  // Keeps the renderer sending accessibility events while the cache exists.
++  std::unique_ptr<content::ScopedAccessibilityMode> scoped_accessibility_mode_;
++
++  bool dirty_ = true;
++  uint64_t generation_ = 0;
++  bool viewport_only_ = false;
++  int version_ = 0;
++  uint32_t next_node_id_ = 1;
++  std::vector<Entry> entries_;
++  std::optional<browser_os::InteractiveSnapshot> snapshot_;
++  scoped_refptr<const SnapshotReuseTable> reuse_table_;
++
++  WEB_CONTENTS_USER_DATA_KEY_DECL();
++};
++
++}  // namespace api
++}  // namespace extensions
++
++#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SNAPSHOT_CACHE_H_
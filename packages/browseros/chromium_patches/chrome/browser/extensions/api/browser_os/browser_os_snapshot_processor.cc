@@ -1,9 +1,9 @@
 diff --git a/chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor.cc b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor.cc
 new file mode 100644
-index 0000000000000..885942336dcd6
+index 0000000000000..20146df87fd1d
 --- /dev/null
 +++ b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor.cc
-@@ -0,0 +1,648 @@
+@@ -0,0 +1,1194 @@
 +// Copyright 2024 The Chromium Authors
 +// Use of this source code is governed by a BSD-style license that can be
 +// found in the LICENSE file.
@@ -12,23 +12,35 @@ index 0000000000000..885942336dcd6
 +
 +#include <algorithm>
 +#include <atomic>
++#include <bit>
 +#include <cctype>
 +#include <functional>
 +#include <future>
 +#include <memory>
++#include <optional>
 +#include <queue>
 +#include <sstream>
++#include <string>
++#include <string_view>
 +#include <unordered_set>
 +#include <utility>
 +
++#include "base/bit_cast.h"
 +#include "base/functional/bind.h"
++#include "base/hash/hash.h"
 +#include "base/logging.h"
 +#include "base/memory/raw_ptr.h"
++#include "base/memory/weak_ptr.h"
 +#include "base/memory/ref_counted.h"
 +#include "base/strings/string_util.h"
-+#include "base/task/thread_pool.h"
++#include "base/task/task_traits.h"
 +#include "base/time/time.h"
++#include "chrome/browser/browseros/core/browseros_text_util.h"
 +#include "chrome/browser/extensions/api/browser_os/browser_os_api_utils.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_attributes.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_id_store.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_index.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_parallel_for.h"
 +#include "content/public/browser/browser_thread.h"
 +#include "content/public/browser/render_widget_host_view.h"
 +#include "content/browser/renderer_host/render_widget_host_view_base.h"
@@ -44,6 +56,7 @@ index 0000000000000..885942336dcd6
 +#include "ui/gfx/geometry/rect.h"
 +#include "ui/gfx/geometry/rect_conversions.h"
 +#include "ui/gfx/geometry/rect_f.h"
++#include "ui/gfx/geometry/size_f.h"
 +#include "ui/gfx/geometry/transform.h"
 +
 +namespace extensions {
@@ -100,25 +113,23 @@ index 0000000000000..885942336dcd6
 +SnapshotProcessor::ProcessedNode::operator=(ProcessedNode&&) = default;
 +SnapshotProcessor::ProcessedNode::~ProcessedNode() = default;
 +
++SnapshotOptions::SnapshotOptions() = default;
++SnapshotOptions::SnapshotOptions(const SnapshotOptions&) = default;
++SnapshotOptions& SnapshotOptions::operator=(const SnapshotOptions&) = default;
++SnapshotOptions::~SnapshotOptions() = default;
 +
-+namespace {
++SnapshotProcessingResult::SnapshotProcessingResult() = default;
++SnapshotProcessingResult::SnapshotProcessingResult(
++    SnapshotProcessingResult&&) = default;
++SnapshotProcessingResult& SnapshotProcessingResult::operator=(
++    SnapshotProcessingResult&&) = default;
++SnapshotProcessingResult::~SnapshotProcessingResult() = default;
 +
-+// Helper to sanitize strings to ensure valid UTF-8 by keeping only printable ASCII
-+std::string SanitizeStringForOutput(const std::string& input) {
-+  std::string output;
-+  output.reserve(input.size());
-+  
-+  for (char c : input) {
-+    // Only include printable ASCII and whitespace
-+    if ((c >= 32 && c <= 126) || c == '\t' || c == '\n') {
-+      output.push_back(c);
-+    } else {
-+      output.push_back(' ');  // Replace non-printable with space
-+    }
-+  }
-+  
-+  return output;
-+}
++SnapshotReuseTable::SnapshotReuseTable() = default;
++SnapshotReuseTable::~SnapshotReuseTable() = default;
++
++
++namespace {
 +
 +// Helper to determine if a node should be skipped for the interactive snapshot
 +bool ShouldSkipNode(const ui::AXNodeData& node_data) {
@@ -136,24 +147,276 @@ index 0000000000000..885942336dcd6
 +  return false;
 +}
 +
++// Walks |tree| from the root in document order and collects the offsets of
++// interactive nodes that intersect |viewport|. A container whose own bounds
++// are offscreen is not descended into, which keeps the cost proportional to
++// what is visible on long feeds. Containers with empty bounds are always
++// descended into since their children commonly overflow them.
++// |viewport| is in the same physical-pixel space as RelativeToTreeBounds.
++std::vector<uint32_t> CollectViewportNodes(const ui::AXTree& tree,
++                                           const SnapshotNodeIndex& node_index,
++                                           const gfx::RectF& viewport,
++                                           size_t* out_visited) {
++  std::vector<uint32_t> offsets;
++  size_t visited = 0;
++  std::vector<const ui::AXNode*> stack;
++  if (tree.root()) {
++    stack.push_back(tree.root());
++  }
++  while (!stack.empty()) {
++    const ui::AXNode* node = stack.back();
++    stack.pop_back();
++    ++visited;
++
++    bool offscreen = false;
++    gfx::RectF bounds = tree.RelativeToTreeBounds(
++        node, gfx::RectF(), &offscreen, /*clip_bounds=*/true);
++    if (!offscreen && !viewport.IsEmpty() && !bounds.IsEmpty() &&
++        !viewport.Intersects(bounds)) {
++      offscreen = true;
++    }
++    const bool has_area = !bounds.IsEmpty();
++
++    if (!offscreen || !has_area) {
++      const ui::AXNodeData& data = node->data();
++      if (!offscreen && !ShouldSkipNode(data)) {
++        int64_t offset = node_index.OffsetOf(data.id);
++        if (offset >= 0) {
++          offsets.push_back(static_cast<uint32_t>(offset));
++        }
++      }
++    }
++
++    if (offscreen && has_area) {
++      continue;
++    }
++    // Push in reverse so children are visited in document order
++    for (size_t i = node->GetChildCount(); i > 0; --i) {
++      stack.push_back(node->GetChildAtIndex(i - 1));
++    }
++  }
++  if (out_visited) {
++    *out_visited = visited;
++  }
++  return offsets;
++}
++
++// Smallest range of interactive nodes a worker claims at a time
++constexpr size_t kMinRangeSize = 16;
++
++uint64_t HashCombine(uint64_t seed, uint64_t value) {
++  return base::HashInts64(seed, value);
++}
++
++uint64_t HashFloat(uint64_t seed, float value) {
++  return HashCombine(seed, base::bit_cast<uint32_t>(value));
++}
++
++// Hash of everything in a node that can affect processed output. Node ids
++// (including offset_container_id) are left out on purpose: they are
++// reassigned every time the tree is acquired.
++uint64_t HashNodeContent(const ui::AXNodeData& node) {
++  uint64_t hash = static_cast<uint64_t>(node.role);
++  // States are a bitfield indexed by enum value; visit only the set bits
++  for (uint64_t bits = node.state; bits; bits &= bits - 1) {
++    hash = HashCombine(hash, std::countr_zero(bits));
++  }
++  for (const auto& [key, value] : node.string_attributes) {
++    hash = HashCombine(hash, static_cast<uint64_t>(key));
++    hash = HashCombine(hash, base::FastHash(value));
++  }
++  for (const auto& [key, value] : node.int_attributes) {
++    // Int attributes that hold node ids are not stable across snapshots
++    if (key == ax::mojom::IntAttribute::kMemberOfId ||
++        key == ax::mojom::IntAttribute::kNextOnLineId ||
++        key == ax::mojom::IntAttribute::kPreviousOnLineId ||
++        key == ax::mojom::IntAttribute::kActivedescendantId ||
++        key == ax::mojom::IntAttribute::kInPageLinkTargetId ||
++        key == ax::mojom::IntAttribute::kErrormessageIdDeprecated ||
++        key == ax::mojom::IntAttribute::kPopupForId) {
++      continue;
++    }
++    hash = HashCombine(hash, static_cast<uint64_t>(key));
++    hash = HashCombine(hash, static_cast<uint32_t>(value));
++  }
++  for (const auto& [key, value] : node.float_attributes) {
++    hash = HashCombine(hash, static_cast<uint64_t>(key));
++    hash = HashFloat(hash, value);
++  }
++  if (node.bool_attributes) {
++    node.bool_attributes->ForEach(
++        [&hash](ax::mojom::BoolAttribute key, bool value) {
++          hash = HashCombine(hash, static_cast<uint64_t>(key));
++          hash = HashCombine(hash, value);
++        });
++  }
++  const gfx::RectF& bounds = node.relative_bounds.bounds;
++  hash = HashFloat(hash, bounds.x());
++  hash = HashFloat(hash, bounds.y());
++  hash = HashFloat(hash, bounds.width());
++  hash = HashFloat(hash, bounds.height());
++  if (node.relative_bounds.transform) {
++    float matrix[16];
++    node.relative_bounds.transform->GetColMajorF(matrix);
++    for (float value : matrix) {
++      hash = HashFloat(hash, value);
++    }
++  }
++  return HashCombine(hash, node.child_ids.size());
++}
++
++// Incremental reuse keys, computed by the workers for the nodes they process.
++// Content and subtree hashes are memoized per offset and shared by all
++// workers, so a container's subtree is hashed once however many candidates
++// sit under it. Two workers may race to fill the same entry; both store the
++// same value, so relaxed atomics are enough. A zero entry means "not computed
++// yet", and a hash that happens to be zero is simply recomputed.
++class ReuseKeyHasher {
++ public:
++  explicit ReuseKeyHasher(scoped_refptr<const SnapshotNodeIndex> node_index)
++      : node_index_(std::move(node_index)),
++        own_hashes_(std::make_unique<std::atomic<uint64_t>[]>(
++            node_index_->size())),
++        subtree_hashes_(std::make_unique<std::atomic<uint64_t>[]>(
++            node_index_->size())) {}
++  ReuseKeyHasher(const ReuseKeyHasher&) = delete;
++  ReuseKeyHasher& operator=(const ReuseKeyHasher&) = delete;
++
++  // Key of the node at |offset|. It changes whenever anything that feeds the
++  // node's processed output changes: its own subtree, the subtree of its
++  // offset container (context text) or any node on its offset-container
++  // chain (path and bounds).
++  uint64_t Key(uint32_t offset) {
++    const std::vector<ui::AXNodeData>& nodes = node_index_->nodes();
++    uint64_t key = SubtreeHash(offset);
++    int64_t container =
++        node_index_->OffsetOf(nodes[offset].relative_bounds.offset_container_id);
++    if (container >= 0) {
++      key = HashCombine(key, SubtreeHash(container));
++    }
++    for (int steps = 0; container >= 0 && steps < 64; ++steps) {
++      key = HashCombine(key, OwnHash(container));
++      container = node_index_->OffsetOf(
++          nodes[container].relative_bounds.offset_container_id);
++    }
++    return key;
++  }
++
++ private:
++  uint64_t OwnHash(int64_t offset) {
++    uint64_t hash = own_hashes_[offset].load(std::memory_order_relaxed);
++    if (!hash) {
++      hash = HashNodeContent(node_index_->nodes()[offset]);
++      own_hashes_[offset].store(hash, std::memory_order_relaxed);
++    }
++    return hash;
++  }
++
++  // Bottom-up hash of the subtree at |root| using an explicit post-order
++  // walk that stops at subtrees already hashed. The index was built from an
++  // update that also produced a valid AXTree, so the walk cannot cycle.
++  uint64_t SubtreeHash(int64_t root) {
++    const std::vector<ui::AXNodeData>& nodes = node_index_->nodes();
++    std::vector<std::pair<int64_t, bool>> stack;
++    stack.emplace_back(root, false);
++    while (!stack.empty()) {
++      auto [offset, children_done] = stack.back();
++      stack.pop_back();
++      if (children_done) {
++        uint64_t hash = OwnHash(offset);
++        for (int32_t child_id : nodes[offset].child_ids) {
++          int64_t child = node_index_->OffsetOf(child_id);
++          if (child >= 0) {
++            hash = HashCombine(
++                hash, subtree_hashes_[child].load(std::memory_order_relaxed));
++          }
++        }
++        subtree_hashes_[offset].store(hash, std::memory_order_relaxed);
++        continue;
++      }
++      if (subtree_hashes_[offset].load(std::memory_order_relaxed)) {
++        continue;
++      }
++      stack.emplace_back(offset, true);
++      for (int32_t child_id : nodes[offset].child_ids) {
++        int64_t child = node_index_->OffsetOf(child_id);
++        if (child >= 0 &&
++            !subtree_hashes_[child].load(std::memory_order_relaxed)) {
++          stack.emplace_back(child, false);
++        }
++      }
++    }
++    return subtree_hashes_[root].load(std::memory_order_relaxed);
++  }
++
++  const scoped_refptr<const SnapshotNodeIndex> node_index_;
++  std::unique_ptr<std::atomic<uint64_t>[]> own_hashes_;
++  std::unique_ptr<std::atomic<uint64_t>[]> subtree_hashes_;
++};
++
 +}  // namespace
 +
++// Everything the workers read, plus one result slot per node to process.
++// Workers only write their own slots; the UI thread reads a slot only after
++// the range holding it has been reported done.
++struct SnapshotProcessor::SnapshotWork
++    : public base::RefCountedThreadSafe<SnapshotWork> {
++  scoped_refptr<const SnapshotNodeIndex> node_index;
++  std::unique_ptr<ui::AXTree> ax_tree;  // AXTree for computing accurate bounds
++  float device_scale_factor = 1.0f;  // For converting physical to CSS pixels
++  // Offsets into |node_index| in output order
++  std::vector<uint32_t> offsets;
++  // Incremental mode only: computes the reuse key of each processed node
++  std::unique_ptr<ReuseKeyHasher> reuse_hasher;
++  // Bounded-cost mode: priority tier per offset while ranking, then the
++  // slots in the order to process them. Empty |order| means slot order.
++  std::vector<int> tiers;
++  std::vector<uint32_t> order;
++  // Every offset is known to be in the viewport, so tiers skip bounds
++  bool viewport_only = false;
++  scoped_refptr<const SnapshotReuseTable> reuse_table;
++  // Context text and path memo shared by all workers
++  scoped_refptr<SnapshotContextMemo> memo;
++  base::TimeTicks deadline;
++  // Slot i holds the node with nodeId i + 1
++  std::vector<std::optional<ProcessedNode>> slots;
++  std::atomic<size_t> ranges{0};
++  std::atomic<size_t> nodes_dropped{0};
++
++ private:
++  friend class base::RefCountedThreadSafe<SnapshotWork>;
++  ~SnapshotWork() = default;
++};
++
 +// Internal structure for managing async processing
 +struct SnapshotProcessor::ProcessingContext 
 +    : public base::RefCountedThreadSafe<ProcessingContext> {
 +  browser_os::InteractiveSnapshot snapshot;
-+  std::unordered_map<int32_t, ui::AXNodeData> node_map;
-+  std::unordered_map<int32_t, int32_t> parent_map;  // child_id -> parent_id  
-+  std::unordered_map<int32_t, std::vector<int32_t>> children_map;  // parent_id -> child_ids
-+  std::unique_ptr<ui::AXTree> ax_tree;  // AXTree for computing accurate bounds
++  scoped_refptr<SnapshotWork> work;
 +  int tab_id;
++  // Receives the nodeId mappings; null without a WebContents, e.g. in tests
++  base::WeakPtr<BrowserOSNodeIdStore> node_id_store;
++  // Upper bits of this snapshot's node IDs, from the tab's node ID store
++  uint32_t handle_tag = 0;
 +  ui::AXTreeID tree_id;  // Tree ID for change detection
-+  float device_scale_factor = 1.0f;  // For converting physical to CSS pixels
 +  gfx::Size viewport_size;  // For visibility checks
 +  base::TimeTicks start_time;
 +  size_t total_nodes;
-+  size_t processed_batches;
-+  size_t total_batches;
++  SnapshotStats stats;
++  // Incremental mode: table collected for the next snapshot of this tab
++  scoped_refptr<SnapshotReuseTable> next_reuse_table;
++  int nodes_reused = 0;
++  // Streaming mode: which slots are done, and the first one not yet emitted
++  base::RepeatingCallback<void(std::vector<browser_os::InteractiveNode>)>
++      on_chunk;
++  std::vector<bool> ready;
++  size_t next_emit = 0;
++  size_t elements_emitted = 0;
++  // Bounded-cost mode: node budget (0 = none), and set when nodes were
++  // dropped for budget or deadline
++  size_t max_nodes = 0;
++  bool truncated = false;
++  bool incremental = false;
 +  base::OnceCallback<void(SnapshotProcessingResult)> callback;
 +  
 + private:
@@ -164,40 +427,41 @@ index 0000000000000..885942336dcd6
 +// Helper to collect text from a node's subtree
 +std::string CollectTextFromNode(
 +    int32_t node_id,
-+    const std::unordered_map<int32_t, ui::AXNodeData>& node_map,
++    const SnapshotNodeIndex& node_index,
 +    int max_chars = 200) {
 +  
-+  auto node_it = node_map.find(node_id);
-+  if (node_it == node_map.end()) {
++  if (!node_index.Find(node_id)) {
 +    return "";
 +  }
 +  
-+  std::vector<std::string> text_parts;
++  std::string result;
++  // Reused for names that need sanitizing; clean names are appended straight
++  // from the node
++  std::string storage;
 +  
 +  // BFS to collect text from this node and its children
 +  std::queue<int32_t> queue;
 +  queue.push(node_id);
-+  int chars_collected = 0;
 +  
-+  while (!queue.empty() && chars_collected < max_chars) {
++  while (!queue.empty() && result.length() < static_cast<size_t>(max_chars)) {
 +    int32_t current_id = queue.front();
 +    queue.pop();
 +    
-+    auto current_it = node_map.find(current_id);
-+    if (current_it == node_map.end()) continue;
++    const ui::AXNodeData* current_ptr = node_index.Find(current_id);
++    if (!current_ptr) continue;
 +    
-+    const ui::AXNodeData& current = current_it->second;
++    const ui::AXNodeData& current = *current_ptr;
 +    
 +    // Collect text from this node
 +    if (current.HasStringAttribute(ax::mojom::StringAttribute::kName)) {
-+      std::string text = current.GetStringAttribute(ax::mojom::StringAttribute::kName);
-+      text = std::string(base::TrimWhitespaceASCII(text, base::TRIM_ALL));
-+      if (!text.empty()) {
-+        std::string clean_text = SanitizeStringForOutput(text);
-+        if (!clean_text.empty()) {
-+          text_parts.push_back(clean_text);
-+          chars_collected += clean_text.length();
++      std::string_view clean_text = browseros::SanitizeForOutput(
++          current.GetStringAttribute(ax::mojom::StringAttribute::kName),
++          &storage);
++      if (!clean_text.empty()) {
++        if (!result.empty()) {
++          result += ' ';
 +        }
++        result.append(clean_text);
 +      }
 +    }
 +    
@@ -207,28 +471,33 @@ index 0000000000000..885942336dcd6
 +    }
 +  }
 +  
-+  std::string result = base::JoinString(text_parts, " ");
 +  if (result.length() > static_cast<size_t>(max_chars)) {
-+    result = result.substr(0, max_chars - 3) + "...";
++    // Cut on a character boundary now that names keep non-ASCII text
++    std::string truncated;
++    base::TruncateUTF8ToByteSize(result, max_chars - 3, &truncated);
++    result = std::move(truncated) + "...";
 +  }
 +  return result;
 +}
 +
++// Maximum number of roles in a node's path, including the node itself
++constexpr int kMaxPathDepth = 10;
++
 +// Helper to build path using offset_container_id and return depth
 +std::pair<std::string, int> BuildPathAndDepth(
 +    int32_t node_id,
-+    const std::unordered_map<int32_t, ui::AXNodeData>& node_map) {
++    const SnapshotNodeIndex& node_index,
++    int max_depth = kMaxPathDepth) {
 +  
 +  std::vector<std::string> path_parts;
 +  int32_t current_id = node_id;
 +  int depth = 0;
-+  const int max_depth = 10;
 +  
 +  while (current_id >= 0 && depth < max_depth) {
-+    auto node_it = node_map.find(current_id);
-+    if (node_it == node_map.end()) break;
++    const ui::AXNodeData* node_ptr = node_index.Find(current_id);
++    if (!node_ptr) break;
 +    
-+    const ui::AXNodeData& node = node_it->second;
++    const ui::AXNodeData& node = *node_ptr;
 +    
 +    // Just append the role
 +    path_parts.push_back(ui::ToString(node.role));
@@ -243,209 +512,319 @@ index 0000000000000..885942336dcd6
 +  return std::make_pair(base::JoinString(path_parts, " > "), depth);
 +}
 +
++SnapshotContextMemo::SnapshotContextMemo() = default;
++SnapshotContextMemo::~SnapshotContextMemo() = default;
++
++std::string SnapshotContextMemo::GetContextText(
++    int32_t container_id,
++    const SnapshotNodeIndex& node_index,
++    int max_chars) {
++  {
++    base::AutoLock lock(lock_);
++    auto it = context_text_.find(container_id);
++    if (it != context_text_.end()) {
++      hits_.fetch_add(1, std::memory_order_relaxed);
++      return it->second;
++    }
++  }
++  misses_.fetch_add(1, std::memory_order_relaxed);
++  std::string text = CollectTextFromNode(container_id, node_index, max_chars);
++  base::AutoLock lock(lock_);
++  return context_text_.emplace(container_id, std::move(text)).first->second;
++}
++
++std::pair<std::string, int> SnapshotContextMemo::GetPathAndDepth(
++    const ui::AXNodeData& node,
++    const SnapshotNodeIndex& node_index) {
++  const int32_t container_id = node.relative_bounds.offset_container_id;
++  std::pair<std::string, int> container_path;
++  bool found = false;
++  {
++    base::AutoLock lock(lock_);
++    auto it = container_paths_.find(container_id);
++    if (it != container_paths_.end()) {
++      container_path = it->second;
++      found = true;
++    }
++  }
++  if (found) {
++    hits_.fetch_add(1, std::memory_order_relaxed);
++  } else {
++    misses_.fetch_add(1, std::memory_order_relaxed);
++    // The node itself takes one slot of the path
++    container_path =
++        BuildPathAndDepth(container_id, node_index, kMaxPathDepth - 1);
++    base::AutoLock lock(lock_);
++    container_paths_.emplace(container_id, container_path);
++  }
++
++  std::string role = ui::ToString(node.role);
++  if (container_path.first.empty()) {
++    return {std::move(role), container_path.second + 1};
++  }
++  return {container_path.first + " > " + role, container_path.second + 1};
++}
++
 +// Helper to populate all attributes for a node
 +void PopulateNodeAttributes(
 +    const ui::AXNodeData& node_data,
-+    std::unordered_map<std::string, std::string>& attributes) {
++    NodeAttributes& attributes) {
 +  
-+  // Add role as string
-+  attributes["role"] = ui::ToString(node_data.role);
++  // Role is stored as the enum and converted to a string at the API boundary
++  attributes.set_role(node_data.role);
 +  
-+  // Add value attribute for inputs
-+  if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kValue)) {
-+    std::string value = node_data.GetStringAttribute(ax::mojom::StringAttribute::kValue);
-+    attributes["value"] = SanitizeStringForOutput(value);
-+  }
++  // AX string attributes copied into the node attributes. Everything except
++  // the HTML tag is sanitized for output.
++  static constexpr struct {
++    ax::mojom::StringAttribute source;
++    NodeAttribute target;
++    bool sanitize;
++  } kStringAttributes[] = {
++      // Value attribute for inputs
++      {ax::mojom::StringAttribute::kValue, NodeAttribute::kValue, true},
++      {ax::mojom::StringAttribute::kHtmlTag, NodeAttribute::kHtmlTag, false},
++      {ax::mojom::StringAttribute::kRoleDescription,
++       NodeAttribute::kRoleDescription, true},
++      {ax::mojom::StringAttribute::kInputType, NodeAttribute::kInputType,
++       true},
++      {ax::mojom::StringAttribute::kTooltip, NodeAttribute::kTooltip, true},
++      // Placeholder for input fields
++      {ax::mojom::StringAttribute::kPlaceholder, NodeAttribute::kPlaceholder,
++       true},
++      // Description for more context
++      {ax::mojom::StringAttribute::kDescription, NodeAttribute::kDescription,
++       true},
++      // URL for links is intentionally not exported
++      {ax::mojom::StringAttribute::kCheckedStateDescription,
++       NodeAttribute::kCheckedState, true},
++      // Autocomplete hint
++      {ax::mojom::StringAttribute::kAutoComplete, NodeAttribute::kAutocomplete,
++       true},
++      // HTML ID for form associations
++      {ax::mojom::StringAttribute::kHtmlId, NodeAttribute::kId, true},
++      // HTML class names
++      {ax::mojom::StringAttribute::kClassName, NodeAttribute::kClass, true},
++  };
 +  
-+  // Add HTML tag if available
-+  if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kHtmlTag)) {
-+    attributes["html-tag"] = node_data.GetStringAttribute(ax::mojom::StringAttribute::kHtmlTag);
++  std::string storage;
++  for (const auto& entry : kStringAttributes) {
++    if (!node_data.HasStringAttribute(entry.source)) {
++      continue;
++    }
++    const std::string& value = node_data.GetStringAttribute(entry.source);
++    attributes.Set(entry.target,
++                   entry.sanitize ? std::string(browseros::SanitizeForOutput(
++                                        value, &storage))
++                                  : value);
 +  }
-+  
-+  // Add role description
-+  if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kRoleDescription)) {
-+    std::string role_desc = node_data.GetStringAttribute(ax::mojom::StringAttribute::kRoleDescription);
-+    attributes["role-description"] = SanitizeStringForOutput(role_desc);
++}
++
++// static
++std::optional<SnapshotProcessor::ProcessedNode> SnapshotProcessor::ProcessNode(
++    const SnapshotNodeIndex& node_index,
++    uint32_t offset,
++    ui::AXTree* ax_tree,
++    uint32_t node_id,
++    float device_scale_factor,
++    uint64_t reuse_key,
++    const SnapshotReuseTable* reuse_table,
++    SnapshotContextMemo* memo) {
++  const ui::AXNodeData& node_data = node_index.nodes()[offset];
++
++  // Skip invisible, ignored, or non-interactive elements
++  if (ShouldSkipNode(node_data)) {
++    return std::nullopt;
 +  }
-+  
-+  // Add input type
-+  if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kInputType)) {
-+    std::string input_type = node_data.GetStringAttribute(ax::mojom::StringAttribute::kInputType);
-+    attributes["input-type"] = SanitizeStringForOutput(input_type);
++
++  // Unchanged since the previous incremental snapshot: copy its output
++  if (reuse_table) {
++    auto reuse_it = reuse_table->nodes.find(reuse_key);
++    if (reuse_it != reuse_table->nodes.end()) {
++      ProcessedNode data = reuse_it->second;
++      data.node_data = &node_data;
++      data.node_id = node_id;
++      data.reused = true;
++      return data;
++    }
 +  }
 +  
-+  // Add tooltip
-+  if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kTooltip)) {
-+    std::string tooltip = node_data.GetStringAttribute(ax::mojom::StringAttribute::kTooltip);
-+    attributes["tooltip"] = SanitizeStringForOutput(tooltip);
-+  }
++  // Get the interactive node type
++  browser_os::InteractiveNodeType node_type = GetInteractiveNodeType(node_data);
 +  
-+  // Add placeholder for input fields
-+  if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kPlaceholder)) {
-+    std::string placeholder = node_data.GetStringAttribute(ax::mojom::StringAttribute::kPlaceholder);
-+    attributes["placeholder"] = SanitizeStringForOutput(placeholder);
-+  }
++  ProcessedNode data;
++  data.node_data = &node_data;
++  data.node_id = node_id;
++  data.node_type = node_type;
++  data.reuse_key = reuse_key;
 +  
-+  // Add description for more context
-+  if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kDescription)) {
-+    std::string description = node_data.GetStringAttribute(ax::mojom::StringAttribute::kDescription);
-+    attributes["description"] = SanitizeStringForOutput(description);
++  // Get accessible name
++  if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kName)) {
++    std::string storage;
++    data.name = std::string(browseros::SanitizeForOutput(
++        node_data.GetStringAttribute(ax::mojom::StringAttribute::kName),
++        &storage));
++  }
++
++  // Compute bounds using AXTree
++  bool is_offscreen = false;
++  if (ax_tree) {
++    ui::AXNode* ax_node = ax_tree->GetFromId(node_data.id);
++    if (ax_node) {
++      // GetNodeBounds now returns CSS pixels directly
++      data.absolute_bounds = GetNodeBounds(
++          ax_tree, 
++          ax_node,
++          ui::AXCoordinateSystem::kFrame,
++          // Use clipped bounds so the center lies within the visible area of
++          // scrolled/clip containers. This matches how clicks should target
++          // on-screen rects.
++          ui::AXClippingBehavior::kClipped,
++          device_scale_factor,  // Pass DSF for CSS pixel conversion
++          &is_offscreen);
++      
++      VLOG(3) << "[browseros] Node " << node_data.id 
++              << " CSS bounds: " << data.absolute_bounds.ToString()
++              << " offscreen: " << is_offscreen;
++    } else {
++      // Node not found in AXTree, skip bounds computation
++      VLOG(3) << "[browseros] Node " << node_data.id 
++              << " not found in AXTree, skipping bounds";
++    }
++  } else {
++    // No AXTree available
++    LOG(WARNING) << "[browseros] No AXTree available for bounds computation";
 +  }
 +  
-+  // Add URL for links
-+  // if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kUrl)) {
-+  //   std::string url = node_data.GetStringAttribute(ax::mojom::StringAttribute::kUrl);
-+  //   attributes["url"] = SanitizeStringForOutput(url);
-+  // }
++  // Populate all attributes using helper function
++  PopulateNodeAttributes(node_data, data.attributes);
 +  
-+  // Add checked state description
-+  if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kCheckedStateDescription)) {
-+    std::string checked_desc = node_data.GetStringAttribute(ax::mojom::StringAttribute::kCheckedStateDescription);
-+    attributes["checked-state"] = SanitizeStringForOutput(checked_desc);
++  // Add context from parent node
++  int32_t parent_id = node_data.relative_bounds.offset_container_id;
++  if (parent_id >= 0) {
++    std::string context =
++        memo ? memo->GetContextText(parent_id, node_index, 200)
++             : CollectTextFromNode(parent_id, node_index, 200);
++    if (!context.empty()) {
++      data.attributes.Set(NodeAttribute::kContext, std::move(context));
++    }
 +  }
 +  
-+  // Add autocomplete hint
-+  if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kAutoComplete)) {
-+    std::string autocomplete = node_data.GetStringAttribute(ax::mojom::StringAttribute::kAutoComplete);
-+    attributes["autocomplete"] = SanitizeStringForOutput(autocomplete);
++  // Add path and depth using offset_container_id chain
++  auto [path, depth] = memo ? memo->GetPathAndDepth(node_data, node_index)
++                            : BuildPathAndDepth(node_data.id, node_index);
++  if (!path.empty()) {
++    data.attributes.Set(NodeAttribute::kPath, std::move(path));
 +  }
++  data.attributes.set_depth(depth);
 +  
-+  // Add HTML ID for form associations
-+  if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kHtmlId)) {
-+    std::string html_id = node_data.GetStringAttribute(ax::mojom::StringAttribute::kHtmlId);
-+    attributes["id"] = SanitizeStringForOutput(html_id);
-+  }
++  // Set viewport status based on offscreen flag
++  // Note: offscreen=false means the node IS in viewport (at least partially visible)
++  // offscreen=true means the node is NOT in viewport (completely hidden)
++  data.attributes.set_in_viewport(!is_offscreen);
 +  
-+  // Add HTML class names
-+  if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kClassName)) {
-+    std::string class_name = node_data.GetStringAttribute(ax::mojom::StringAttribute::kClassName);
-+    attributes["class"] = SanitizeStringForOutput(class_name);
-+  }
++  return data;
 +}
 +
-+// Process a batch of nodes
-+std::vector<SnapshotProcessor::ProcessedNode> SnapshotProcessor::ProcessNodeBatch(
-+    const std::vector<ui::AXNodeData>& nodes_to_process,
-+    const std::unordered_map<int32_t, ui::AXNodeData>& node_map,
-+    ui::AXTree* ax_tree,
-+    uint32_t start_node_id,
-+    float device_scale_factor) {
-+  std::vector<ProcessedNode> results;
-+  results.reserve(nodes_to_process.size());
-+  
-+  uint32_t current_node_id = start_node_id;
-+  
-+  for (const auto& node_data : nodes_to_process) {
-+    // Skip invisible, ignored, or non-interactive elements
-+    if (ShouldSkipNode(node_data)) {
-+      continue;
-+    }
-+    
-+    // Double-check invisibility (already done in ShouldSkipNode, but being explicit)
-+    if (node_data.IsInvisibleOrIgnored()) {
-+      continue;
-+    }
-+    
-+    // Get the interactive node type
-+    browser_os::InteractiveNodeType node_type = GetInteractiveNodeType(node_data);
-+    
-+    ProcessedNode data;
-+    data.node_data = &node_data;
-+    data.node_id = current_node_id++;
-+    data.node_type = node_type;
-+    
-+    // Get accessible name
-+    if (node_data.HasStringAttribute(ax::mojom::StringAttribute::kName)) {
-+      std::string name = node_data.GetStringAttribute(ax::mojom::StringAttribute::kName);
-+      data.name = SanitizeStringForOutput(name);
++// static
++void SnapshotProcessor::ProcessRange(scoped_refptr<SnapshotWork> work,
++                                     size_t begin,
++                                     size_t end) {
++  work->ranges.fetch_add(1, std::memory_order_relaxed);
++  for (size_t i = begin; i < end; ++i) {
++    if (!work->deadline.is_null() && base::TimeTicks::Now() >= work->deadline) {
++      work->nodes_dropped.fetch_add(end - i, std::memory_order_relaxed);
++      return;
 +    }
++    const size_t slot = work->order.empty() ? i : work->order[i];
++    const uint32_t offset = work->offsets[slot];
++    // Node IDs follow slot order, so they need no sorting afterwards
++    work->slots[slot] = ProcessNode(
++        *work->node_index, offset, work->ax_tree.get(),
++        static_cast<uint32_t>(slot + 1), work->device_scale_factor,
++        work->reuse_hasher ? work->reuse_hasher->Key(offset) : 0,
++        work->reuse_table.get(), work->memo.get());
++  }
++}
 +
-+    // Compute bounds using AXTree
-+    bool is_offscreen = false;
-+    if (ax_tree) {
-+      ui::AXNode* ax_node = ax_tree->GetFromId(node_data.id);
-+      if (ax_node) {
-+        // GetNodeBounds now returns CSS pixels directly
-+        data.absolute_bounds = GetNodeBounds(
-+            ax_tree, 
-+            ax_node,
-+            ui::AXCoordinateSystem::kFrame,
-+            // Use clipped bounds so the center lies within the visible area of
-+            // scrolled/clip containers. This matches how clicks should target
-+            // on-screen rects.
-+            ui::AXClippingBehavior::kClipped,
-+            device_scale_factor,  // Pass DSF for CSS pixel conversion
-+            &is_offscreen);
-+        
-+        VLOG(3) << "[browseros] Node " << node_data.id 
-+                << " CSS bounds: " << data.absolute_bounds.ToString()
-+                << " offscreen: " << is_offscreen;
-+      } else {
-+        // Node not found in AXTree, skip bounds computation
-+        VLOG(3) << "[browseros] Node " << node_data.id 
-+                << " not found in AXTree, skipping bounds";
-+      }
-+    } else {
-+      // No AXTree available
-+      LOG(WARNING) << "[browseros] No AXTree available for bounds computation";
++// static
++std::vector<std::optional<SnapshotProcessor::ProcessedNode>>
++SnapshotProcessor::ProcessRangeForTesting(
++    scoped_refptr<const SnapshotNodeIndex> node_index,
++    std::unique_ptr<ui::AXTree> ax_tree,
++    std::vector<uint32_t> offsets,
++    scoped_refptr<SnapshotContextMemo> memo,
++    base::TimeTicks deadline) {
++  auto work = base::MakeRefCounted<SnapshotWork>();
++  work->node_index = std::move(node_index);
++  work->ax_tree = std::move(ax_tree);
++  work->offsets = std::move(offsets);
++  work->memo = std::move(memo);
++  work->deadline = deadline;
++  work->slots.resize(work->offsets.size());
++  ProcessRange(work, 0, work->offsets.size());
++  return std::move(work->slots);
++}
++
++// static
++void SnapshotProcessor::RankRange(scoped_refptr<SnapshotWork> work,
++                                  size_t begin,
++                                  size_t end) {
++  for (size_t i = begin; i < end; ++i) {
++    work->tiers[i] =
++        GetPriorityTier(*work->ax_tree, *work->node_index, work->offsets[i],
++                        /*known_onscreen=*/work->viewport_only);
++  }
++}
++
++// static
++void SnapshotProcessor::TakeElements(
++    ProcessingContext& context,
++    size_t begin,
++    size_t end,
++    std::vector<browser_os::InteractiveNode>& out) {
++  std::vector<std::optional<ProcessedNode>>& slots = context.work->slots;
++  BrowserOSNodeIdStore* node_id_store = context.node_id_store.get();
++  for (size_t i = begin; i < end; ++i) {
++    if (!slots[i]) {
++      continue;
 +    }
-+    
-+    // Populate all attributes using helper function
-+    PopulateNodeAttributes(node_data, data.attributes);
-+    
-+    // Add context from parent node
-+    int32_t parent_id = node_data.relative_bounds.offset_container_id;
-+    if (parent_id >= 0) {
-+      std::string context = CollectTextFromNode(parent_id, node_map, 200);
-+      if (!context.empty()) {
-+        data.attributes["context"] = context;
++    ProcessedNode& node_data = *slots[i];
++    if (context.next_reuse_table) {
++      if (node_data.reused) {
++        context.nodes_reused++;
 +      }
++      SnapshotProcessor::ProcessedNode& stored =
++          context.next_reuse_table->nodes[node_data.reuse_key];
++      stored = node_data;
++      stored.node_data = nullptr;
++      stored.reused = false;
 +    }
-+    
-+    // Add path and depth using offset_container_id chain
-+    auto [path, depth] = BuildPathAndDepth(node_data.id, node_map);
-+    if (!path.empty()) {
-+      data.attributes["path"] = path;
++
++    // More interactive nodes than a handle can number
++    if (node_data.node_id > kMaxNodeIndex) {
++      context.truncated = true;
++      slots[i].reset();
++      continue;
 +    }
-+    data.attributes["depth"] = std::to_string(depth);
-+    
-+    // Set viewport status based on offscreen flag
-+    // Note: offscreen=false means the node IS in viewport (at least partially visible)
-+    // offscreen=true means the node is NOT in viewport (completely hidden)
-+    data.attributes["in_viewport"] = is_offscreen ? "false" : "true";
-+    
-+    results.push_back(std::move(data));
-+  }
-+  
-+  return results;
-+}
++    const uint32_t node_id =
++        MakeNodeHandle(context.handle_tag, node_data.node_id);
 +
-+// Helper to handle batch processing results
-+void SnapshotProcessor::OnBatchProcessed(
-+    scoped_refptr<ProcessingContext> context,
-+    std::vector<ProcessedNode> batch_results) {
-+  // Process batch results
-+  for (const auto& node_data : batch_results) {
 +    // Store mapping from our nodeId to AX node ID, bounds, and attributes
 +    NodeInfo info;
 +    info.ax_node_id = node_data.node_data->id;
-+    info.ax_tree_id = context->tree_id;  // Store tree ID for change detection
++    info.ax_tree_id = context.tree_id;  // Store tree ID for change detection
 +    info.bounds = node_data.absolute_bounds;
-+    info.attributes = node_data.attributes;  // Store all computed attributes
 +    info.node_type = node_data.node_type;  // Store node type for efficient filtering
-+    // Extract in_viewport from attributes (stored as "true"/"false" string)
-+    auto viewport_it = node_data.attributes.find("in_viewport");
-+    info.in_viewport = (viewport_it != node_data.attributes.end() && viewport_it->second == "true");
-+    GetNodeIdMappings()[context->tab_id][node_data.node_id] = info;
++    info.in_viewport = node_data.attributes.in_viewport().value_or(false);
 +    
 +    // Log the mapping for debugging
-+    VLOG(2) << "Node ID Mapping: Interactive nodeId=" << node_data.node_id 
++    VLOG(2) << "Node ID Mapping: Interactive nodeId=" << node_id 
 +            << " -> AX node ID=" << info.ax_node_id 
 +            << " (name: " << node_data.name << ")";
 +    
 +    // Create interactive node
 +    browser_os::InteractiveNode interactive_node;
-+    interactive_node.node_id = node_data.node_id;
++    interactive_node.node_id = node_id;
 +    interactive_node.type = node_data.node_type;
 +    interactive_node.name = node_data.name;
 +    
@@ -457,52 +836,159 @@ index 0000000000000..885942336dcd6
 +    rect.height = node_data.absolute_bounds.height();
 +    interactive_node.rect = std::move(rect);
 +    
-+    // Create attributes dictionary by iterating over all key-value pairs
++    // Attributes are converted to a dictionary only here, at the API boundary
 +    if (!node_data.attributes.empty()) {
 +      browser_os::InteractiveNode::Attributes attributes;
-+      
-+      // Iterate over all attributes and add them to the dictionary
-+      for (const auto& [key, value] : node_data.attributes) {
-+        attributes.additional_properties.Set(key, value);
-+      }
-+      
++      attributes.additional_properties = node_data.attributes.ToDict();
 +      interactive_node.attributes = std::move(attributes);
 +    }
 +    
-+    context->snapshot.elements.push_back(std::move(interactive_node));
++    out.push_back(std::move(interactive_node));
++    
++    // The mapping takes ownership of the computed attributes
++    info.attributes = std::move(node_data.attributes);
++    if (node_id_store) {
++      node_id_store->AddNode(context.snapshot.snapshot_id, node_id,
++                             std::move(info));
++    }
++    slots[i].reset();
 +  }
++  context.elements_emitted += out.size();
++}
++
++// static
++void SnapshotProcessor::OnRangeProcessed(
++    scoped_refptr<ProcessingContext> context,
++    size_t begin,
++    size_t end) {
++  const std::vector<uint32_t>& order = context->work->order;
++  if (order.empty()) {
++    std::fill(context->ready.begin() + begin, context->ready.begin() + end,
++              true);
++  } else {
++    for (size_t i = begin; i < end; ++i) {
++      context->ready[order[i]] = true;
++    }
++  }
++  const size_t first = context->next_emit;
++  while (context->next_emit < context->ready.size() &&
++         context->ready[context->next_emit]) {
++    context->next_emit++;
++  }
++  if (context->next_emit == first) {
++    return;
++  }
++  std::vector<browser_os::InteractiveNode> elements;
++  elements.reserve(context->next_emit - first);
++  TakeElements(*context, first, context->next_emit, elements);
++  context->on_chunk.Run(std::move(elements));
++}
++
++// static
++void SnapshotProcessor::OnAllProcessed(
++    scoped_refptr<ProcessingContext> context) {
++  SnapshotWork& work = *context->work;
++  if (!context->on_chunk) {
++    // Slots are already in node ID order
++    context->snapshot.elements.reserve(work.slots.size());
++    TakeElements(*context, 0, work.slots.size(), context->snapshot.elements);
++  }
++  // The context may be released last by a worker, so drop the stream
++  // reference here on the UI thread
++  context->on_chunk.Reset();
++
++  const size_t dropped = work.nodes_dropped.load(std::memory_order_relaxed);
++  if (dropped > 0) {
++    VLOG(1) << "[browseros] Snapshot deadline reached, dropped " << dropped
++            << " nodes";
++    context->truncated = true;
++  }
++  context->stats.batches = work.ranges.load(std::memory_order_relaxed);
++
++  // Leave hierarchical_structure empty for now as requested
++  context->snapshot.hierarchical_structure = "";
++
++  base::TimeDelta processing_time = base::TimeTicks::Now() - context->start_time;
++  LOG(INFO) << "[PERF] Interactive snapshot processed in " 
++            << processing_time.InMilliseconds() << " ms"
++            << " (nodes: " << context->elements_emitted
++            << ", ranges: " << context->stats.batches
++            << ", index: " << context->stats.node_index_bytes / 1024
++            << " KB built in "
++            << context->stats.index_build_time.InMilliseconds() << " ms"
++            << ", culled: " << context->stats.nodes_culled
++            << ", truncated: " << context->truncated
++            << ", memo hits/misses: " << work.memo->hits() << "/"
++            << work.memo->misses() << ")";
++
++  // Set processing time in the snapshot
++  context->snapshot.processing_time_ms = processing_time.InMilliseconds();
++
++  SnapshotProcessingResult result;
++  result.snapshot = std::move(context->snapshot);
++  result.nodes_processed = context->total_nodes;
++  result.processing_time_ms = processing_time.InMilliseconds();
++  result.stats = context->stats;
++  result.nodes_reused = context->nodes_reused;
++  result.reuse_table = std::move(context->next_reuse_table);
++  result.truncated = context->truncated;
 +  
-+  context->processed_batches++;
-+  
-+  // Check if all batches are complete
-+  if (context->processed_batches == context->total_batches) {
-+    // Sort elements by node_id to maintain consistent ordering
-+    std::sort(context->snapshot.elements.begin(), 
-+              context->snapshot.elements.end(),
-+              [](const browser_os::InteractiveNode& a, 
-+                 const browser_os::InteractiveNode& b) {
-+                return a.node_id < b.node_id;
-+              });
++  // Run callback (context will be deleted when last ref is released)
++  std::move(context->callback).Run(std::move(result));
++}
 +
-+    // Leave hierarchical_structure empty for now as requested
-+    context->snapshot.hierarchical_structure = "";
++// static
++int SnapshotProcessor::GetPriorityTier(const ui::AXTree& ax_tree,
++                                       const SnapshotNodeIndex& node_index,
++                                       uint32_t offset,
++                                       bool known_onscreen) {
++  const ui::AXNodeData& data = node_index.nodes()[offset];
++  bool offscreen = false;
++  if (!known_onscreen) {
++    offscreen = true;
++    if (const ui::AXNode* node = ax_tree.GetFromId(data.id)) {
++      ax_tree.RelativeToTreeBounds(node, gfx::RectF(), &offscreen,
++                                   /*clip_bounds=*/true);
++    }
++  }
++  const bool typeable = GetInteractiveNodeType(data) ==
++                        browser_os::InteractiveNodeType::kTypeable;
++  return (offscreen ? 2 : 0) + (typeable ? 0 : 1);
++}
 +
-+    base::TimeDelta processing_time = base::TimeTicks::Now() - context->start_time;
-+    LOG(INFO) << "[PERF] Interactive snapshot processed in " 
-+              << processing_time.InMilliseconds() << " ms"
-+              << " (nodes: " << context->snapshot.elements.size() << ")";
++// static
++std::vector<uint32_t> SnapshotProcessor::SelectByPriority(
++    std::vector<uint32_t>& offsets,
++    const std::vector<int>& tiers,
++    size_t max_nodes) {
++  // Positions into |offsets|, highest priority first
++  std::vector<uint32_t> ranked(offsets.size());
++  for (size_t i = 0; i < ranked.size(); ++i) {
++    ranked[i] = static_cast<uint32_t>(i);
++  }
++  std::stable_sort(ranked.begin(), ranked.end(),
++                   [&tiers](uint32_t a, uint32_t b) {
++                     return tiers[a] < tiers[b];
++                   });
++  if (max_nodes > 0 && ranked.size() > max_nodes) {
++    ranked.resize(max_nodes);
++  }
 +
-+    // Set processing time in the snapshot
-+    context->snapshot.processing_time_ms = processing_time.InMilliseconds();
++  // Kept positions back in document order become the slots
++  std::vector<uint32_t> kept = ranked;
++  std::sort(kept.begin(), kept.end());
++  std::vector<uint32_t> slot_of(offsets.size());
++  std::vector<uint32_t> kept_offsets(kept.size());
++  for (size_t slot = 0; slot < kept.size(); ++slot) {
++    kept_offsets[slot] = offsets[kept[slot]];
++    slot_of[kept[slot]] = static_cast<uint32_t>(slot);
++  }
++  offsets = std::move(kept_offsets);
 +
-+    SnapshotProcessingResult result;
-+    result.snapshot = std::move(context->snapshot);
-+    result.nodes_processed = context->total_nodes;
-+    result.processing_time_ms = processing_time.InMilliseconds();
-+    
-+    // Run callback (context will be deleted when last ref is released)
-+    std::move(context->callback).Run(std::move(result));
++  for (uint32_t& position : ranked) {
++    position = slot_of[position];
 +  }
++  return ranked;
 +}
 +
 +// Main processing function
@@ -532,33 +1018,17 @@ index 0000000000000..885942336dcd6
 +}
 +
 +void SnapshotProcessor::ProcessAccessibilityTree(
-+    const ui::AXTreeUpdate& tree_update,
++    ui::AXTreeUpdate tree_update,
 +    int tab_id,
 +    uint32_t snapshot_id,
 +    content::WebContents* web_contents,
++    const SnapshotOptions& options,
 +    base::OnceCallback<void(SnapshotProcessingResult)> callback) {
 +  base::TimeTicks start_time = base::TimeTicks::Now();
 +  
 +  // Extract viewport info from WebContents on UI thread
 +  auto [viewport_size, device_scale_factor] = ExtractViewportInfo(web_contents);
 +  
-+  // Build node ID map, parent map and children map for efficient lookup
-+  std::unordered_map<int32_t, ui::AXNodeData> node_map;
-+  std::unordered_map<int32_t, int32_t> parent_map;
-+  std::unordered_map<int32_t, std::vector<int32_t>> children_map;
-+  
-+  for (const auto& node : tree_update.nodes) {
-+    node_map[node.id] = node;
-+    // Build parent and children relationships
-+    for (int32_t child_id : node.child_ids) {
-+      parent_map[child_id] = node.id;
-+      children_map[node.id].push_back(child_id);
-+    }
-+  }
-+  
-+  // Clear previous mappings for this tab
-+  GetNodeIdMappings()[tab_id].clear();
-+
 +  // Create an AXTree from the tree update for accurate bounds computation
 +  std::unique_ptr<ui::AXTree> ax_tree = std::make_unique<ui::AXTree>(tree_update);
 +  
@@ -574,79 +1044,155 @@ index 0000000000000..885942336dcd6
 +  LOG(INFO) << "[browseros] Created AXTree with " << tree_update.nodes.size() 
 +            << " nodes for bounds computation";
 +  
++  ui::AXTreeID tree_id;
++  if (tree_update.has_tree_data) {
++    tree_id = tree_update.tree_data.tree_id;
++  }
++  
++  // Build the shared node index once; every worker references it instead of
++  // receiving its own copy of the node map. The update is not needed once
++  // the AXTree exists, so its nodes are moved into the index rather than
++  // copied a second time.
++  base::TimeTicks index_start = base::TimeTicks::Now();
++  scoped_refptr<const SnapshotNodeIndex> node_index =
++      SnapshotNodeIndex::Create(std::move(tree_update));
++  SnapshotStats stats;
++  stats.tree_nodes = node_index->size();
++  stats.node_index_bytes = node_index->EstimateMemoryUsage();
++  stats.index_build_time = base::TimeTicks::Now() - index_start;
++  
 +  // Prepare processing context using RefCounted
 +  auto context = base::MakeRefCounted<ProcessingContext>();
 +  context->snapshot.snapshot_id = snapshot_id;
 +  context->snapshot.timestamp = base::Time::Now().InMillisecondsFSinceUnixEpoch();
 +  context->tab_id = tab_id;
-+  context->node_map = std::move(node_map);
-+  context->parent_map = std::move(parent_map); 
-+  context->children_map = std::move(children_map);
-+  context->ax_tree = std::move(ax_tree);  // Store AXTree for bounds computation
-+  context->device_scale_factor = device_scale_factor;  // For CSS pixel conversion
++  context->handle_tag = snapshot_id;
++  if (web_contents) {
++    // Elements become actionable as soon as they are emitted, so the
++    // mappings are filled in while the snapshot is processed
++    BrowserOSNodeIdStore::CreateForWebContents(web_contents);
++    BrowserOSNodeIdStore* node_id_store =
++        BrowserOSNodeIdStore::FromWebContents(web_contents);
++    context->handle_tag = node_id_store->StartSnapshot(snapshot_id);
++    context->node_id_store = node_id_store->GetWeakPtr();
++  }
++  context->work = base::MakeRefCounted<SnapshotWork>();
++  SnapshotWork& work = *context->work;
++  work.node_index = node_index;
++  work.ax_tree = std::move(ax_tree);  // Store AXTree for bounds computation
++  work.device_scale_factor = device_scale_factor;  // For CSS pixel conversion
++  work.reuse_table = options.reuse_table;
++  work.memo = base::MakeRefCounted<SnapshotContextMemo>();
++  work.deadline = options.deadline;
 +  context->viewport_size = viewport_size;  // For visibility checks
 +  context->start_time = start_time;
 +  
 +  // Store the tree ID for change detection
-+  if (tree_update.has_tree_data) {
-+    context->tree_id = tree_update.tree_data.tree_id;
-+  }
++  context->tree_id = tree_id;
 +  
-+  // Viewport size is passed in but not currently used for viewport bounds calculation
-+  // TODO: Implement proper viewport detection if needed
 +  context->callback = std::move(callback);
-+  context->processed_batches = 0;
++  context->on_chunk = options.on_chunk;
 +  
-+  // Collect all nodes to process and filter
-+  std::vector<ui::AXNodeData> nodes_to_process;
-+  for (const auto& node : tree_update.nodes) {
-+    // Skip invisible, ignored, or non-interactive nodes
-+    if (ShouldSkipNode(node)) {
-+      continue;
++  // Collect offsets of all nodes to process and filter
++  std::vector<uint32_t> nodes_to_process;
++  if (options.viewport_only) {
++    // Tree bounds are in physical pixels, the viewport size in DIPs
++    gfx::RectF viewport(gfx::ScaleSize(gfx::SizeF(viewport_size),
++                                       device_scale_factor));
++    size_t visited = 0;
++    nodes_to_process = CollectViewportNodes(*work.ax_tree, *node_index,
++                                            viewport, &visited);
++    stats.nodes_culled = stats.tree_nodes - std::min(visited, stats.tree_nodes);
++  } else {
++    const std::vector<ui::AXNodeData>& nodes = node_index->nodes();
++    for (size_t i = 0; i < nodes.size(); ++i) {
++      // Skip invisible, ignored, or non-interactive nodes
++      if (ShouldSkipNode(nodes[i])) {
++        continue;
++      }
++      nodes_to_process.push_back(static_cast<uint32_t>(i));
 +    }
-+    nodes_to_process.push_back(node);
 +  }
 +  
-+  context->total_nodes = nodes_to_process.size();
-+  
++  context->stats = stats;
++  context->max_nodes = options.max_nodes;
++  context->incremental = options.incremental;
++  work.offsets = std::move(nodes_to_process);
++  work.viewport_only = options.viewport_only;
++
++  if ((options.max_nodes > 0 || !options.deadline.is_null()) &&
++      !work.offsets.empty()) {
++    // Ranking needs each node's bounds, so it runs on the workers as well
++    work.tiers.resize(work.offsets.size());
++    ParallelFor(work.offsets.size(), kMinRangeSize,
++                base::TaskPriority::USER_VISIBLE,
++                base::BindRepeating(&SnapshotProcessor::RankRange,
++                                    context->work),
++                base::RepeatingCallback<void(size_t, size_t)>(),
++                base::BindOnce(&SnapshotProcessor::OnRanked, context));
++    return;
++  }
++  StartProcessing(context);
++}
++
++// static
++void SnapshotProcessor::OnRanked(scoped_refptr<ProcessingContext> context) {
++  SnapshotWork& work = *context->work;
++  const size_t candidates = work.offsets.size();
++  std::vector<uint32_t> order =
++      SelectByPriority(work.offsets, work.tiers, context->max_nodes);
++  work.tiers.clear();
++  context->truncated = work.offsets.size() < candidates;
++  // Under a deadline the highest-priority nodes are processed first; the
++  // slots, and so the node IDs, stay in document order
++  if (!work.deadline.is_null()) {
++    work.order = std::move(order);
++  }
++  StartProcessing(context);
++}
++
++// static
++void SnapshotProcessor::StartProcessing(
++    scoped_refptr<ProcessingContext> context) {
++  SnapshotWork& work = *context->work;
++  context->total_nodes = work.offsets.size();
++
++  if (context->incremental) {
++    work.reuse_hasher = std::make_unique<ReuseKeyHasher>(work.node_index);
++    context->next_reuse_table = base::MakeRefCounted<SnapshotReuseTable>();
++  }
++
 +  // Handle empty case
-+  if (nodes_to_process.empty()) {
-+    base::TimeDelta processing_time = base::TimeTicks::Now() - start_time;
++  if (work.offsets.empty()) {
++    base::TimeDelta processing_time =
++        base::TimeTicks::Now() - context->start_time;
 +    context->snapshot.processing_time_ms = processing_time.InMilliseconds();
 +    
 +    SnapshotProcessingResult result;
 +    result.snapshot = std::move(context->snapshot);
 +    result.nodes_processed = 0;
 +    result.processing_time_ms = processing_time.InMilliseconds();
++    result.stats = context->stats;
++    result.reuse_table = std::move(context->next_reuse_table);
++    result.truncated = context->truncated;
 +    std::move(context->callback).Run(std::move(result));
 +    return;
 +  }
 +  
-+  // Process nodes in batches using ThreadPool
-+  const size_t batch_size = 100;  // Process 100 nodes per batch
-+  size_t num_batches = (nodes_to_process.size() + batch_size - 1) / batch_size;
-+  context->total_batches = num_batches;
-+  
-+  for (size_t i = 0; i < nodes_to_process.size(); i += batch_size) {
-+    size_t end = std::min(i + batch_size, nodes_to_process.size());
-+    std::vector<ui::AXNodeData> batch(
-+        std::make_move_iterator(nodes_to_process.begin() + i),
-+        std::make_move_iterator(nodes_to_process.begin() + end));
-+    uint32_t start_node_id = i + 1;  // Node IDs start at 1
-+    
-+    // Post task to ThreadPool and handle result on UI thread
-+    base::ThreadPool::PostTaskAndReplyWithResult(
-+        FROM_HERE,
-+        {base::TaskPriority::USER_VISIBLE},
-+        base::BindOnce(&SnapshotProcessor::ProcessNodeBatch, 
-+                       std::move(batch), 
-+                       context->node_map,
-+                       context->ax_tree.get(),  // Pass AXTree pointer for bounds computation
-+                       start_node_id,
-+                       context->device_scale_factor),  // Pass DSF for CSS pixel conversion
-+        base::BindOnce(&SnapshotProcessor::OnBatchProcessed,
-+                       context));
++  work.slots.resize(work.offsets.size());
++  if (context->on_chunk) {
++    context->ready.resize(work.offsets.size());
 +  }
++
++  // Workers fill the preallocated slots directly; the UI thread only hears
++  // back once at the end, plus once per range when streaming
++  ParallelFor(
++      work.offsets.size(), kMinRangeSize, base::TaskPriority::USER_VISIBLE,
++      base::BindRepeating(&SnapshotProcessor::ProcessRange, context->work),
++      context->on_chunk
++          ? base::BindRepeating(&SnapshotProcessor::OnRangeProcessed, context)
++          : base::RepeatingCallback<void(size_t, size_t)>(),
++      base::BindOnce(&SnapshotProcessor::OnAllProcessed, context));
 +}
 +
 +
@@ -1,9 +1,9 @@
 diff --git a/chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor.h b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor.h
 new file mode 100644
-index 0000000000000..5c85cd73b26f3
+index 0000000000000..6bd16e749c7b4
 --- /dev/null
 +++ b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor.h
-@@ -0,0 +1,111 @@
+@@ -0,0 +1,318 @@
 +// Copyright 2024 The Chromium Authors
 +// Use of this source code is governed by a BSD-style license that can be
 +// found in the LICENSE file.
@@ -11,13 +11,23 @@ index 0000000000000..5c85cd73b26f3
 +#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SNAPSHOT_PROCESSOR_H_
 +#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SNAPSHOT_PROCESSOR_H_
 +
++#include <atomic>
 +#include <cstdint>
++#include <memory>
++#include <optional>
 +#include <string>
 +#include <unordered_map>
++#include <utility>
 +#include <vector>
 +
 +#include "base/functional/callback.h"
 +#include "base/memory/raw_ptr.h"
++#include "base/memory/ref_counted.h"
++#include "base/memory/scoped_refptr.h"
++#include "base/synchronization/lock.h"
++#include "base/thread_annotations.h"
++#include "base/time/time.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_attributes.h"
 +#include "chrome/common/extensions/api/browser_os.h"
 +#include "ui/gfx/geometry/rect_f.h"
 +
@@ -37,11 +47,76 @@ index 0000000000000..5c85cd73b26f3
 +namespace extensions {
 +namespace api {
 +
++class SnapshotContextMemo;
++class SnapshotNodeIndex;
++class SnapshotReuseTable;
++
++// Options for a single ProcessAccessibilityTree call
++struct SnapshotOptions {
++  SnapshotOptions();
++  SnapshotOptions(const SnapshotOptions&);
++  SnapshotOptions& operator=(const SnapshotOptions&);
++  ~SnapshotOptions();
++
++  // When set, every interactive node gets a reuse key derived from its
++  // subtree and offset-container chain. Nodes whose key is found in
++  // |reuse_table| are copied from it instead of being re-processed, and the
++  // result carries a fresh table for the next incremental snapshot.
++  bool incremental = false;
++  scoped_refptr<const SnapshotReuseTable> reuse_table;
++
++  // When set, the tree is walked from the root and containers that lie
++  // entirely outside the viewport are skipped together with their subtree,
++  // so only visible interactive nodes are processed.
++  bool viewport_only = false;
++
++  // When set, processed elements are handed to this callback in order as
++  // soon as every element before them is done, and the final result carries
++  // no elements. Runs on the UI thread.
++  base::RepeatingCallback<void(std::vector<browser_os::InteractiveNode>)>
++      on_chunk;
++
++  // Bounded-cost mode. With either set, interactive nodes are processed in
++  // priority order (typeable in viewport, in viewport, typeable, the rest)
++  // instead of document order. At most |max_nodes| are processed (0 means no
++  // limit), and workers stop picking up nodes once |deadline| has passed.
++  size_t max_nodes = 0;
++  base::TimeTicks deadline;
++};
++
++// Memory and latency counters for a single snapshot
++struct SnapshotStats {
++  // Number of nodes in the AX tree update
++  size_t tree_nodes = 0;
++  // Number of ranges the parallel-for split the interactive nodes into
++  size_t batches = 0;
++  // Approximate size of the shared node index, which holds the update's
++  // nodes moved out of it rather than a copy
++  size_t node_index_bytes = 0;
++  // Time spent building the node index on the UI thread
++  base::TimeDelta index_build_time;
++  // Viewport-only mode: nodes never visited because an ancestor container
++  // was offscreen
++  size_t nodes_culled = 0;
++};
++
 +// Result of snapshot processing
 +struct SnapshotProcessingResult {
++  SnapshotProcessingResult();
++  SnapshotProcessingResult(SnapshotProcessingResult&&);
++  SnapshotProcessingResult& operator=(SnapshotProcessingResult&&);
++  ~SnapshotProcessingResult();
++
 +  browser_os::InteractiveSnapshot snapshot;
 +  int nodes_processed = 0;
 +  int64_t processing_time_ms = 0;
++  SnapshotStats stats;
++  // Incremental mode only: nodes copied from the previous reuse table, and
++  // the table to pass to the next snapshot of the same tab.
++  int nodes_reused = 0;
++  scoped_refptr<const SnapshotReuseTable> reuse_table;
++  // True if |max_nodes| or the deadline left interactive nodes out
++  bool truncated = false;
 +};
 +
 +// Processes accessibility trees into interactive snapshots with parallel processing
@@ -61,8 +136,12 @@ index 0000000000000..5c85cd73b26f3
 +    browser_os::InteractiveNodeType node_type;
 +    std::string name;
 +    gfx::RectF absolute_bounds;
-+    // All attributes stored as key-value pairs
-+    std::unordered_map<std::string, std::string> attributes;
++    // Computed attributes, converted to a dictionary at the API boundary
++    NodeAttributes attributes;
++    // Incremental mode only: content key used to reuse this node's output
++    uint64_t reuse_key = 0;
++    // True if the node was copied from a previous snapshot
++    bool reused = false;
 +  };
 +
 +  SnapshotProcessor() = default;
@@ -71,27 +150,53 @@ index 0000000000000..5c85cd73b26f3
 +  // Main processing function - handles all threading internally
 +  // This function processes the accessibility tree into an interactive snapshot
 +  // using parallel processing on the thread pool. Extracts viewport info from
-+  // web_contents on UI thread before processing.
++  // web_contents on UI thread before processing, and records the nodeId
++  // mappings as |snapshot_id| in the tab's BrowserOSNodeIdStore. The update
++  // is taken by value so that callers which are done with it can move it in
++  // and its nodes are not copied.
 +  static void ProcessAccessibilityTree(
-+      const ui::AXTreeUpdate& tree_update,
++      ui::AXTreeUpdate tree_update,
 +      int tab_id,
 +      uint32_t snapshot_id,
 +      content::WebContents* web_contents,
++      const SnapshotOptions& options,
 +      base::OnceCallback<void(SnapshotProcessingResult)> callback);
 +
-+  // Process a batch of nodes (exposed for testing)
-+  // The ax_tree is used to compute accurate bounds for each node
-+  // device_scale_factor is used to convert physical pixels to CSS pixels
-+  static std::vector<ProcessedNode> ProcessNodeBatch(
-+      const std::vector<ui::AXNodeData>& nodes_to_process,
-+      const std::unordered_map<int32_t, ui::AXNodeData>& node_map,
-+      ui::AXTree* ax_tree,
-+      uint32_t start_node_id,
-+      float device_scale_factor = 1.0f);
++  // Runs ProcessRange over all of |offsets| on the calling thread with a
++  // SnapshotWork built from the arguments, and returns its result slots.
++  // Slot i holds the node with nodeId i + 1, or nullopt if it was skipped or
++  // dropped at |deadline|. Without |memo| context text and paths are
++  // recomputed for every node.
++  static std::vector<std::optional<ProcessedNode>> ProcessRangeForTesting(
++      scoped_refptr<const SnapshotNodeIndex> node_index,
++      std::unique_ptr<ui::AXTree> ax_tree,
++      std::vector<uint32_t> offsets,
++      scoped_refptr<SnapshotContextMemo> memo,
++      base::TimeTicks deadline = base::TimeTicks());
++
++  // Bounded-cost priority tier of the node at |offset|: 0 for typeable nodes
++  // in the viewport, 1 for other nodes in the viewport, 2 for offscreen
++  // typeable nodes, 3 for the rest. |known_onscreen| skips the bounds
++  // computation for nodes already found in the viewport.
++  static int GetPriorityTier(const ui::AXTree& ax_tree,
++                             const SnapshotNodeIndex& node_index,
++                             uint32_t offset,
++                             bool known_onscreen);
++
++  // Keeps the |max_nodes| (0 = all) offsets with the lowest |tiers|, earlier
++  // ones first within a tier, and leaves them in |offsets| in their original
++  // document order. Returns the kept slots from highest to lowest priority.
++  // |tiers| is parallel to |offsets|.
++  static std::vector<uint32_t> SelectByPriority(
++      std::vector<uint32_t>& offsets,
++      const std::vector<int>& tiers,
++      size_t max_nodes);
 +
 + private:
-+  // Internal processing context
++  // Internal processing context, UI thread only
 +  struct ProcessingContext;
++  // Inputs and result slots shared with the workers
++  struct SnapshotWork;
 +  
 +  // Compute absolute bounds for a node using AXTree and convert to CSS pixels
 +  // This implements the same logic as BrowserAccessibility::GetBoundsRect
@@ -103,14 +208,116 @@ index 0000000000000..5c85cd73b26f3
 +                                   float device_scale_factor = 1.0f,
 +                                   bool* out_offscreen = nullptr);
 +  
-+  // Batch processing callback
-+  static void OnBatchProcessed(scoped_refptr<ProcessingContext> context,
-+                               std::vector<ProcessedNode> batch_results);
++  // Processes one interactive node, or returns nullopt if it is skipped.
++  // |reuse_table| may be null.
++  static std::optional<ProcessedNode> ProcessNode(
++      const SnapshotNodeIndex& node_index,
++      uint32_t offset,
++      ui::AXTree* ax_tree,
++      uint32_t node_id,
++      float device_scale_factor,
++      uint64_t reuse_key,
++      const SnapshotReuseTable* reuse_table,
++      SnapshotContextMemo* memo);
++
++  // Parallel-for body: fills the result slots of [begin, end). Runs on a
++  // worker thread.
++  static void ProcessRange(scoped_refptr<SnapshotWork> work,
++                           size_t begin,
++                           size_t end);
++
++  // Bounded-cost mode: fills the priority tiers of [begin, end). Runs on a
++  // worker thread.
++  static void RankRange(scoped_refptr<SnapshotWork> work,
++                        size_t begin,
++                        size_t end);
++
++  // Bounded-cost mode: applies the node budget once every tier is known.
++  static void OnRanked(scoped_refptr<ProcessingContext> context);
++
++  // Processes |context->work->offsets| on the workers.
++  static void StartProcessing(scoped_refptr<ProcessingContext> context);
++
++  // Streaming mode: emits every element that is now contiguous with the
++  // ones already sent.
++  static void OnRangeProcessed(scoped_refptr<ProcessingContext> context,
++                               size_t begin,
++                               size_t end);
++
++  // Runs once every range is done; assembles and reports the result.
++  static void OnAllProcessed(scoped_refptr<ProcessingContext> context);
++
++  // Converts the filled slots in [begin, end) to API nodes in slot order and
++  // records their node ID mappings.
++  static void TakeElements(ProcessingContext& context,
++                           size_t begin,
++                           size_t end,
++                           std::vector<browser_os::InteractiveNode>& out);
 +
 +  SnapshotProcessor(const SnapshotProcessor&) = delete;
 +  SnapshotProcessor& operator=(const SnapshotProcessor&) = delete;
 +};
 +
++// Context text and offset-container paths memoized per container for one
++// snapshot. Interactive siblings (rows of a table, items of a menu) share an
++// offset container, so without the memo each of them re-collects the same
++// subtree text and re-joins the same ancestor chain.
++//
++// Shared by every worker batch of a snapshot. The lock only guards map
++// lookups and inserts; values are computed outside it, so two batches may
++// race to compute the same container, which is harmless since the result
++// is identical.
++class SnapshotContextMemo
++    : public base::RefCountedThreadSafe<SnapshotContextMemo> {
++ public:
++  SnapshotContextMemo();
++  SnapshotContextMemo(const SnapshotContextMemo&) = delete;
++  SnapshotContextMemo& operator=(const SnapshotContextMemo&) = delete;
++
++  // Text of |container_id|'s subtree, truncated to |max_chars|.
++  std::string GetContextText(int32_t container_id,
++                             const SnapshotNodeIndex& node_index,
++                             int max_chars);
++
++  // Role path and depth of |node|, built from the memoized path of its
++  // offset container.
++  std::pair<std::string, int> GetPathAndDepth(
++      const ui::AXNodeData& node,
++      const SnapshotNodeIndex& node_index);
++
++  size_t hits() const { return hits_.load(std::memory_order_relaxed); }
++  size_t misses() const { return misses_.load(std::memory_order_relaxed); }
++
++ private:
++  friend class base::RefCountedThreadSafe<SnapshotContextMemo>;
++  ~SnapshotContextMemo();
++
++  base::Lock lock_;
++  std::unordered_map<int32_t, std::string> context_text_ GUARDED_BY(lock_);
++  // Container id -> (top-down role path, number of roles in it)
++  std::unordered_map<int32_t, std::pair<std::string, int>> container_paths_
++      GUARDED_BY(lock_);
++  std::atomic<size_t> hits_{0};
++  std::atomic<size_t> misses_{0};
++};
++
++// Processed nodes of a previous snapshot keyed by reuse key. Immutable once
++// built and shared read-only with worker batches.
++class SnapshotReuseTable
++    : public base::RefCountedThreadSafe<SnapshotReuseTable> {
++ public:
++  SnapshotReuseTable();
++  SnapshotReuseTable(const SnapshotReuseTable&) = delete;
++  SnapshotReuseTable& operator=(const SnapshotReuseTable&) = delete;
++
++  // Stored nodes have |node_data| cleared; it is re-pointed on reuse.
++  std::unordered_map<uint64_t, SnapshotProcessor::ProcessedNode> nodes;
++
++ private:
++  friend class base::RefCountedThreadSafe<SnapshotReuseTable>;
++  ~SnapshotReuseTable();
++};
++
 +}  // namespace api
 +}  // namespace extensions
 +
@@ -0,0 +1,64 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor_perftest.cc b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor_perftest.cc
+new file mode 100644
+index 0000000000000..c229ac2b62e81
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor_perftest.cc
+@@ -0,0 +1,58 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include <memory>
++#include <utility>
++#include <vector>
++
++#include "base/timer/elapsed_timer.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_index.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor.h"
++#include "chrome/browser/extensions/api/browser_os/test/snapshot_test_util.h"
++#include "testing/gtest/include/gtest/gtest.h"
++#include "testing/perf/perf_result_reporter.h"
++#include "ui/accessibility/ax_tree.h"
++#include "ui/accessibility/ax_tree_update.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++constexpr int kTableRows = 10000;
++
++// Every button in the table shares one offset container, so without the memo
++// each of them re-walks the table subtree for its context text.
++TEST(SnapshotProcessorPerfTest, Table10kContextMemo) {
++  ui::AXTreeUpdate update = test::BuildTableTreeUpdate(kTableRows);
++  scoped_refptr<const SnapshotNodeIndex> index =
++      SnapshotNodeIndex::Create(update);
++  std::vector<uint32_t> offsets = test::GetButtonOffsets(update);
++
++  // Trees are built up front so that only ProcessRange is timed
++  auto uncached_tree = std::make_unique<ui::AXTree>(update);
++  auto memoized_tree = std::make_unique<ui::AXTree>(update);
++
++  base::ElapsedTimer uncached_timer;
++  auto uncached = SnapshotProcessor::ProcessRangeForTesting(
++      index, std::move(uncached_tree), offsets, nullptr);
++  base::TimeDelta uncached_time = uncached_timer.Elapsed();
++
++  base::ElapsedTimer memoized_timer;
++  auto memoized = SnapshotProcessor::ProcessRangeForTesting(
++      index, std::move(memoized_tree), offsets,
++      base::MakeRefCounted<SnapshotContextMemo>());
++  base::TimeDelta memoized_time = memoized_timer.Elapsed();
++
++  ASSERT_EQ(uncached.size(), memoized.size());
++
++  perf_test::PerfResultReporter reporter("BrowserOSSnapshot.", "Table10k");
++  reporter.RegisterImportantMetric(".uncached", "ms");
++  reporter.RegisterImportantMetric(".memoized", "ms");
++  reporter.AddResult(".uncached", uncached_time);
++  reporter.AddResult(".memoized", memoized_time);
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,160 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor_unittest.cc b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor_unittest.cc
+new file mode 100644
+index 0000000000000..89392c62c7d1f
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor_unittest.cc
+@@ -0,0 +1,154 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_snapshot_processor.h"
++
++#include <memory>
++#include <optional>
++#include <vector>
++
++#include "base/time/time.h"
++#include "chrome/browser/extensions/api/browser_os/browser_os_node_index.h"
++#include "chrome/browser/extensions/api/browser_os/test/snapshot_test_util.h"
++#include "testing/gtest/include/gtest/gtest.h"
++#include "ui/accessibility/ax_enums.mojom.h"
++#include "ui/accessibility/ax_tree.h"
++#include "ui/accessibility/ax_tree_update.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++// =============================================================================
++// Context Memo Tests
++// =============================================================================
++
++TEST(SnapshotProcessorMemoTest, MemoizedOutputMatchesUncached) {
++  ui::AXTreeUpdate update = test::BuildTableTreeUpdate(50);
++  scoped_refptr<const SnapshotNodeIndex> index =
++      SnapshotNodeIndex::Create(update);
++  std::vector<uint32_t> offsets = test::GetButtonOffsets(update);
++
++  std::vector<std::optional<SnapshotProcessor::ProcessedNode>> uncached =
++      SnapshotProcessor::ProcessRangeForTesting(
++          index, std::make_unique<ui::AXTree>(update), offsets, nullptr);
++  std::vector<std::optional<SnapshotProcessor::ProcessedNode>> memoized =
++      SnapshotProcessor::ProcessRangeForTesting(
++          index, std::make_unique<ui::AXTree>(update), offsets,
++          base::MakeRefCounted<SnapshotContextMemo>());
++
++  ASSERT_EQ(offsets.size(), uncached.size());
++  ASSERT_EQ(uncached.size(), memoized.size());
++  for (size_t i = 0; i < uncached.size(); ++i) {
++    ASSERT_TRUE(uncached[i]);
++    ASSERT_TRUE(memoized[i]);
++    EXPECT_EQ(i + 1, memoized[i]->node_id);
++    EXPECT_EQ(uncached[i]->attributes, memoized[i]->attributes);
++    EXPECT_EQ(uncached[i]->absolute_bounds, memoized[i]->absolute_bounds);
++  }
++}
++
++TEST(SnapshotProcessorMemoTest, SiblingsShareOneComputation) {
++  ui::AXTreeUpdate update = test::BuildTableTreeUpdate(50);
++  scoped_refptr<const SnapshotNodeIndex> index =
++      SnapshotNodeIndex::Create(update);
++  std::vector<uint32_t> offsets = test::GetButtonOffsets(update);
++
++  auto memo = base::MakeRefCounted<SnapshotContextMemo>();
++  SnapshotProcessor::ProcessRangeForTesting(
++      index, std::make_unique<ui::AXTree>(update), offsets, memo);
++
++  // All buttons share the table as offset container: one miss for the
++  // context text and one for the path, everything else is a hit.
++  EXPECT_EQ(2u, memo->misses());
++  EXPECT_EQ(offsets.size() * 2 - 2, memo->hits());
++}
++
++TEST(SnapshotProcessorMemoTest, PathIncludesNodeAndContainerChain) {
++  ui::AXTreeUpdate update = test::BuildTableTreeUpdate(1);
++  scoped_refptr<const SnapshotNodeIndex> index =
++      SnapshotNodeIndex::Create(update);
++  std::vector<uint32_t> offsets = test::GetButtonOffsets(update);
++  ASSERT_EQ(1u, offsets.size());
++
++  auto memo = base::MakeRefCounted<SnapshotContextMemo>();
++  auto [path, depth] =
++      memo->GetPathAndDepth(index->nodes()[offsets[0]], *index);
++  EXPECT_EQ("rootWebArea > table > button", path);
++  EXPECT_EQ(3, depth);
++}
++
++// =============================================================================
++// Bounded-Cost Tests
++// =============================================================================
++
++TEST(SnapshotProcessorBudgetTest, ExpiredDeadlineDropsRange) {
++  ui::AXTreeUpdate update = test::BuildTableTreeUpdate(10);
++  scoped_refptr<const SnapshotNodeIndex> index =
++      SnapshotNodeIndex::Create(update);
++  std::vector<uint32_t> offsets = test::GetButtonOffsets(update);
++
++  for (const auto& slot : SnapshotProcessor::ProcessRangeForTesting(
++           index, std::make_unique<ui::AXTree>(update), offsets,
++           base::MakeRefCounted<SnapshotContextMemo>(),
++           base::TimeTicks::Now() - base::Milliseconds(1))) {
++    EXPECT_FALSE(slot);
++  }
++  for (const auto& slot : SnapshotProcessor::ProcessRangeForTesting(
++           index, std::make_unique<ui::AXTree>(update), offsets,
++           base::MakeRefCounted<SnapshotContextMemo>(),
++           base::TimeTicks::Now() + base::Hours(1))) {
++    EXPECT_TRUE(slot);
++  }
++}
++
++TEST(SnapshotProcessorBudgetTest, PriorityPutsVisibleTypeableFirst) {
++  ui::AXTreeUpdate update = test::BuildTableTreeUpdate(4);
++  std::vector<uint32_t> offsets = test::GetButtonOffsets(update);
++  ASSERT_EQ(4u, offsets.size());
++  // Row 1 scrolled far out of the table, rows 2 and 3 turned into text
++  // fields, so the tiers are: 2 (typeable, visible), 0 (visible),
++  // 3 (typeable, offscreen), 1 (offscreen).
++  update.nodes[offsets[1]].relative_bounds.bounds.set_y(-5000);
++  update.nodes[offsets[3]].relative_bounds.bounds.set_y(-5000);
++  update.nodes[offsets[2]].role = ax::mojom::Role::kTextField;
++  update.nodes[offsets[3]].role = ax::mojom::Role::kTextField;
++  ui::AXTree tree(update);
++  scoped_refptr<const SnapshotNodeIndex> index =
++      SnapshotNodeIndex::Create(update);
++
++  std::vector<int> tiers;
++  for (uint32_t offset : offsets) {
++    tiers.push_back(SnapshotProcessor::GetPriorityTier(
++        tree, *index, offset, /*known_onscreen=*/false));
++  }
++  EXPECT_EQ((std::vector<int>{1, 3, 0, 2}), tiers);
++
++  // Nodes found in the viewport are only ranked by type
++  EXPECT_EQ(1, SnapshotProcessor::GetPriorityTier(tree, *index, offsets[1],
++                                                  /*known_onscreen=*/true));
++
++  std::vector<uint32_t> kept = offsets;
++  EXPECT_EQ((std::vector<uint32_t>{2, 0, 3, 1}),
++            SnapshotProcessor::SelectByPriority(kept, tiers, 0));
++  EXPECT_EQ(offsets, kept);
++}
++
++TEST(SnapshotProcessorBudgetTest, BudgetKeepsDocumentOrder) {
++  const std::vector<uint32_t> offsets = {10, 11, 12, 13, 14};
++  const std::vector<int> tiers = {3, 1, 0, 2, 1};
++
++  std::vector<uint32_t> kept = offsets;
++  std::vector<uint32_t> order =
++      SnapshotProcessor::SelectByPriority(kept, tiers, 3);
++
++  // Offsets 12, 11 and 14 win, and come out in document order
++  EXPECT_EQ((std::vector<uint32_t>{11, 12, 14}), kept);
++  // Processing still starts with the highest-priority slot
++  EXPECT_EQ((std::vector<uint32_t>{1, 0, 2}), order);
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,151 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_snapshot_stream.cc b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_stream.cc
+new file mode 100644
+index 0000000000000..17a6909f1f68e
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_stream.cc
+@@ -0,0 +1,145 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_snapshot_stream.h"
++
++#include <map>
++#include <utility>
++
++#include "base/functional/bind.h"
++#include "base/logging.h"
++#include "base/no_destructor.h"
++
++namespace extensions {
++namespace api {
++
++namespace {
++
++std::map<int, scoped_refptr<SnapshotStream>>& GetStreams() {
++  static base::NoDestructor<std::map<int, scoped_refptr<SnapshotStream>>>
++      streams;
++  return *streams;
++}
++
++int g_next_stream_id = 1;
++
++}  // namespace
++
++// static
++scoped_refptr<SnapshotStream> SnapshotStream::Create(
++    content::BrowserContext* browser_context,
++    const ExtensionId& extension_id) {
++  auto stream = base::WrapRefCounted(
++      new SnapshotStream(g_next_stream_id++, browser_context, extension_id));
++  GetStreams()[stream->id()] = stream;
++  stream->idle_timer_.Reset();
++  return stream;
++}
++
++// static
++scoped_refptr<SnapshotStream> SnapshotStream::Find(
++    int stream_id,
++    content::BrowserContext* browser_context,
++    const ExtensionId& extension_id) {
++  auto it = GetStreams().find(stream_id);
++  if (it == GetStreams().end()) {
++    return nullptr;
++  }
++  // Ids are sequential, so they must not let other extensions or profiles
++  // read the elements of a snapshot they did not take
++  if (it->second->browser_context_ != browser_context ||
++      it->second->extension_id_ != extension_id) {
++    return nullptr;
++  }
++  return it->second;
++}
++
++SnapshotStream::SnapshotStream(int id,
++                               content::BrowserContext* browser_context,
++                               const ExtensionId& extension_id)
++    : id_(id),
++      browser_context_(browser_context),
++      extension_id_(extension_id),
++      created_(base::TimeTicks::Now()),
++      // Unretained is safe: the timer is owned by the stream.
++      idle_timer_(FROM_HERE,
++                  kIdleTimeout,
++                  base::BindRepeating(&SnapshotStream::Unregister,
++                                      base::Unretained(this))) {}
++
++SnapshotStream::~SnapshotStream() = default;
++
++void SnapshotStream::AddElements(
++    std::vector<browser_os::InteractiveNode> elements) {
++  if (elements.empty()) {
++    return;
++  }
++  if (!time_to_first_element_) {
++    time_to_first_element_ = base::TimeTicks::Now() - created_;
++  }
++  total_elements_ += elements.size();
++  if (buffered_.empty()) {
++    buffered_ = std::move(elements);
++  } else {
++    buffered_.insert(buffered_.end(), std::make_move_iterator(elements.begin()),
++                     std::make_move_iterator(elements.end()));
++  }
++  MaybeDeliver();
++}
++
++void SnapshotStream::Finish(browser_os::InteractiveSnapshot summary) {
++  summary.elements.clear();
++  summary.stream_id = id_;
++  summary_ = std::move(summary);
++  MaybeDeliver();
++}
++
++bool SnapshotStream::ReadNextChunk(ChunkCallback callback) {
++  if (pending_read_) {
++    return false;
++  }
++  pending_read_ = std::move(callback);
++  // A waiting reader keeps the stream alive however long processing takes
++  idle_timer_.Stop();
++  MaybeDeliver();
++  return true;
++}
++
++void SnapshotStream::MaybeDeliver() {
++  if (!pending_read_ || (buffered_.empty() && !summary_)) {
++    return;
++  }
++
++  browser_os::SnapshotChunk chunk;
++  chunk.stream_id = id_;
++  chunk.sequence = next_sequence_++;
++  chunk.elements = std::move(buffered_);
++  buffered_.clear();
++  chunk.done = summary_.has_value();
++  if (chunk.done) {
++    chunk.total_elements = total_elements_;
++    chunk.summary = std::move(*summary_);
++    summary_.reset();
++  }
++
++  // Keep |this| alive while the reader runs and the stream unregisters
++  scoped_refptr<SnapshotStream> self(this);
++  if (chunk.done) {
++    Unregister();
++  } else {
++    idle_timer_.Reset();
++  }
++  std::move(pending_read_).Run(std::move(chunk));
++}
++
++void SnapshotStream::Unregister() {
++  idle_timer_.Stop();
++  VLOG(1) << "[browseros] Snapshot stream " << id_ << " closed after "
++          << total_elements_ << " elements";
++  // May release the last reference to |this|
++  GetStreams().erase(id_);
++}
++
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,112 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_snapshot_stream.h b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_stream.h
+new file mode 100644
+index 0000000000000..e526f06103983
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_stream.h
+@@ -0,0 +1,106 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SNAPSHOT_STREAM_H_
++#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SNAPSHOT_STREAM_H_
++
++#include <optional>
++#include <vector>
++
++#include "base/functional/callback.h"
++#include "base/memory/raw_ptr.h"
++#include "base/memory/ref_counted.h"
++#include "base/time/time.h"
++#include "base/timer/timer.h"
++#include "chrome/common/extensions/api/browser_os.h"
++#include "extensions/common/extension_id.h"
++
++namespace content {
++class BrowserContext;
++}  // namespace content
++
++namespace extensions {
++namespace api {
++
++// Buffer between the snapshot processor and getInteractiveSnapshotChunk.
++//
++// The processor appends elements as contiguous batches finish; a reader
++// takes everything buffered so far, or waits for the next append. Streams
++// live in a global registry keyed by id, readable only by the extension and
++// browser context that started them, until their last chunk is read or
++// they sit unread for kIdleTimeout. UI thread only.
++class SnapshotStream : public base::RefCounted<SnapshotStream> {
++ public:
++  using ChunkCallback = base::OnceCallback<void(browser_os::SnapshotChunk)>;
++
++  // Streams without a pending read are dropped after this long
++  static constexpr base::TimeDelta kIdleTimeout = base::Seconds(60);
++
++  // Creates a stream for |extension_id| in |browser_context| and registers
++  // it under a fresh id.
++  static scoped_refptr<SnapshotStream> Create(
++      content::BrowserContext* browser_context,
++      const ExtensionId& extension_id);
++
++  // Returns the registered stream with |stream_id| if |extension_id| in
++  // |browser_context| created it, or null.
++  static scoped_refptr<SnapshotStream> Find(
++      int stream_id,
++      content::BrowserContext* browser_context,
++      const ExtensionId& extension_id);
++
++  SnapshotStream(const SnapshotStream&) = delete;
++  SnapshotStream& operator=(const SnapshotStream&) = delete;
++
++  int id() const { return id_; }
++
++  // Appends elements that directly follow the previously added ones.
++  void AddElements(std::vector<browser_os::InteractiveNode> elements);
++
++  // Marks the stream complete. |summary| carries metadata and timing; its
++  // elements are ignored since they were already streamed.
++  void Finish(browser_os::InteractiveSnapshot summary);
++
++  // Runs |callback| with the next chunk, synchronously if data is buffered.
++  // Returns false if another read is already pending.
++  bool ReadNextChunk(ChunkCallback callback);
++
++  // Time from creation to the first appended element, if any arrived.
++  std::optional<base::TimeDelta> time_to_first_element() const {
++    return time_to_first_element_;
++  }
++
++ private:
++  friend class base::RefCounted<SnapshotStream>;
++
++  SnapshotStream(int id,
++                 content::BrowserContext* browser_context,
++                 const ExtensionId& extension_id);
++  ~SnapshotStream();
++
++  // Hands buffered data to the pending reader, if there is one.
++  void MaybeDeliver();
++
++  // Removes the stream from the registry.
++  void Unregister();
++
++  const int id_;
++  // Caller that created the stream; only compared, never dereferenced
++  const raw_ptr<content::BrowserContext> browser_context_;
++  const ExtensionId extension_id_;
++  const base::TimeTicks created_;
++  std::optional<base::TimeDelta> time_to_first_element_;
++  int next_sequence_ = 0;
++  int total_elements_ = 0;
++  std::vector<browser_os::InteractiveNode> buffered_;
++  std::optional<browser_os::InteractiveSnapshot> summary_;
++  ChunkCallback pending_read_;
++  // Retains its task so reads can Stop() and deliveries Reset() it
++  base::RetainingOneShotTimer idle_timer_;
++};
++
++}  // namespace api
++}  // namespace extensions
++
++#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_BROWSER_OS_SNAPSHOT_STREAM_H_
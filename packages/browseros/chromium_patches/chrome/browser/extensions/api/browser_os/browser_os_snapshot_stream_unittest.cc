@@ -0,0 +1,148 @@
+diff --git a/chrome/browser/extensions/api/browser_os/browser_os_snapshot_stream_unittest.cc b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_stream_unittest.cc
+new file mode 100644
+index 0000000000000..14a371aa2456f
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/browser_os_snapshot_stream_unittest.cc
+@@ -0,0 +1,142 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/browser_os_snapshot_stream.h"
++
++#include <optional>
++#include <utility>
++#include <vector>
++
++#include "base/functional/bind.h"
++#include "base/functional/callback_helpers.h"
++#include "content/public/test/browser_task_environment.h"
++#include "content/public/test/test_browser_context.h"
++#include "testing/gtest/include/gtest/gtest.h"
++
++namespace extensions {
++namespace api {
++namespace {
++
++constexpr char kExtensionId[] = "abcdefghijklmnopabcdefghijklmnop";
++
++std::vector<browser_os::InteractiveNode> MakeElements(int first, int count) {
++  std::vector<browser_os::InteractiveNode> elements(count);
++  for (int i = 0; i < count; ++i) {
++    elements[i].node_id = first + i;
++  }
++  return elements;
++}
++
++class SnapshotStreamTest : public testing::Test {
++ protected:
++  scoped_refptr<SnapshotStream> Create() {
++    return SnapshotStream::Create(&browser_context_, kExtensionId);
++  }
++
++  scoped_refptr<SnapshotStream> Find(int id) {
++    return SnapshotStream::Find(id, &browser_context_, kExtensionId);
++  }
++
++  SnapshotStream::ChunkCallback Capture() {
++    return base::BindOnce(
++        [](std::optional<browser_os::SnapshotChunk>* out,
++           browser_os::SnapshotChunk chunk) { *out = std::move(chunk); },
++        &chunk_);
++  }
++
++  content::BrowserTaskEnvironment task_environment_{
++      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
++  content::TestBrowserContext browser_context_;
++  std::optional<browser_os::SnapshotChunk> chunk_;
++};
++
++// =============================================================================
++// Delivery Tests
++// =============================================================================
++
++TEST_F(SnapshotStreamTest, ReadReturnsBufferedElements) {
++  scoped_refptr<SnapshotStream> stream = Create();
++  stream->AddElements(MakeElements(1, 3));
++
++  ASSERT_TRUE(stream->ReadNextChunk(Capture()));
++  ASSERT_TRUE(chunk_);
++  EXPECT_EQ(0, chunk_->sequence);
++  EXPECT_EQ(3u, chunk_->elements.size());
++  EXPECT_FALSE(chunk_->done);
++}
++
++TEST_F(SnapshotStreamTest, PendingReadWaitsForElements) {
++  scoped_refptr<SnapshotStream> stream = Create();
++  ASSERT_TRUE(stream->ReadNextChunk(Capture()));
++  EXPECT_FALSE(chunk_);
++  EXPECT_FALSE(stream->ReadNextChunk(base::DoNothing()));
++
++  stream->AddElements(MakeElements(1, 2));
++  ASSERT_TRUE(chunk_);
++  EXPECT_EQ(2u, chunk_->elements.size());
++}
++
++TEST_F(SnapshotStreamTest, LastChunkUnregistersStream) {
++  scoped_refptr<SnapshotStream> stream = Create();
++  const int id = stream->id();
++  stream->AddElements(MakeElements(1, 2));
++  stream->Finish(browser_os::InteractiveSnapshot());
++
++  ASSERT_TRUE(stream->ReadNextChunk(Capture()));
++  ASSERT_TRUE(chunk_);
++  EXPECT_TRUE(chunk_->done);
++  EXPECT_EQ(2, chunk_->total_elements.value_or(0));
++  EXPECT_FALSE(Find(id));
++}
++
++TEST_F(SnapshotStreamTest, OnlyCreatorCanFindStream) {
++  const int id = Create()->id();
++  content::TestBrowserContext other_context;
++
++  EXPECT_TRUE(Find(id));
++  EXPECT_FALSE(SnapshotStream::Find(id, &browser_context_,
++                                    "ponmlkjihgfedcbaponmlkjihgfedcba"));
++  EXPECT_FALSE(SnapshotStream::Find(id, &other_context, kExtensionId));
++}
++
++// =============================================================================
++// Idle Timeout Tests
++// =============================================================================
++
++TEST_F(SnapshotStreamTest, UnreadStreamIsDroppedWhenIdle) {
++  const int id = Create()->id();
++  EXPECT_TRUE(Find(id));
++
++  task_environment_.FastForwardBy(SnapshotStream::kIdleTimeout);
++  EXPECT_FALSE(Find(id));
++}
++
++TEST_F(SnapshotStreamTest, StreamIsDroppedWhenIdleAfterARead) {
++  const int id = Create()->id();
++  Find(id)->AddElements(MakeElements(1, 2));
++  ASSERT_TRUE(Find(id)->ReadNextChunk(Capture()));
++  ASSERT_TRUE(chunk_);
++
++  task_environment_.FastForwardBy(SnapshotStream::kIdleTimeout / 2);
++  EXPECT_TRUE(Find(id));
++  task_environment_.FastForwardBy(SnapshotStream::kIdleTimeout / 2);
++  EXPECT_FALSE(Find(id));
++}
++
++TEST_F(SnapshotStreamTest, PendingReadKeepsStreamAlive) {
++  const int id = Create()->id();
++  ASSERT_TRUE(Find(id)->ReadNextChunk(Capture()));
++
++  task_environment_.FastForwardBy(SnapshotStream::kIdleTimeout * 2);
++  ASSERT_TRUE(Find(id));
++
++  Find(id)->Finish(browser_os::InteractiveSnapshot());
++  ASSERT_TRUE(chunk_);
++  EXPECT_TRUE(chunk_->done);
++  EXPECT_FALSE(Find(id));
++}
++
++}  // namespace
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,236 @@
+diff --git a/chrome/browser/extensions/api/browser_os/test/ax_tree_fixture.cc b/chrome/browser/extensions/api/browser_os/test/ax_tree_fixture.cc
+new file mode 100644
+index 0000000000000..ee3aa30641aa9
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/test/ax_tree_fixture.cc
+@@ -0,0 +1,230 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/test/ax_tree_fixture.h"
++
++#include <set>
++#include <string>
++#include <utility>
++#include <vector>
++
++#include "base/base_paths.h"
++#include "base/files/file_path.h"
++#include "base/files/file_util.h"
++#include "base/json/json_reader.h"
++#include "base/logging.h"
++#include "base/path_service.h"
++#include "base/strings/string_number_conversions.h"
++#include "base/threading/thread_restrictions.h"
++#include "ui/accessibility/ax_enum_util.h"
++#include "ui/accessibility/ax_enums.mojom.h"
++#include "ui/accessibility/ax_node_data.h"
++#include "ui/accessibility/ax_tree_id.h"
++
++namespace extensions {
++namespace api {
++namespace test {
++
++namespace {
++
++// Calls |add| for every entry of |dict|[|key|] whose name parses as |Enum|.
++template <typename Enum, typename AddFn>
++void ForEachAttribute(const base::Value::Dict& dict,
++                      std::string_view key,
++                      AddFn add) {
++  const base::Value::Dict* attributes = dict.FindDict(key);
++  if (!attributes) {
++    return;
++  }
++  for (const auto [name, value] : *attributes) {
++    Enum attribute = ui::ParseAXEnum<Enum>(name.c_str());
++    if (attribute != Enum::kNone) {
++      add(attribute, value);
++    }
++  }
++}
++
++std::optional<ui::AXNodeData> ParseNode(const base::Value::Dict& dict) {
++  std::optional<int> id = dict.FindInt("id");
++  const std::string* role = dict.FindString("role");
++  if (!id || !role) {
++    return std::nullopt;
++  }
++
++  ui::AXNodeData node;
++  node.id = *id;
++  node.role = ui::ParseAXEnum<ax::mojom::Role>(role->c_str());
++
++  if (const base::Value::Dict* bounds = dict.FindDict("relativeBounds")) {
++    node.relative_bounds.bounds = gfx::RectF(
++        bounds->FindDouble("x").value_or(0), bounds->FindDouble("y").value_or(0),
++        bounds->FindDouble("width").value_or(0),
++        bounds->FindDouble("height").value_or(0));
++    node.relative_bounds.offset_container_id =
++        bounds->FindInt("offsetContainerId").value_or(-1);
++  }
++
++  if (const base::Value::List* children = dict.FindList("childIds")) {
++    for (const base::Value& child : *children) {
++      if (child.is_int()) {
++        node.child_ids.push_back(child.GetInt());
++      }
++    }
++  }
++
++  if (const base::Value::List* states = dict.FindList("states")) {
++    for (const base::Value& state : *states) {
++      if (state.is_string()) {
++        node.AddState(
++            ui::ParseAXEnum<ax::mojom::State>(state.GetString().c_str()));
++      }
++    }
++  }
++  if (const base::Value::List* actions = dict.FindList("actions")) {
++    for (const base::Value& action : *actions) {
++      if (action.is_string()) {
++        node.AddAction(
++            ui::ParseAXEnum<ax::mojom::Action>(action.GetString().c_str()));
++      }
++    }
++  }
++
++  ForEachAttribute<ax::mojom::StringAttribute>(
++      dict, "stringAttributes", [&node](auto attribute, const auto& value) {
++        if (value.is_string()) {
++          node.AddStringAttribute(attribute, value.GetString());
++        }
++      });
++  ForEachAttribute<ax::mojom::IntAttribute>(
++      dict, "intAttributes", [&node](auto attribute, const auto& value) {
++        if (value.is_int()) {
++          node.AddIntAttribute(attribute, value.GetInt());
++        }
++      });
++  ForEachAttribute<ax::mojom::FloatAttribute>(
++      dict, "floatAttributes", [&node](auto attribute, const auto& value) {
++        if (value.is_double() || value.is_int()) {
++          node.AddFloatAttribute(attribute, value.GetDouble());
++        }
++      });
++  ForEachAttribute<ax::mojom::BoolAttribute>(
++      dict, "boolAttributes", [&node](auto attribute, const auto& value) {
++        if (value.is_bool()) {
++          node.AddBoolAttribute(attribute, value.GetBool());
++        }
++      });
++  ForEachAttribute<ax::mojom::IntListAttribute>(
++      dict, "intListAttributes", [&node](auto attribute, const auto& value) {
++        if (!value.is_list()) {
++          return;
++        }
++        std::vector<int32_t> ints;
++        for (const base::Value& item : value.GetList()) {
++          if (item.is_int()) {
++            ints.push_back(item.GetInt());
++          }
++        }
++        node.AddIntListAttribute(attribute, ints);
++      });
++  ForEachAttribute<ax::mojom::StringListAttribute>(
++      dict, "stringListAttributes", [&node](auto attribute, const auto& value) {
++        if (!value.is_list()) {
++          return;
++        }
++        std::vector<std::string> strings;
++        for (const base::Value& item : value.GetList()) {
++          if (item.is_string()) {
++            strings.push_back(item.GetString());
++          }
++        }
++        node.AddStringListAttribute(attribute, strings);
++      });
++
++  if (const base::Value::Dict* html = dict.FindDict("htmlAttributes")) {
++    for (const auto [name, value] : *html) {
++      if (value.is_string()) {
++        node.html_attributes.emplace_back(name, value.GetString());
++      }
++    }
++  }
++  return node;
++}
++
++}  // namespace
++
++std::optional<ui::AXTreeUpdate> ParseAXTreeFixture(
++    const base::Value::Dict& tree) {
++  std::optional<int> root_id = tree.FindInt("rootId");
++  const base::Value::Dict* nodes = tree.FindDict("nodes");
++  if (!root_id || !nodes) {
++    return std::nullopt;
++  }
++
++  ui::AXTreeUpdate update;
++  update.root_id = *root_id;
++  update.has_tree_data = true;
++  update.tree_data.tree_id = ui::AXTreeID::CreateNewAXTreeID();
++  if (const base::Value::Dict* tree_data = tree.FindDict("treeData")) {
++    if (const std::string* title = tree_data->FindString("title")) {
++      update.tree_data.title = *title;
++    }
++    if (const std::string* url = tree_data->FindString("url")) {
++      update.tree_data.url = *url;
++    }
++    update.tree_data.loaded = tree_data->FindBool("loaded").value_or(true);
++  }
++
++  // The nodes dictionary is keyed by id, but AXTree needs every parent
++  // before its children, so emit them in pre-order from the root
++  std::vector<int32_t> stack = {*root_id};
++  std::set<int32_t> visited;
++  while (!stack.empty()) {
++    int32_t id = stack.back();
++    stack.pop_back();
++    if (!visited.insert(id).second) {
++      return std::nullopt;
++    }
++    const base::Value::Dict* dict = nodes->FindDict(base::NumberToString(id));
++    if (!dict) {
++      return std::nullopt;
++    }
++    std::optional<ui::AXNodeData> node = ParseNode(*dict);
++    if (!node) {
++      return std::nullopt;
++    }
++    for (auto it = node->child_ids.rbegin(); it != node->child_ids.rend();
++         ++it) {
++      stack.push_back(*it);
++    }
++    update.nodes.push_back(std::move(*node));
++  }
++  return update;
++}
++
++std::optional<ui::AXTreeUpdate> LoadAXTreeFixture(std::string_view name) {
++  base::ScopedAllowBlockingForTesting allow_blocking;
++  base::FilePath path;
++  if (!base::PathService::Get(base::DIR_SRC_TEST_DATA_ROOT, &path)) {
++    return std::nullopt;
++  }
++  path = path.AppendASCII("chrome/test/data/browseros/ax_trees")
++             .AppendASCII(std::string(name) + ".json");
++
++  std::string contents;
++  if (!base::ReadFileToString(path, &contents)) {
++    LOG(ERROR) << "Cannot read AX tree fixture " << path;
++    return std::nullopt;
++  }
++  std::optional<base::Value::Dict> tree =
++      base::JSONReader::ReadDict(contents);
++  if (!tree) {
++    LOG(ERROR) << "AX tree fixture is not a JSON object: " << path;
++    return std::nullopt;
++  }
++  return ParseAXTreeFixture(*tree);
++}
++
++}  // namespace test
++}  // namespace api
++}  // namespace extensions
@@ -0,0 +1,46 @@
+diff --git a/chrome/browser/extensions/api/browser_os/test/ax_tree_fixture.h b/chrome/browser/extensions/api/browser_os/test/ax_tree_fixture.h
+new file mode 100644
+index 0000000000000..9e7f8aea264c5
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/test/ax_tree_fixture.h
+@@ -0,0 +1,40 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_TEST_AX_TREE_FIXTURE_H_
++#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_TEST_AX_TREE_FIXTURE_H_
++
++#include <optional>
++#include <string_view>
++
++#include "base/values.h"
++#include "ui/accessibility/ax_tree_update.h"
++
++namespace extensions {
++namespace api {
++namespace test {
++
++// Fixtures checked in under chrome/test/data/browseros/ax_trees/. Each one
++// is a page class the agents spend most of their time on.
++inline constexpr std::string_view kAXTreeFixtures[] = {
++    "news",       // Long article feed with sidebar and footer
++    "webmail",    // Folder tree and a 50-row message grid
++    "table",      // Admin table with 100 rows of cells and row actions
++    "dashboard",  // SPA with tabs, chart cards and form controls
++};
++
++// Parses a tree in the getAccessibilityTree result format ({rootId, nodes,
++// treeData}) back into an update. A page can be recorded as a fixture by
++// saving that result as JSON. Returns nullopt if the tree is malformed.
++std::optional<ui::AXTreeUpdate> ParseAXTreeFixture(
++    const base::Value::Dict& tree);
++
++// Loads chrome/test/data/browseros/ax_trees/<name>.json.
++std::optional<ui::AXTreeUpdate> LoadAXTreeFixture(std::string_view name);
++
++}  // namespace test
++}  // namespace api
++}  // namespace extensions
++
++#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_TEST_AX_TREE_FIXTURE_H_
@@ -0,0 +1,114 @@
+diff --git a/chrome/browser/extensions/api/browser_os/test/snapshot_test_util.cc b/chrome/browser/extensions/api/browser_os/test/snapshot_test_util.cc
+new file mode 100644
+index 0000000000000..4740648c0a780
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/test/snapshot_test_util.cc
+@@ -0,0 +1,108 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#include "chrome/browser/extensions/api/browser_os/test/snapshot_test_util.h"
++
++#include <string>
++
++#include "base/strings/string_number_conversions.h"
++#include "ui/accessibility/ax_enums.mojom.h"
++#include "ui/accessibility/ax_node_data.h"
++#include "ui/accessibility/ax_tree_id.h"
++#include "ui/gfx/geometry/rect_f.h"
++
++namespace extensions {
++namespace api {
++namespace test {
++
++namespace {
++
++constexpr float kRowHeight = 40.0f;
++constexpr float kPageWidth = 1024.0f;
++
++ui::AXNodeData MakeNode(int32_t id,
++                        ax::mojom::Role role,
++                        int32_t offset_container_id,
++                        const gfx::RectF& bounds) {
++  ui::AXNodeData node;
++  node.id = id;
++  node.role = role;
++  node.relative_bounds.offset_container_id = offset_container_id;
++  node.relative_bounds.bounds = bounds;
++  return node;
++}
++
++}  // namespace
++
++ui::AXTreeUpdate BuildTableTreeUpdate(int rows) {
++  const int32_t kRootId = 1;
++  const int32_t kTableId = 2;
++
++  ui::AXTreeUpdate update;
++  update.root_id = kRootId;
++  update.has_tree_data = true;
++  update.tree_data.tree_id = ui::AXTreeID::CreateNewAXTreeID();
++  update.nodes.reserve(2 + rows * 4);
++
++  ui::AXNodeData root =
++      MakeNode(kRootId, ax::mojom::Role::kRootWebArea, -1,
++               gfx::RectF(0, 0, kPageWidth, kRowHeight * (rows + 1)));
++  root.child_ids.push_back(kTableId);
++  update.nodes.push_back(root);
++
++  ui::AXNodeData table =
++      MakeNode(kTableId, ax::mojom::Role::kTable, kRootId,
++               gfx::RectF(0, kRowHeight, kPageWidth, kRowHeight * rows));
++  table.SetName("Orders");
++  update.nodes.push_back(table);
++
++  int32_t next_id = kTableId + 1;
++  for (int i = 0; i < rows; ++i) {
++    const float y = kRowHeight * i;
++    const int32_t row_id = next_id++;
++    const int32_t cell_id = next_id++;
++    const int32_t text_id = next_id++;
++    const int32_t button_id = next_id++;
++    update.nodes[1].child_ids.push_back(row_id);
++
++    ui::AXNodeData row = MakeNode(row_id, ax::mojom::Role::kRow, kTableId,
++                                  gfx::RectF(0, y, kPageWidth, kRowHeight));
++    row.child_ids = {cell_id, button_id};
++    update.nodes.push_back(row);
++
++    ui::AXNodeData cell = MakeNode(cell_id, ax::mojom::Role::kCell, kTableId,
++                                   gfx::RectF(0, y, 800, kRowHeight));
++    cell.child_ids = {text_id};
++    update.nodes.push_back(cell);
++
++    ui::AXNodeData text =
++        MakeNode(text_id, ax::mojom::Role::kStaticText, kTableId,
++                 gfx::RectF(8, y + 8, 300, 24));
++    text.SetName("Order #" + base::NumberToString(i));
++    update.nodes.push_back(text);
++
++    ui::AXNodeData button =
++        MakeNode(button_id, ax::mojom::Role::kButton, kTableId,
++                 gfx::RectF(900, y + 4, 100, 32));
++    button.SetName("Edit");
++    button.AddStringAttribute(ax::mojom::StringAttribute::kHtmlTag, "button");
++    button.SetDefaultActionVerb(ax::mojom::DefaultActionVerb::kPress);
++    update.nodes.push_back(button);
++  }
++  return update;
++}
++
++std::vector<uint32_t> GetButtonOffsets(const ui::AXTreeUpdate& update) {
++  std::vector<uint32_t> offsets;
++  for (size_t i = 0; i < update.nodes.size(); ++i) {
++    if (update.nodes[i].role == ax::mojom::Role::kButton) {
++      offsets.push_back(static_cast<uint32_t>(i));
++    }
++  }
++  return offsets;
++}
++
++}  // namespace test
++}  // namespace api
++}  // namespace extensions
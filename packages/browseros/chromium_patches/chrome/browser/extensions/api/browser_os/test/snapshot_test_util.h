@@ -0,0 +1,35 @@
+diff --git a/chrome/browser/extensions/api/browser_os/test/snapshot_test_util.h b/chrome/browser/extensions/api/browser_os/test/snapshot_test_util.h
+new file mode 100644
+index 0000000000000..f84a8e52fe103
+--- /dev/null
++++ b/chrome/browser/extensions/api/browser_os/test/snapshot_test_util.h
+@@ -0,0 +1,29 @@
++// Copyright 2025 The Chromium Authors
++// Use of this source code is governed by a BSD-style license that can be
++// found in the LICENSE file.
++
++#ifndef CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_TEST_SNAPSHOT_TEST_UTIL_H_
++#define CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_TEST_SNAPSHOT_TEST_UTIL_H_
++
++#include <cstdint>
++#include <vector>
++
++#include "ui/accessibility/ax_tree_update.h"
++
++namespace extensions {
++namespace api {
++namespace test {
++
++// Builds a web page with a single table of |rows| rows. Every row has a text
++// cell and an "Edit" button whose offset container is the table, which is
++// the layout that makes sibling nodes share context text and paths.
++ui::AXTreeUpdate BuildTableTreeUpdate(int rows);
++
++// Offsets (into the update's node vector) of every button in |update|.
++std::vector<uint32_t> GetButtonOffsets(const ui::AXTreeUpdate& update);
++
++}  // namespace test
++}  // namespace api
++}  // namespace extensions
++
++#endif  // CHROME_BROWSER_EXTENSIONS_API_BROWSER_OS_TEST_SNAPSHOT_TEST_UTIL_H_
@@ -1,9 +1,9 @@
 diff --git a/chrome/browser/ui/views/side_panel/browseros_simple_page_extractor.cc b/chrome/browser/ui/views/side_panel/browseros_simple_page_extractor.cc
 new file mode 100644
-index 0000000000000..4a801a5d847ea
+index 0000000000000..a1e6eeca18054
 --- /dev/null
 +++ b/chrome/browser/ui/views/side_panel/browseros_simple_page_extractor.cc
-@@ -0,0 +1,231 @@
+@@ -0,0 +1,211 @@
 +// Copyright 2025 The Chromium Authors
 +// Use of this source code is governed by a BSD-style license that can be
 +// found in the LICENSE file.
@@ -16,6 +16,7 @@ index 0000000000000..4a801a5d847ea
 +
 +#include "base/strings/string_util.h"
 +#include "base/strings/utf_string_conversions.h"
++#include "chrome/browser/browseros/core/browseros_text_util.h"
 +#include "ui/accessibility/ax_enums.mojom.h"
 +#include "ui/accessibility/ax_node_data.h"
 +#include "ui/accessibility/ax_role_properties.h"
@@ -25,7 +26,6 @@ index 0000000000000..4a801a5d847ea
 +
 +// Forward declarations
 +std::u16string GetNodeText(const ui::AXNodeData* node);
-+void CleanupWhitespace(std::u16string& text);
 +
 +// Recursively extracts text from a node using DFS with semantic boundaries.
 +// Stops recursion at headings, links, and images to prevent duplication.
@@ -189,26 +189,6 @@ index 0000000000000..4a801a5d847ea
 +  return base::UTF8ToUTF16(text);
 +}
 +
-+// Clean up excessive whitespace in the final output
-+void CleanupWhitespace(std::u16string& text) {
-+  // Replace multiple spaces with single space
-+  size_t pos = 0;
-+  while ((pos = text.find(u"  ", pos)) != std::u16string::npos) {
-+    text.replace(pos, 2, u" ");
-+  }
-+
-+  // Replace multiple newlines (more than 2) with double newline
-+  pos = 0;
-+  while ((pos = text.find(u"\n\n\n", pos)) != std::u16string::npos) {
-+    text.replace(pos, 3, u"\n\n");
-+  }
-+
-+  // Trim trailing whitespace
-+  while (!text.empty() && (text.back() == u' ' || text.back() == u'\n')) {
-+    text.pop_back();
-+  }
-+}
-+
 +}  // namespace
 +
 +namespace side_panel {
@@ -229,7 +209,7 @@ index 0000000000000..4a801a5d847ea
 +  ExtractNode(update.root_id, node_map, output, -1);  // Start at depth -1
 +
 +  // Clean up extra whitespace
-+  CleanupWhitespace(output);
++  browseros::NormalizePageText(output);
 +
 +  return output;
 +}
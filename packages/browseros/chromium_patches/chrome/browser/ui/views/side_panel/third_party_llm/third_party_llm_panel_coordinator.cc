@@ -1,9 +1,9 @@
 diff --git a/chrome/browser/ui/views/side_panel/third_party_llm/third_party_llm_panel_coordinator.cc b/chrome/browser/ui/views/side_panel/third_party_llm/third_party_llm_panel_coordinator.cc
 new file mode 100644
-index 0000000000000..ea3e4207ee029
+index 0000000000000..9ef87c37e2f44
 --- /dev/null
 +++ b/chrome/browser/ui/views/side_panel/third_party_llm/third_party_llm_panel_coordinator.cc
-@@ -0,0 +1,1187 @@
+@@ -0,0 +1,1184 @@
 +// Copyright 2024 The Chromium Authors
 +// Use of this source code is governed by a BSD-style license that can be
 +// found in the LICENSE file.
@@ -76,6 +76,7 @@ index 0000000000000..ea3e4207ee029
 +#include "third_party/blink/public/common/mediastream/media_stream_request.h"
 +#include "content/public/browser/render_frame_host.h"
 +#include "chrome/browser/browseros/metrics/browseros_metrics.h"
++#include "chrome/browser/browseros/core/browseros_text_util.h"
 +#include "chrome/browser/ui/views/side_panel/clash_of_gpts/clash_of_gpts_coordinator.h"
 +
 +namespace {
@@ -713,13 +714,9 @@ index 0000000000000..ea3e4207ee029
 +  ExtractTextFromNodeData(node_map[root_id], node_map, &extracted_text);
 +  
 +  // Clean up text - remove excessive whitespace
++  browseros::NormalizePageText(extracted_text);
 +  if (!extracted_text.empty()) {
-+    // Simple cleanup of multiple spaces
-+    size_t pos = 0;
-+    while ((pos = extracted_text.find(u"  ", pos)) != std::u16string::npos) {
-+      extracted_text.replace(pos, 2, u" ");
-+    }
-+    
++
 +    // Format the final output
 +    std::u16string formatted_output = u"----------- WEB PAGE -----------\n\n";
 +    formatted_output += u"TITLE: " + page_title_ + u"\n\n";
@@ -2,7 +2,7 @@ diff --git a/extensions/browser/extension_function_histogram_value.h b/extension
 index 6d9bd29ae220f..f84c951ebeacb 100644
 --- a/extensions/browser/extension_function_histogram_value.h
 +++ b/extensions/browser/extension_function_histogram_value.h
-@@ -2011,6 +2011,31 @@ enum HistogramValue {
+@@ -2011,6 +2011,38 @@ enum HistogramValue {
    DEVELOPERPRIVATE_SHOWSITESETTINGS = 1948,
    ACCESSIBILITY_PRIVATE_PROCESSPENDINGSPOKENFEEDBACKEVENT = 1949,
    ACCESSIBILITY_PRIVATE_ENABLESPOKENFEEDBACKMV3KEYHANDLING = 1950,
@@ -31,6 +31,13 @@ index 6d9bd29ae220f..f84c951ebeacb 100644
 +  SIDEPANEL_BROWSEROSISOPEN = 1973,
 +  BROWSER_OS_GETBROWSEROSVERSIONNUMBER = 1974,
 +  BROWSER_OS_CHOOSEPATH = 1975,
++  BROWSER_OS_GETINTERACTIVESNAPSHOTCHUNK = 1976,
++  BROWSER_OS_WAITFORSETTLE = 1977,
++  BROWSER_OS_EXECUTEACTIONS = 1978,
++  BROWSER_OS_GETNODEMAPPINGSTATS = 1979,
++  BROWSER_OS_STARTSCREENCAST = 1980,
++  BROWSER_OS_READSCREENCASTFRAME = 1981,
++  BROWSER_OS_STOPSCREENCAST = 1982,
    // Last entry: Add new entries above, then run:
    // tools/metrics/histograms/update_extension_histograms.py
    ENUM_BOUNDARY